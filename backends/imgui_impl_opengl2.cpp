@@ -3,6 +3,7 @@
 
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Incremental font atlas texture updates (ImGuiBackendFlags_RendererHasTexUpdates).
 
 // You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
@@ -18,6 +19,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2020-11-02: OpenGL: Upload modified regions of the font atlas texture with glTexSubImage2D(), enable ImGuiBackendFlags_RendererHasTexUpdates flag.
 //  2020-01-23: OpenGL: Explicitly backup, setup and restore GL_TEXTURE_ENV to increase compatibility with legacy OpenGL applications.
 //  2019-04-30: OpenGL: Added support for special ImDrawCallback_ResetRenderState callback to reset render state.
 //  2019-02-11: OpenGL: Projecting clipping rectangles correctly using draw_data->FramebufferScale to allow multi-viewports for retina display.
@@ -61,6 +63,7 @@ bool    ImGui_ImplOpenGL2_Init()
     // Setup backend capabilities flags
     ImGuiIO& io = ImGui::GetIO();
     io.BackendRendererName = "imgui_impl_opengl2";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates;     // We can upload io.Fonts->TexDirtyRects[], allowing for ImFontAtlasFlags_DynamicGlyphs.
     return true;
 }
 
@@ -123,6 +126,9 @@ void ImGui_ImplOpenGL2_RenderDrawData(ImDrawData* draw_data)
     if (fb_width == 0 || fb_height == 0)
         return;
 
+    // Upload modified regions of the font atlas
+    ImGui_ImplOpenGL2_UpdateFontsTexture();
+
     // Backup GL state
     GLint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
     GLint last_polygon_mode[2]; glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode);
@@ -219,6 +225,7 @@ bool ImGui_ImplOpenGL2_CreateFontsTexture()
 
     // Store our identifier
     io.Fonts->TexID = (ImTextureID)(intptr_t)g_FontTexture;
+    io.Fonts->ClearTexDirtyRects();
 
     // Restore state
     glBindTexture(GL_TEXTURE_2D, last_texture);
@@ -226,6 +233,38 @@ bool ImGui_ImplOpenGL2_CreateFontsTexture()
     return true;
 }
 
+void ImGui_ImplOpenGL2_UpdateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImFontAtlas* atlas = io.Fonts;
+    if (g_FontTexture == 0 || atlas->TexDirtyRects.Size == 0)
+        return;
+    if (!atlas->IsBuilt()) // CPU pixel data was cleared: nothing to upload from
+    {
+        atlas->ClearTexDirtyRects();
+        return;
+    }
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // Upload each modified region
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+    for (int n = 0; n < atlas->TexDirtyRects.Size; n++)
+    {
+        const ImFontAtlasRect& r = atlas->TexDirtyRects[n];
+        glTexSubImage2D(GL_TEXTURE_2D, 0, r.X, r.Y, r.Width, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels + ((size_t)r.Y * width + r.X) * 4);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    atlas->ClearTexDirtyRects();
+
+    // Restore state
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+
 void ImGui_ImplOpenGL2_DestroyFontsTexture()
 {
     if (g_FontTexture)
@@ -6,6 +6,7 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [x] Renderer: Desktop GL only: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Incremental font atlas texture updates (ImGuiBackendFlags_RendererHasTexUpdates).
 
 // You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
@@ -13,6 +14,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2020-11-13: OpenGL: Added optional IMGUI_IMPL_OPENGL_USE_STREAM_BUFFERS to upload all draw lists into a single vertex/index buffer (persistently mapped ring buffer on GL 4.4+, glBufferSubData() on GL 3.2+).
+//  2020-11-02: OpenGL: Upload modified regions of the font atlas texture with glTexSubImage2D(), enable ImGuiBackendFlags_RendererHasTexUpdates flag.
 //  2020-10-23: OpenGL: Save and restore current GL_PRIMITIVE_RESTART state.
 //  2020-10-15: OpenGL: Use glGetString(GL_VERSION) instead of glGetIntegerv(GL_MAJOR_VERSION, ...) when the later returns zero (e.g. Desktop GL 2.x)
 //  2020-09-17: OpenGL: Fix to avoid compiling/calling glBindSampler() on ES or pre 3.3 context which have the defines set by a loader.
@@ -140,6 +143,17 @@ using namespace gl;
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// Desktop GL 4.4+ has glBufferStorage() and persistently mapped buffers
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_4_4)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+
+// Stream buffers rely on glDrawElementsBaseVertex() to draw each ImDrawList from its offset in the shared vertex buffer
+#if defined(IMGUI_IMPL_OPENGL_USE_STREAM_BUFFERS) && defined(IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET)
+#define IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+#define IMGUI_IMPL_OPENGL_STREAM_FRAMES 3           // Number of regions in the persistently mapped ring buffer (= frames in flight)
+#endif
+
 // OpenGL Data
 static GLuint       g_GlVersion = 0;                // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
 static char         g_GlslVersionString[32] = "";   // Specified by user or detected based on compile time GL settings.
@@ -148,6 +162,17 @@ static GLuint       g_ShaderHandle = 0, g_VertHandle = 0, g_FragHandle = 0;
 static GLint        g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;                                // Uniforms location
 static GLuint       g_AttribLocationVtxPos = 0, g_AttribLocationVtxUV = 0, g_AttribLocationVtxColor = 0; // Vertex attributes location
 static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
+#ifdef IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+static bool         g_StreamEnabled = false;                                // GL 3.2+: upload all draw lists into a single vertex/index buffer
+static int          g_StreamVtxCapacity = 0, g_StreamIdxCapacity = 0;       // Capacity of one frame (in vertices/indices)
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static bool         g_StreamPersistent = false;                             // GL 4.4+: buffers are persistently mapped ring buffers, otherwise updated with glBufferSubData()
+static ImDrawVert*  g_StreamVtxMapped = NULL;
+static ImDrawIdx*   g_StreamIdxMapped = NULL;
+static GLsync       g_StreamFences[IMGUI_IMPL_OPENGL_STREAM_FRAMES] = {};
+static int          g_StreamFrame = 0;                                      // Ring buffer region used by current frame
+#endif
+#endif
 
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
@@ -175,6 +200,13 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
     if (g_GlVersion >= 320)
         io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+#endif
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates;     // We can upload io.Fonts->TexDirtyRects[], allowing for ImFontAtlasFlags_DynamicGlyphs.
+#ifdef IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+    g_StreamEnabled = (g_GlVersion >= 320);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    g_StreamPersistent = (g_GlVersion >= 440);
+#endif
 #endif
 
     // Store GLSL version string so we can refer to it later in case we recreate shaders.
@@ -306,6 +338,123 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
 }
 
+#ifdef IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+static void ImGui_ImplOpenGL3_DestroyStreamBuffers()
+{
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    for (int n = 0; n < IMGUI_IMPL_OPENGL_STREAM_FRAMES; n++)
+        if (g_StreamFences[n]) { glDeleteSync(g_StreamFences[n]); g_StreamFences[n] = 0; }
+    g_StreamVtxMapped = NULL; // Deleting the buffers unmaps them
+    g_StreamIdxMapped = NULL;
+    g_StreamFrame = 0;
+#endif
+    g_StreamVtxCapacity = g_StreamIdxCapacity = 0;
+}
+
+// Upload all draw lists into g_VboHandle/g_ElementsHandle, instead of reallocating both buffers for every ImDrawList.
+// Output the position (in vertices/indices) of this frame's data. The caller must have its own VAO bound.
+static void ImGui_ImplOpenGL3_UploadStreamBuffers(ImDrawData* draw_data, unsigned int* out_vtx_base, unsigned int* out_idx_base)
+{
+    const int vtx_count = draw_data->TotalVtxCount;
+    const int idx_count = draw_data->TotalIdxCount;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (g_StreamPersistent)
+    {
+        // Buffers are split in IMGUI_IMPL_OPENGL_STREAM_FRAMES regions used in turn, each guarded by a fence.
+        if (g_StreamVtxMapped == NULL || vtx_count > g_StreamVtxCapacity || idx_count > g_StreamIdxCapacity)
+        {
+            // Storage is immutable: grow by creating new buffers. It is fine to delete buffers the GPU may still be reading from.
+            int vtx_capacity = vtx_count + vtx_count / 2, idx_capacity = idx_count + idx_count / 2;
+            if (vtx_capacity < g_StreamVtxCapacity) vtx_capacity = g_StreamVtxCapacity;
+            if (idx_capacity < g_StreamIdxCapacity) idx_capacity = g_StreamIdxCapacity;
+            if (vtx_capacity < 8192) vtx_capacity = 8192;
+            if (idx_capacity < 16384) idx_capacity = 16384;
+            ImGui_ImplOpenGL3_DestroyStreamBuffers();
+            glDeleteBuffers(1, &g_VboHandle);
+            glDeleteBuffers(1, &g_ElementsHandle);
+            glGenBuffers(1, &g_VboHandle);
+            glGenBuffers(1, &g_ElementsHandle);
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            const GLsizeiptr vtx_size = (GLsizeiptr)vtx_capacity * IMGUI_IMPL_OPENGL_STREAM_FRAMES * (int)sizeof(ImDrawVert);
+            const GLsizeiptr idx_size = (GLsizeiptr)idx_capacity * IMGUI_IMPL_OPENGL_STREAM_FRAMES * (int)sizeof(ImDrawIdx);
+            glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+            glBufferStorage(GL_ARRAY_BUFFER, vtx_size, NULL, flags);
+            g_StreamVtxMapped = (ImDrawVert*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vtx_size, flags);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+            glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, idx_size, NULL, flags);
+            g_StreamIdxMapped = (ImDrawIdx*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, idx_size, flags);
+            g_StreamVtxCapacity = vtx_capacity;
+            g_StreamIdxCapacity = idx_capacity;
+            if (g_StreamVtxMapped == NULL || g_StreamIdxMapped == NULL)
+            {
+                // Mapping failed: stay on the glBufferSubData() path from now on.
+                ImGui_ImplOpenGL3_DestroyStreamBuffers();
+                glDeleteBuffers(1, &g_VboHandle);
+                glDeleteBuffers(1, &g_ElementsHandle);
+                glGenBuffers(1, &g_VboHandle);
+                glGenBuffers(1, &g_ElementsHandle);
+                g_StreamPersistent = false;
+                ImGui_ImplOpenGL3_UploadStreamBuffers(draw_data, out_vtx_base, out_idx_base);
+                return;
+            }
+        }
+
+        // Wait until the GPU is done reading the region we are about to overwrite (it normally was signaled long ago)
+        GLsync fence = g_StreamFences[g_StreamFrame];
+        if (fence)
+        {
+            GLenum wait_result;
+            do { wait_result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000); } while (wait_result == GL_TIMEOUT_EXPIRED);
+            glDeleteSync(fence);
+            g_StreamFences[g_StreamFrame] = 0;
+        }
+
+        // Buffers are mapped with GL_MAP_COHERENT_BIT: writes are visible to the draw calls issued after them, no flush required
+        *out_vtx_base = (unsigned int)(g_StreamFrame * g_StreamVtxCapacity);
+        *out_idx_base = (unsigned int)(g_StreamFrame * g_StreamIdxCapacity);
+        ImDrawVert* vtx_dst = g_StreamVtxMapped + *out_vtx_base;
+        ImDrawIdx* idx_dst = g_StreamIdxMapped + *out_idx_base;
+        for (int n = 0; n < draw_data->CmdListsCount; n++)
+        {
+            const ImDrawList* cmd_list = draw_data->CmdLists[n];
+            memcpy(vtx_dst, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
+            memcpy(idx_dst, cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
+            vtx_dst += cmd_list->VtxBuffer.Size;
+            idx_dst += cmd_list->IdxBuffer.Size;
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+        return;
+    }
+#endif
+
+    // Orphan each buffer once per frame, then upload every list in place with glBufferSubData()
+    if (vtx_count > g_StreamVtxCapacity)
+        g_StreamVtxCapacity = vtx_count + vtx_count / 2;
+    if (idx_count > g_StreamIdxCapacity)
+        g_StreamIdxCapacity = idx_count + idx_count / 2;
+    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)g_StreamVtxCapacity * (int)sizeof(ImDrawVert), NULL, GL_STREAM_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)g_StreamIdxCapacity * (int)sizeof(ImDrawIdx), NULL, GL_STREAM_DRAW);
+    GLintptr vtx_offset = 0, idx_offset = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        const GLsizeiptr vtx_size = (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
+        const GLsizeiptr idx_size = (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
+        if (vtx_size > 0)
+            glBufferSubData(GL_ARRAY_BUFFER, vtx_offset, vtx_size, (const GLvoid*)cmd_list->VtxBuffer.Data);
+        if (idx_size > 0)
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, idx_offset, idx_size, (const GLvoid*)cmd_list->IdxBuffer.Data);
+        vtx_offset += vtx_size;
+        idx_offset += idx_size;
+    }
+    *out_vtx_base = 0;
+    *out_idx_base = 0;
+}
+#endif
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -317,6 +466,9 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     if (fb_width <= 0 || fb_height <= 0)
         return;
 
+    // Upload modified regions of the font atlas
+    ImGui_ImplOpenGL3_UpdateFontsTexture();
+
     // Backup GL state
     GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
     glActiveTexture(GL_TEXTURE0);
@@ -354,6 +506,14 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GLuint vertex_array_object = 0;
 #ifndef IMGUI_IMPL_OPENGL_ES2
     glGenVertexArrays(1, &vertex_array_object);
+#endif
+    unsigned int vtx_base = 0, idx_base = 0; // Position of current ImDrawList in the vertex/index buffers (non-zero with stream buffers)
+#ifdef IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+    if (g_StreamEnabled)
+    {
+        glBindVertexArray(vertex_array_object); // Binding GL_ELEMENT_ARRAY_BUFFER modifies the current VAO
+        ImGui_ImplOpenGL3_UploadStreamBuffers(draw_data, &vtx_base, &idx_base);
+    }
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
@@ -367,8 +527,13 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
         // Upload vertex/index buffers
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+#ifdef IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+        if (!g_StreamEnabled)
+#endif
+        {
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        }
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -400,14 +565,30 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->TextureId);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                     if (g_GlVersion >= 320)
-                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
+                        glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)((idx_base + pcmd->IdxOffset) * sizeof(ImDrawIdx)), (GLint)(vtx_base + pcmd->VtxOffset));
                     else
 #endif
-                    glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)));
+                    glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)((idx_base + pcmd->IdxOffset) * sizeof(ImDrawIdx)));
                 }
             }
         }
+#ifdef IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+        if (g_StreamEnabled)
+        {
+            vtx_base += (unsigned int)cmd_list->VtxBuffer.Size;
+            idx_base += (unsigned int)cmd_list->IdxBuffer.Size;
+        }
+#endif
+    }
+
+#if defined(IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS) && defined(IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE)
+    // Fence the ring buffer region used by this frame, and move to the next one
+    if (g_StreamEnabled && g_StreamPersistent)
+    {
+        g_StreamFences[g_StreamFrame] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        g_StreamFrame = (g_StreamFrame + 1) % IMGUI_IMPL_OPENGL_STREAM_FRAMES;
     }
+#endif
 
     // Destroy the temporary VAO
 #ifndef IMGUI_IMPL_OPENGL_ES2
@@ -465,6 +646,7 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
 
     // Store our identifier
     io.Fonts->TexID = (ImTextureID)(intptr_t)g_FontTexture;
+    io.Fonts->ClearTexDirtyRects();
 
     // Restore state
     glBindTexture(GL_TEXTURE_2D, last_texture);
@@ -472,6 +654,46 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     return true;
 }
 
+void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImFontAtlas* atlas = io.Fonts;
+    if (g_FontTexture == 0 || atlas->TexDirtyRects.Size == 0)
+        return;
+    if (!atlas->IsBuilt()) // CPU pixel data was cleared: nothing to upload from
+    {
+        atlas->ClearTexDirtyRects();
+        return;
+    }
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // Upload each modified region. Without GL_UNPACK_ROW_LENGTH (ES 2.0) we upload full rows.
+    GLint last_texture;
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, width);
+#endif
+    for (int n = 0; n < atlas->TexDirtyRects.Size; n++)
+    {
+        const ImFontAtlasRect& r = atlas->TexDirtyRects[n];
+#ifdef GL_UNPACK_ROW_LENGTH
+        glTexSubImage2D(GL_TEXTURE_2D, 0, r.X, r.Y, r.Width, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels + ((size_t)r.Y * width + r.X) * 4);
+#else
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, r.Y, width, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)r.Y * width * 4);
+#endif
+    }
+#ifdef GL_UNPACK_ROW_LENGTH
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    atlas->ClearTexDirtyRects();
+
+    // Restore state
+    glBindTexture(GL_TEXTURE_2D, last_texture);
+}
+
 void ImGui_ImplOpenGL3_DestroyFontsTexture()
 {
     if (g_FontTexture)
@@ -703,6 +925,9 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
     if (g_VboHandle)        { glDeleteBuffers(1, &g_VboHandle); g_VboHandle = 0; }
     if (g_ElementsHandle)   { glDeleteBuffers(1, &g_ElementsHandle); g_ElementsHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_HAS_STREAM_BUFFERS
+    ImGui_ImplOpenGL3_DestroyStreamBuffers();
+#endif
     if (g_ShaderHandle && g_VertHandle) { glDetachShader(g_ShaderHandle, g_VertHandle); }
     if (g_ShaderHandle && g_FragHandle) { glDetachShader(g_ShaderHandle, g_FragHandle); }
     if (g_VertHandle)       { glDeleteShader(g_VertHandle); g_VertHandle = 0; }
@@ -0,0 +1,650 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer (no GPU or graphics API required)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..), or none to render headless (e.g. UI snapshots on a server).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Incremental font atlas texture updates (ImGuiBackendFlags_RendererHasTexUpdates).
+//  [X] Renderer: Multi-threaded rasterization of screen tiles, using io.ParallelForFn when set.
+
+// You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
+// Read online: https://github.com/ocornut/imgui/tree/master/docs
+
+// CHANGELOG
+// (minor and older changes stripped away, please see git history for details)
+//  2020-11-16: Initial version: tiled scan conversion (multi-threaded with io.ParallelForFn), fast paths for axis-aligned solid and textured rectangles.
+
+// How it works:
+// - Each draw command is converted into primitives clipped by its ClipRect: axis-aligned rectangles (detected from the two triangles
+//   emitted by ImDrawList::PrimRect() and PrimRectUV(), e.g. window backgrounds and text glyphs) and generic triangles.
+// - Primitives are binned into 64x64 pixels screen tiles, which are rasterized independently (in parallel when io.ParallelForFn is set),
+//   each drawing its primitives in submission order. User callbacks are called after rasterizing the primitives submitted before them.
+// - Triangles are scan converted with fixed point edge functions (1/16th pixel precision) and a top-left fill rule, so triangles sharing
+//   an edge never blend the same pixel twice. Color and UV are interpolated linearly, textures are sampled with bilinear filtering
+//   (rectangles mapping texels 1:1 to pixels, e.g. unscaled text glyphs, use a faster and equivalent nearest filtering).
+// - Blending is "over": color = src.rgb * src.a + dst.rgb * (1 - src.a), alpha = src.a + dst.a * (1 - src.a).
+
+#include "imgui.h"
+#include "imgui_impl_softraster.h"
+#include <math.h>       // floorf, fabsf
+#include <string.h>     // memset
+
+// Primitive types
+enum ImGui_ImplSoftRaster_PrimType
+{
+    ImGui_ImplSoftRaster_PrimType_Triangle,         // Interpolated color and UV
+    ImGui_ImplSoftRaster_PrimType_TriangleSolid,    // Constant color (same color and UV on every vertex)
+    ImGui_ImplSoftRaster_PrimType_Rect,             // Axis-aligned rectangle of constant color
+    ImGui_ImplSoftRaster_PrimType_RectUV,           // Axis-aligned rectangle of constant vertex color, with UV varying along each axis and texels mapped 1:1 to pixels (e.g. text glyph)
+    ImGui_ImplSoftRaster_PrimType_RectUVFiltered    // Same as RectUV with any other mapping (e.g. scaled text glyph, image), sampled with bilinear filtering
+};
+
+// A primitive with its pixels bounds, already clipped by the scissor rectangle and framebuffer
+struct ImGui_ImplSoftRaster_Prim
+{
+    ImGui_ImplSoftRaster_PrimType   Type;
+    int                             MinX, MinY, MaxX, MaxY; // Pixels [MinX,MaxX) x [MinY,MaxY)
+    const ImGui_ImplSoftRaster_Texture* Texture;
+    ImU32                           Col[3];                 // Triangle: color of each vertex. Other types: Col[0] (modulated by the texture color except for RectUV)
+    int                             X[3], Y[3];             // Triangle: vertex positions in fixed point
+    ImVec2                          UV[3];                  // Triangle: UV of each vertex. RectUV*: UV[0] = UV at the center of pixel (0,0), UV[1] = UV increment per pixel
+};
+
+// Rasterization settings
+static const int    g_SubPixelBits = 4;                     // Vertex positions are snapped to 1/16th of a pixel
+static const int    g_SubPixelOne = 1 << g_SubPixelBits;
+static const float  g_MaxCoord = (float)(1 << 20);          // Triangles with vertices further from the framebuffer are not rendered (would overflow fixed point maths)
+static const int    g_TileSize = 64;
+
+// Software Rasterizer Data
+static ImGui_ImplSoftRaster_Texture     g_FontTexture = { NULL, 0, 0 };
+static ImVector<ImGui_ImplSoftRaster_Prim> g_Prims;         // Primitives waiting to be rasterized
+static ImVector<int>    g_TilePrimsOffsets;                 // Per tile offset into g_TilePrims[] (+ one entry for the end)
+static ImVector<int>    g_TilePrims;                        // Primitives indices of each tile, in submission order
+static ImU32*           g_TargetPixels = NULL;
+static int              g_TargetWidth = 0;
+static int              g_TargetHeight = 0;
+static int              g_TargetStride = 0;
+static int              g_TilesCountX = 0;
+static int              g_TilesCountY = 0;
+
+// Functions
+bool    ImGui_ImplSoftRaster_Init()
+{
+    // Setup backend capabilities flags
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = "imgui_impl_softraster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;      // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates;     // We can upload io.Fonts->TexDirtyRects[], allowing for ImFontAtlasFlags_DynamicGlyphs.
+    return true;
+}
+
+void    ImGui_ImplSoftRaster_Shutdown()
+{
+    ImGui_ImplSoftRaster_DestroyFontsTexture();
+    g_Prims.clear();
+    g_TilePrimsOffsets.clear();
+    g_TilePrims.clear();
+}
+
+void    ImGui_ImplSoftRaster_NewFrame()
+{
+    if (!g_FontTexture.Pixels)
+        ImGui_ImplSoftRaster_CreateFontsTexture();
+    else
+        ImGui_ImplSoftRaster_UpdateFontsTexture();
+}
+
+//-----------------------------------------------------------------------------
+// Pixel helpers
+//-----------------------------------------------------------------------------
+
+// Exact and rounded x / 255 for x in [0, 255*255]
+static inline ImU32 Div255(ImU32 x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+// Multiply each channel of two colors
+static inline ImU32 ImGui_ImplSoftRaster_Modulate(ImU32 col_a, ImU32 col_b)
+{
+    if (col_b == IM_COL32_WHITE)
+        return col_a;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= Div255(((col_a >> shift) & 0xFF) * ((col_b >> shift) & 0xFF)) << shift;
+    return out;
+}
+
+// Blend 'src' over 'dst'
+static inline ImU32 ImGui_ImplSoftRaster_Blend(ImU32 dst, ImU32 src)
+{
+    const ImU32 src_a = (src >> IM_COL32_A_SHIFT) & 0xFF;
+    if (src_a == 0xFF)
+        return src;
+    if (src_a == 0)
+        return dst;
+    const ImU32 inv_a = 255 - src_a;
+    ImU32 out = (src_a + Div255(((dst >> IM_COL32_A_SHIFT) & 0xFF) * inv_a)) << IM_COL32_A_SHIFT;
+    for (int shift = 0; shift < 32; shift += 8)
+        if (shift != IM_COL32_A_SHIFT)
+            out |= Div255(((src >> shift) & 0xFF) * src_a + ((dst >> shift) & 0xFF) * inv_a) << shift;
+    return out;
+}
+
+static inline ImU32 ImGui_ImplSoftRaster_Sample(const ImGui_ImplSoftRaster_Texture* tex, float u, float v)
+{
+    if (tex == NULL)
+        return IM_COL32_WHITE;
+    int x = (int)(u * (float)tex->Width);
+    int y = (int)(v * (float)tex->Height);
+    x = (x < 0) ? 0 : (x >= tex->Width) ? tex->Width - 1 : x;
+    y = (y < 0) ? 0 : (y >= tex->Height) ? tex->Height - 1 : y;
+    return tex->Pixels[y * tex->Width + x];
+}
+
+// Bilinear filtering (texel centers at +0.5), using 8-bit weights. Used for triangles whose UV vary (e.g. anti-aliased
+// thick lines sampling the baked lines texture, which relies on filtering to produce their edge gradient).
+static inline ImU32 ImGui_ImplSoftRaster_SampleBilinear(const ImGui_ImplSoftRaster_Texture* tex, float u, float v)
+{
+    if (tex == NULL)
+        return IM_COL32_WHITE;
+    const float fx = u * (float)tex->Width - 0.5f;
+    const float fy = v * (float)tex->Height - 0.5f;
+    const float fx_floor = floorf(fx);
+    const float fy_floor = floorf(fy);
+    const ImU32 wx = (ImU32)((fx - fx_floor) * 256.0f);
+    const ImU32 wy = (ImU32)((fy - fy_floor) * 256.0f);
+    int x0 = (int)fx_floor, y0 = (int)fy_floor;
+    int x1 = x0 + 1, y1 = y0 + 1;
+    x0 = (x0 < 0) ? 0 : (x0 >= tex->Width) ? tex->Width - 1 : x0;
+    x1 = (x1 < 0) ? 0 : (x1 >= tex->Width) ? tex->Width - 1 : x1;
+    y0 = (y0 < 0) ? 0 : (y0 >= tex->Height) ? tex->Height - 1 : y0;
+    y1 = (y1 < 0) ? 0 : (y1 >= tex->Height) ? tex->Height - 1 : y1;
+    const ImU32 c00 = tex->Pixels[y0 * tex->Width + x0], c10 = tex->Pixels[y0 * tex->Width + x1];
+    const ImU32 c01 = tex->Pixels[y1 * tex->Width + x0], c11 = tex->Pixels[y1 * tex->Width + x1];
+    if (c00 == c10 && c00 == c01 && c00 == c11)
+        return c00;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const ImU32 top = ((c00 >> shift) & 0xFF) * (256 - wx) + ((c10 >> shift) & 0xFF) * wx;
+        const ImU32 bottom = ((c01 >> shift) & 0xFF) * (256 - wx) + ((c11 >> shift) & 0xFF) * wx;
+        out |= ((top * (256 - wy) + bottom * wy + 32768) >> 16) << shift;
+    }
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+// Rasterization of primitives within a tile
+//-----------------------------------------------------------------------------
+
+// Fill [x0,x1) x [y0,y1) with a constant color
+static void ImGui_ImplSoftRaster_FillRect(int x0, int y0, int x1, int y1, ImU32 col)
+{
+    const ImU32 col_a = (col >> IM_COL32_A_SHIFT) & 0xFF;
+    if (col_a == 0)
+        return;
+    for (int y = y0; y < y1; y++)
+    {
+        ImU32* dst = g_TargetPixels + (size_t)y * g_TargetStride;
+        if (col_a == 0xFF)
+            for (int x = x0; x < x1; x++)
+                dst[x] = col;
+        else
+            for (int x = x0; x < x1; x++)
+                dst[x] = ImGui_ImplSoftRaster_Blend(dst[x], col);
+    }
+}
+
+// Fill [x0,x1) x [y0,y1) with a texture, UV varying along each axis
+static void ImGui_ImplSoftRaster_FillRectUV(const ImGui_ImplSoftRaster_Prim& prim, int x0, int y0, int x1, int y1)
+{
+    const ImGui_ImplSoftRaster_Texture* tex = prim.Texture;
+    if (tex == NULL)
+    {
+        ImGui_ImplSoftRaster_FillRect(x0, y0, x1, y1, prim.Col[0]);
+        return;
+    }
+    if (prim.Type == ImGui_ImplSoftRaster_PrimType_RectUVFiltered)
+    {
+        for (int y = y0; y < y1; y++)
+        {
+            const float v = prim.UV[0].y + prim.UV[1].y * (float)y;
+            ImU32* dst = g_TargetPixels + (size_t)y * g_TargetStride;
+            for (int x = x0; x < x1; x++)
+            {
+                const ImU32 texel = ImGui_ImplSoftRaster_SampleBilinear(tex, prim.UV[0].x + prim.UV[1].x * (float)x, v);
+                if (((texel >> IM_COL32_A_SHIFT) & 0xFF) != 0)
+                    dst[x] = ImGui_ImplSoftRaster_Blend(dst[x], ImGui_ImplSoftRaster_Modulate(prim.Col[0], texel));
+            }
+        }
+        return;
+    }
+
+    // Texel column of each pixel column
+    int tex_x[g_TileSize];
+    for (int x = x0; x < x1; x++)
+    {
+        int tx = (int)((prim.UV[0].x + prim.UV[1].x * (float)x) * (float)tex->Width);
+        tex_x[x - x0] = (tx < 0) ? 0 : (tx >= tex->Width) ? tex->Width - 1 : tx;
+    }
+    const ImU32 col = prim.Col[0];
+    for (int y = y0; y < y1; y++)
+    {
+        int ty = (int)((prim.UV[0].y + prim.UV[1].y * (float)y) * (float)tex->Height);
+        ty = (ty < 0) ? 0 : (ty >= tex->Height) ? tex->Height - 1 : ty;
+        const ImU32* src = tex->Pixels + (size_t)ty * tex->Width;
+        ImU32* dst = g_TargetPixels + (size_t)y * g_TargetStride;
+        for (int x = x0; x < x1; x++)
+        {
+            const ImU32 texel = src[tex_x[x - x0]];
+            if (((texel >> IM_COL32_A_SHIFT) & 0xFF) == 0) // Most texels around glyphs are transparent
+                continue;
+            dst[x] = ImGui_ImplSoftRaster_Blend(dst[x], ImGui_ImplSoftRaster_Modulate(col, texel));
+        }
+    }
+}
+
+// Scan convert a triangle over [x0,x1) x [y0,y1)
+static void ImGui_ImplSoftRaster_FillTriangle(const ImGui_ImplSoftRaster_Prim& prim, int x0, int y0, int x1, int y1)
+{
+    // Edge functions for edges (v1,v2), (v2,v0), (v0,v1), evaluated at the center of pixel (x0,y0).
+    // Each gives the barycentric weight of the opposite vertex, scaled by twice the triangle area.
+    // A pixel is inside when all are >= 0: subtract 1 from the edges which aren't top or left edges, so pixels exactly on them are outside.
+    const int px = x0 * g_SubPixelOne + g_SubPixelOne / 2;
+    const int py = y0 * g_SubPixelOne + g_SubPixelOne / 2;
+    ImS64 w_row[3];
+    ImS64 step_x[3];
+    ImS64 step_y[3];
+    for (int n = 0; n < 3; n++)
+    {
+        const int a = (n + 1) % 3;
+        const int b = (n + 2) % 3;
+        const int dx = prim.X[b] - prim.X[a];
+        const int dy = prim.Y[b] - prim.Y[a];
+        const bool is_top_left = (dy < 0) || (dy == 0 && dx > 0);
+        w_row[n] = (ImS64)dx * (py - prim.Y[a]) - (ImS64)dy * (px - prim.X[a]) - (is_top_left ? 0 : 1);
+        step_x[n] = -(ImS64)dy * g_SubPixelOne;
+        step_y[n] = (ImS64)dx * g_SubPixelOne;
+    }
+
+    if (prim.Type == ImGui_ImplSoftRaster_PrimType_TriangleSolid)
+    {
+        const ImU32 col = prim.Col[0];
+        for (int y = y0; y < y1; y++)
+        {
+            ImU32* dst = g_TargetPixels + (size_t)y * g_TargetStride;
+            ImS64 w0 = w_row[0], w1 = w_row[1], w2 = w_row[2];
+            for (int x = x0; x < x1; x++)
+            {
+                if ((w0 | w1 | w2) >= 0)
+                    dst[x] = ImGui_ImplSoftRaster_Blend(dst[x], col);
+                w0 += step_x[0]; w1 += step_x[1]; w2 += step_x[2];
+            }
+            w_row[0] += step_y[0]; w_row[1] += step_y[1]; w_row[2] += step_y[2];
+        }
+        return;
+    }
+
+    // Interpolate color channels and UV from barycentric weights
+    const ImS64 area = (ImS64)(prim.X[1] - prim.X[0]) * (prim.Y[2] - prim.Y[0]) - (ImS64)(prim.Y[1] - prim.Y[0]) * (prim.X[2] - prim.X[0]);
+    const float inv_area = 1.0f / (float)area;
+    float col0[4], col_d1[4], col_d2[4];
+    for (int c = 0; c < 4; c++)
+    {
+        col0[c] = (float)((prim.Col[0] >> (c * 8)) & 0xFF);
+        col_d1[c] = (float)((prim.Col[1] >> (c * 8)) & 0xFF) - col0[c];
+        col_d2[c] = (float)((prim.Col[2] >> (c * 8)) & 0xFF) - col0[c];
+    }
+    const ImVec2 uv0 = prim.UV[0];
+    const ImVec2 uv_d1(prim.UV[1].x - uv0.x, prim.UV[1].y - uv0.y);
+    const ImVec2 uv_d2(prim.UV[2].x - uv0.x, prim.UV[2].y - uv0.y);
+    for (int y = y0; y < y1; y++)
+    {
+        ImU32* dst = g_TargetPixels + (size_t)y * g_TargetStride;
+        ImS64 w0 = w_row[0], w1 = w_row[1], w2 = w_row[2];
+        for (int x = x0; x < x1; x++)
+        {
+            if ((w0 | w1 | w2) >= 0)
+            {
+                const float l1 = (float)w1 * inv_area;
+                const float l2 = (float)w2 * inv_area;
+                ImU32 col = 0;
+                for (int c = 0; c < 4; c++)
+                {
+                    const int v = (int)(col0[c] + col_d1[c] * l1 + col_d2[c] * l2 + 0.5f);
+                    col |= (ImU32)((v < 0) ? 0 : (v > 255) ? 255 : v) << (c * 8);
+                }
+                const ImU32 texel = ImGui_ImplSoftRaster_SampleBilinear(prim.Texture, uv0.x + uv_d1.x * l1 + uv_d2.x * l2, uv0.y + uv_d1.y * l1 + uv_d2.y * l2);
+                dst[x] = ImGui_ImplSoftRaster_Blend(dst[x], ImGui_ImplSoftRaster_Modulate(col, texel));
+            }
+            w0 += step_x[0]; w1 += step_x[1]; w2 += step_x[2];
+        }
+        w_row[0] += step_y[0]; w_row[1] += step_y[1]; w_row[2] += step_y[2];
+    }
+}
+
+// Job: draw primitives of a tile in submission order
+static void ImGui_ImplSoftRaster_RasterizeTile(void* user_data, int tile_n)
+{
+    IM_UNUSED(user_data);
+    const int tile_x0 = (tile_n % g_TilesCountX) * g_TileSize;
+    const int tile_y0 = (tile_n / g_TilesCountX) * g_TileSize;
+    const int tile_x1 = (tile_x0 + g_TileSize < g_TargetWidth) ? tile_x0 + g_TileSize : g_TargetWidth;
+    const int tile_y1 = (tile_y0 + g_TileSize < g_TargetHeight) ? tile_y0 + g_TileSize : g_TargetHeight;
+    for (int n = g_TilePrimsOffsets[tile_n]; n < g_TilePrimsOffsets[tile_n + 1]; n++)
+    {
+        const ImGui_ImplSoftRaster_Prim& prim = g_Prims[g_TilePrims[n]];
+        const int x0 = (prim.MinX > tile_x0) ? prim.MinX : tile_x0;
+        const int y0 = (prim.MinY > tile_y0) ? prim.MinY : tile_y0;
+        const int x1 = (prim.MaxX < tile_x1) ? prim.MaxX : tile_x1;
+        const int y1 = (prim.MaxY < tile_y1) ? prim.MaxY : tile_y1;
+        switch (prim.Type)
+        {
+        case ImGui_ImplSoftRaster_PrimType_Rect:    ImGui_ImplSoftRaster_FillRect(x0, y0, x1, y1, prim.Col[0]); break;
+        case ImGui_ImplSoftRaster_PrimType_RectUV:
+        case ImGui_ImplSoftRaster_PrimType_RectUVFiltered:  ImGui_ImplSoftRaster_FillRectUV(prim, x0, y0, x1, y1); break;
+        default:                                    ImGui_ImplSoftRaster_FillTriangle(prim, x0, y0, x1, y1); break;
+        }
+    }
+}
+
+// Bin pending primitives into tiles and rasterize them
+static void ImGui_ImplSoftRaster_Flush()
+{
+    if (g_Prims.Size == 0)
+        return;
+
+    // Count primitives per tile, then store their indices in submission order
+    const int tiles_count = g_TilesCountX * g_TilesCountY;
+    g_TilePrimsOffsets.resize(tiles_count + 1);
+    memset(g_TilePrimsOffsets.Data, 0, (size_t)g_TilePrimsOffsets.size_in_bytes());
+    for (int prim_n = 0; prim_n < g_Prims.Size; prim_n++)
+    {
+        const ImGui_ImplSoftRaster_Prim& prim = g_Prims[prim_n];
+        for (int ty = prim.MinY / g_TileSize; ty <= (prim.MaxY - 1) / g_TileSize; ty++)
+            for (int tx = prim.MinX / g_TileSize; tx <= (prim.MaxX - 1) / g_TileSize; tx++)
+                g_TilePrimsOffsets[ty * g_TilesCountX + tx + 1]++;
+    }
+    for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+        g_TilePrimsOffsets[tile_n + 1] += g_TilePrimsOffsets[tile_n];
+    g_TilePrims.resize(g_TilePrimsOffsets[tiles_count]);
+    for (int prim_n = 0; prim_n < g_Prims.Size; prim_n++)
+    {
+        const ImGui_ImplSoftRaster_Prim& prim = g_Prims[prim_n];
+        for (int ty = prim.MinY / g_TileSize; ty <= (prim.MaxY - 1) / g_TileSize; ty++)
+            for (int tx = prim.MinX / g_TileSize; tx <= (prim.MaxX - 1) / g_TileSize; tx++)
+                g_TilePrims[g_TilePrimsOffsets[ty * g_TilesCountX + tx]++] = prim_n;
+    }
+    for (int tile_n = tiles_count; tile_n > 0; tile_n--) // Offsets were moved to the end of each tile: shift them back
+        g_TilePrimsOffsets[tile_n] = g_TilePrimsOffsets[tile_n - 1];
+    g_TilePrimsOffsets[0] = 0;
+
+    // Tiles don't overlap: rasterize them in parallel
+    ImGuiIO& io = ImGui::GetIO();
+    if (io.ParallelForFn != NULL && tiles_count > 1)
+        io.ParallelForFn(io.ParallelForUserData, ImGui_ImplSoftRaster_RasterizeTile, NULL, tiles_count);
+    else
+        for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+            ImGui_ImplSoftRaster_RasterizeTile(NULL, tile_n);
+    g_Prims.resize(0);
+}
+
+//-----------------------------------------------------------------------------
+// Conversion of draw commands into primitives
+//-----------------------------------------------------------------------------
+
+static inline int ImGui_ImplSoftRaster_ToFixed(float v)
+{
+    return (int)floorf(v * (float)g_SubPixelOne + 0.5f);
+}
+
+// First pixel whose center is at or after a fixed point coordinate
+static inline int ImGui_ImplSoftRaster_FirstPixel(int v)
+{
+    v = v - g_SubPixelOne / 2 + g_SubPixelOne - 1;
+    return (v >= 0) ? (v >> g_SubPixelBits) : -((-v + g_SubPixelOne - 1) >> g_SubPixelBits); // Rounded down
+}
+
+// Clip primitive pixel bounds by the scissor rectangle. Return false if empty.
+static inline bool ImGui_ImplSoftRaster_ClipPrim(ImGui_ImplSoftRaster_Prim* prim, const int clip[4])
+{
+    if (prim->MinX < clip[0]) prim->MinX = clip[0];
+    if (prim->MinY < clip[1]) prim->MinY = clip[1];
+    if (prim->MaxX > clip[2]) prim->MaxX = clip[2];
+    if (prim->MaxY > clip[3]) prim->MaxY = clip[3];
+    return prim->MinX < prim->MaxX && prim->MinY < prim->MaxY;
+}
+
+// Detect the two triangles emitted by ImDrawList::PrimRect() / PrimRectUV(): vertices a,b,c,d with indices (a,b,c) (a,c,d),
+// forming an axis-aligned rectangle of constant color, with U varying along X only and V along Y only.
+static bool ImGui_ImplSoftRaster_AddRect(const ImDrawVert* vtx_buffer, const ImDrawIdx* idx, const ImVec2& off, const ImVec2& scale, const ImGui_ImplSoftRaster_Texture* tex, const int clip[4])
+{
+    if (idx[3] != idx[0] || idx[4] != idx[2])
+        return false;
+    const ImDrawVert& a = vtx_buffer[idx[0]];
+    const ImDrawVert& b = vtx_buffer[idx[1]];
+    const ImDrawVert& c = vtx_buffer[idx[2]];
+    const ImDrawVert& d = vtx_buffer[idx[5]];
+    if (a.pos.y != b.pos.y || b.pos.x != c.pos.x || c.pos.y != d.pos.y || d.pos.x != a.pos.x || a.pos.x == c.pos.x || a.pos.y == c.pos.y)
+        return false;
+    if (a.col != b.col || a.col != c.col || a.col != d.col)
+        return false;
+    if (a.uv.y != b.uv.y || b.uv.x != c.uv.x || c.uv.y != d.uv.y || d.uv.x != a.uv.x)
+        return false;
+
+    const float x0 = (a.pos.x - off.x) * scale.x, y0 = (a.pos.y - off.y) * scale.y;
+    const float x1 = (c.pos.x - off.x) * scale.x, y1 = (c.pos.y - off.y) * scale.y;
+    if (x0 < -g_MaxCoord || x0 > g_MaxCoord || y0 < -g_MaxCoord || y0 > g_MaxCoord || x1 < -g_MaxCoord || x1 > g_MaxCoord || y1 < -g_MaxCoord || y1 > g_MaxCoord)
+        return true; // Not rendered
+    ImGui_ImplSoftRaster_Prim prim;
+    prim.MinX = ImGui_ImplSoftRaster_FirstPixel(ImGui_ImplSoftRaster_ToFixed(x0 < x1 ? x0 : x1));
+    prim.MinY = ImGui_ImplSoftRaster_FirstPixel(ImGui_ImplSoftRaster_ToFixed(y0 < y1 ? y0 : y1));
+    prim.MaxX = ImGui_ImplSoftRaster_FirstPixel(ImGui_ImplSoftRaster_ToFixed(x0 < x1 ? x1 : x0));
+    prim.MaxY = ImGui_ImplSoftRaster_FirstPixel(ImGui_ImplSoftRaster_ToFixed(y0 < y1 ? y1 : y0));
+    if (!ImGui_ImplSoftRaster_ClipPrim(&prim, clip))
+        return true;
+    prim.Texture = tex;
+    if (a.uv.x == c.uv.x && a.uv.y == c.uv.y)
+    {
+        // Solid color (e.g. window background using the white pixel of the font atlas)
+        prim.Type = ImGui_ImplSoftRaster_PrimType_Rect;
+        prim.Col[0] = ImGui_ImplSoftRaster_Modulate(a.col, ImGui_ImplSoftRaster_Sample(tex, a.uv.x, a.uv.y));
+    }
+    else
+    {
+        // Textured (e.g. text glyph): store UV at the center of pixel (0,0) and UV increment per pixel
+        prim.Type = ImGui_ImplSoftRaster_PrimType_RectUV;
+        prim.Col[0] = a.col;
+        prim.UV[1] = ImVec2((c.uv.x - a.uv.x) / (x1 - x0), (c.uv.y - a.uv.y) / (y1 - y0));
+        prim.UV[0] = ImVec2(a.uv.x + (0.5f - x0) * prim.UV[1].x, a.uv.y + (0.5f - y0) * prim.UV[1].y);
+
+        // Nearest filtering is exact when texel centers fall on pixel centers, otherwise filter
+        if (tex != NULL)
+        {
+            const float step_x = prim.UV[1].x * (float)tex->Width, step_y = prim.UV[1].y * (float)tex->Height;
+            const float offset_x = prim.UV[0].x * (float)tex->Width - 0.5f, offset_y = prim.UV[0].y * (float)tex->Height - 0.5f;
+            const float eps = 1.0f / 256.0f;
+            if (fabsf(fabsf(step_x) - 1.0f) > eps || fabsf(fabsf(step_y) - 1.0f) > eps || fabsf(offset_x - floorf(offset_x + 0.5f)) > eps || fabsf(offset_y - floorf(offset_y + 0.5f)) > eps)
+                prim.Type = ImGui_ImplSoftRaster_PrimType_RectUVFiltered;
+        }
+    }
+    g_Prims.push_back(prim);
+    return true;
+}
+
+static void ImGui_ImplSoftRaster_AddTriangle(const ImDrawVert* vtx_buffer, const ImDrawIdx* idx, const ImVec2& off, const ImVec2& scale, const ImGui_ImplSoftRaster_Texture* tex, const int clip[4])
+{
+    ImGui_ImplSoftRaster_Prim prim;
+    for (int n = 0; n < 3; n++)
+    {
+        const ImDrawVert& v = vtx_buffer[idx[n]];
+        const float x = (v.pos.x - off.x) * scale.x;
+        const float y = (v.pos.y - off.y) * scale.y;
+        if (!(x >= -g_MaxCoord && x <= g_MaxCoord && y >= -g_MaxCoord && y <= g_MaxCoord))
+            return; // Not rendered
+        prim.X[n] = ImGui_ImplSoftRaster_ToFixed(x);
+        prim.Y[n] = ImGui_ImplSoftRaster_ToFixed(y);
+        prim.UV[n] = v.uv;
+        prim.Col[n] = v.col;
+    }
+
+    // Make winding consistent (positive area), skip degenerate triangles
+    const ImS64 area = (ImS64)(prim.X[1] - prim.X[0]) * (prim.Y[2] - prim.Y[0]) - (ImS64)(prim.Y[1] - prim.Y[0]) * (prim.X[2] - prim.X[0]);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        int tmp_x = prim.X[1]; prim.X[1] = prim.X[2]; prim.X[2] = tmp_x;
+        int tmp_y = prim.Y[1]; prim.Y[1] = prim.Y[2]; prim.Y[2] = tmp_y;
+        ImVec2 tmp_uv = prim.UV[1]; prim.UV[1] = prim.UV[2]; prim.UV[2] = tmp_uv;
+        ImU32 tmp_col = prim.Col[1]; prim.Col[1] = prim.Col[2]; prim.Col[2] = tmp_col;
+    }
+
+    // Pixel bounds
+    const int min_x = (prim.X[0] < prim.X[1]) ? (prim.X[0] < prim.X[2] ? prim.X[0] : prim.X[2]) : (prim.X[1] < prim.X[2] ? prim.X[1] : prim.X[2]);
+    const int min_y = (prim.Y[0] < prim.Y[1]) ? (prim.Y[0] < prim.Y[2] ? prim.Y[0] : prim.Y[2]) : (prim.Y[1] < prim.Y[2] ? prim.Y[1] : prim.Y[2]);
+    const int max_x = (prim.X[0] > prim.X[1]) ? (prim.X[0] > prim.X[2] ? prim.X[0] : prim.X[2]) : (prim.X[1] > prim.X[2] ? prim.X[1] : prim.X[2]);
+    const int max_y = (prim.Y[0] > prim.Y[1]) ? (prim.Y[0] > prim.Y[2] ? prim.Y[0] : prim.Y[2]) : (prim.Y[1] > prim.Y[2] ? prim.Y[1] : prim.Y[2]);
+    prim.MinX = ImGui_ImplSoftRaster_FirstPixel(min_x);
+    prim.MinY = ImGui_ImplSoftRaster_FirstPixel(min_y);
+    prim.MaxX = ImGui_ImplSoftRaster_FirstPixel(max_x + 1);
+    prim.MaxY = ImGui_ImplSoftRaster_FirstPixel(max_y + 1);
+    if (!ImGui_ImplSoftRaster_ClipPrim(&prim, clip))
+        return;
+
+    prim.Texture = tex;
+    if (prim.Col[0] == prim.Col[1] && prim.Col[0] == prim.Col[2] && prim.UV[0].x == prim.UV[1].x && prim.UV[0].x == prim.UV[2].x && prim.UV[0].y == prim.UV[1].y && prim.UV[0].y == prim.UV[2].y)
+    {
+        prim.Type = ImGui_ImplSoftRaster_PrimType_TriangleSolid;
+        prim.Col[0] = ImGui_ImplSoftRaster_Modulate(prim.Col[0], ImGui_ImplSoftRaster_Sample(tex, prim.UV[0].x, prim.UV[0].y));
+    }
+    else
+    {
+        prim.Type = ImGui_ImplSoftRaster_PrimType_Triangle;
+    }
+    g_Prims.push_back(prim);
+}
+
+// Software Rasterizer Render function.
+void    ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height, int stride)
+{
+    if (width <= 0 || height <= 0 || pixels == NULL)
+        return;
+
+    // Refresh font texture after glyphs were added to it
+    ImGui_ImplSoftRaster_UpdateFontsTexture();
+
+    g_TargetPixels = pixels;
+    g_TargetWidth = width;
+    g_TargetHeight = height;
+    g_TargetStride = (stride > 0) ? stride : width;
+    g_TilesCountX = (width + g_TileSize - 1) / g_TileSize;
+    g_TilesCountY = (height + g_TileSize - 1) / g_TileSize;
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    // Render command lists
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                // Rasterize previous commands first, so the callback can read or draw over them.
+                ImGui_ImplSoftRaster_Flush();
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space, clamp to framebuffer
+            int clip[4];
+            clip[0] = (int)((pcmd->ClipRect.x - clip_off.x) * clip_scale.x);
+            clip[1] = (int)((pcmd->ClipRect.y - clip_off.y) * clip_scale.y);
+            clip[2] = (int)((pcmd->ClipRect.z - clip_off.x) * clip_scale.x);
+            clip[3] = (int)((pcmd->ClipRect.w - clip_off.y) * clip_scale.y);
+            if (clip[0] < 0) clip[0] = 0;
+            if (clip[1] < 0) clip[1] = 0;
+            if (clip[2] > width) clip[2] = width;
+            if (clip[3] > height) clip[3] = height;
+            if (clip[0] >= clip[2] || clip[1] >= clip[3])
+                continue;
+
+            const ImGui_ImplSoftRaster_Texture* tex = (const ImGui_ImplSoftRaster_Texture*)pcmd->TextureId;
+            const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            const ImDrawIdx* idx_end = idx + pcmd->ElemCount;
+            while (idx < idx_end)
+            {
+                if (idx_end - idx >= 6 && ImGui_ImplSoftRaster_AddRect(vtx_buffer, idx, clip_off, clip_scale, tex, clip))
+                {
+                    idx += 6;
+                    continue;
+                }
+                ImGui_ImplSoftRaster_AddTriangle(vtx_buffer, idx, clip_off, clip_scale, tex, clip);
+                idx += 3;
+            }
+        }
+    }
+    ImGui_ImplSoftRaster_Flush();
+    g_TargetPixels = NULL;
+}
+
+bool    ImGui_ImplSoftRaster_CreateFontsTexture()
+{
+    // Build texture atlas. Pixels are sampled directly from the atlas, which must keep them (don't call ClearTexData()).
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    g_FontTexture.Pixels = (const ImU32*)(const void*)pixels;
+    g_FontTexture.Width = width;
+    g_FontTexture.Height = height;
+
+    // Store our identifier
+    io.Fonts->TexID = (ImTextureID)&g_FontTexture;
+    io.Fonts->ClearTexDirtyRects();
+    return true;
+}
+
+void    ImGui_ImplSoftRaster_UpdateFontsTexture()
+{
+    // Modified regions of the atlas are already converted to RGBA32 in place.
+    // Refresh our pointer if the atlas was rebuilt (Build() frees the previous pixels and clears TexDirtyRects[]).
+    ImGuiIO& io = ImGui::GetIO();
+    ImFontAtlas* atlas = io.Fonts;
+    if (g_FontTexture.Pixels == NULL)
+        return;
+    if (g_FontTexture.Pixels != (const ImU32*)atlas->TexPixelsRGBA32 || g_FontTexture.Width != atlas->TexWidth || g_FontTexture.Height != atlas->TexHeight)
+    {
+        unsigned char* pixels;
+        int width, height;
+        atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+        g_FontTexture.Pixels = (const ImU32*)(const void*)pixels;
+        g_FontTexture.Width = width;
+        g_FontTexture.Height = height;
+        atlas->TexID = (ImTextureID)&g_FontTexture;
+    }
+    atlas->ClearTexDirtyRects();
+}
+
+void    ImGui_ImplSoftRaster_DestroyFontsTexture()
+{
+    if (g_FontTexture.Pixels)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.Fonts->TexID = 0;
+        g_FontTexture.Pixels = NULL;
+        g_FontTexture.Width = g_FontTexture.Height = 0;
+    }
+}
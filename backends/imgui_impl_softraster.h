@@ -0,0 +1,38 @@
+// dear imgui: Renderer Backend for a CPU software rasterizer (no GPU or graphics API required)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..), or none to render headless (e.g. UI snapshots on a server).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Incremental font atlas texture updates (ImGuiBackendFlags_RendererHasTexUpdates).
+//  [X] Renderer: Multi-threaded rasterization of screen tiles, using io.ParallelForFn when set.
+
+// You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
+// Read online: https://github.com/ocornut/imgui/tree/master/docs
+
+// The framebuffer and textures store one ImU32 per pixel using the same packing as IM_COL32() (R,G,B,A bytes in memory,
+// unless IMGUI_USE_BGRA_PACKED_COLOR is defined). Output is deterministic (pixel centers at +0.5, top-left fill rule,
+// fixed point bilinear filtering) and doesn't depend on the number of threads, so it can be used as a reference renderer
+// for pixel regression tests. It won't exactly match a GPU renderer (rounding of anti-aliased edges and filtering differ slightly).
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+
+// Texture to use as ImTextureID. A NULL ImTextureID samples as opaque white.
+struct ImGui_ImplSoftRaster_Texture
+{
+    const ImU32*    Pixels;     // Width * Height pixels, packed like IM_COL32() (e.g. from ImFontAtlas::GetTexDataAsRGBA32())
+    int             Width;
+    int             Height;
+};
+
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_Init();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_NewFrame();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, ImU32* pixels, int width, int height, int stride = 0); // Blend over existing contents of 'pixels'. 'stride' = number of pixels between rows (0: width).
+
+// Called by NewFrame/RenderDrawData/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_DestroyFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_UpdateFontsTexture();     // Refresh font texture after io.Fonts->TexDirtyRects[] were modified or the atlas was rebuilt. Called by NewFrame() and RenderDrawData().
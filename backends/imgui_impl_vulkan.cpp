@@ -3,6 +3,7 @@
 
 // Implemented features:
 //  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Incremental font atlas texture updates (ImGuiBackendFlags_RendererHasTexUpdates). Opt-in with InitInfo::UseTexUpdates, then call ImGui_ImplVulkan_UpdateFontsTexture() outside of the render pass.
 // Missing features:
 //  [ ] Renderer: User texture binding. Changes of ImTextureID aren't supported by this backend! See https://github.com/ocornut/imgui/pull/914
 
@@ -22,6 +23,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2020-11-14: Vulkan: Merge consecutive ImDrawCmd sharing texture and scissor rectangle into a single vkCmdDrawIndexed() call, including across draw lists. Skip redundant vkCmdSetScissor() calls.
+//  2020-11-12: Vulkan: Added ImGui_ImplVulkan_UpdateFontsTexture() to upload modified regions of the font atlas texture with vkCmdCopyBufferToImage(), enable ImGuiBackendFlags_RendererHasTexUpdates flag when ImGui_ImplVulkan_InitInfo::UseTexUpdates is set.
 //  2020-11-11: Vulkan: Added support for specifying which subpass to reference during VkPipeline creation.
 //  2020-09-07: Vulkan: Added VkPipeline parameter to ImGui_ImplVulkan_RenderDrawData (default to one passed to ImGui_ImplVulkan_Init).
 //  2020-05-04: Vulkan: Fixed crash if initial frame has no vertices.
@@ -62,6 +65,22 @@ struct ImGui_ImplVulkanH_FrameRenderBuffers
     VkDeviceSize        IndexBufferSize;
     VkBuffer            VertexBuffer;
     VkBuffer            IndexBuffer;
+    VkDeviceMemory      FontUploadBufferMemory;
+    VkDeviceSize        FontUploadBufferSize;
+    VkBuffer            FontUploadBuffer;
+};
+
+// A range of the merged index buffer drawn with a single vkCmdDrawIndexed() call, or a user callback (when Cmd != NULL).
+// Built by ImGui_ImplVulkan_RenderDrawData() from consecutive ImDrawCmd sharing the same texture and scissor rectangle.
+struct ImGui_ImplVulkan_DrawBatch
+{
+    VkRect2D            Scissor;
+    ImTextureID         TextureId;
+    uint32_t            IdxOffset;      // Start offset in the merged index buffer
+    uint32_t            ElemCount;
+    int32_t             VtxOffset;      // Base vertex of the indices in the batch
+    const ImDrawList*   CmdList;        // User callback only
+    const ImDrawCmd*    Cmd;            // User callback only
 };
 
 // Each viewport will hold 1 ImGui_ImplVulkanH_WindowRenderBuffers
@@ -96,6 +115,7 @@ static VkBuffer                 g_UploadBuffer = VK_NULL_HANDLE;
 
 // Render buffers
 static ImGui_ImplVulkanH_WindowRenderBuffers    g_MainWindowRenderBuffers;
+static ImVector<ImGui_ImplVulkan_DrawBatch>     g_DrawBatches;
 
 // Forward Declarations
 bool ImGui_ImplVulkan_CreateDeviceObjects();
@@ -271,6 +291,22 @@ static void CreateOrResizeBuffer(VkBuffer& buffer, VkDeviceMemory& buffer_memory
     p_buffer_size = new_size;
 }
 
+// Allocate array to store enough vertex/index buffers
+static ImGui_ImplVulkanH_WindowRenderBuffers* ImGui_ImplVulkan_GetWindowRenderBuffers()
+{
+    ImGui_ImplVulkan_InitInfo* v = &g_VulkanInitInfo;
+    ImGui_ImplVulkanH_WindowRenderBuffers* wrb = &g_MainWindowRenderBuffers;
+    if (wrb->FrameRenderBuffers == NULL)
+    {
+        wrb->Index = 0;
+        wrb->Count = v->ImageCount;
+        wrb->FrameRenderBuffers = (ImGui_ImplVulkanH_FrameRenderBuffers*)IM_ALLOC(sizeof(ImGui_ImplVulkanH_FrameRenderBuffers) * wrb->Count);
+        memset(wrb->FrameRenderBuffers, 0, sizeof(ImGui_ImplVulkanH_FrameRenderBuffers) * wrb->Count);
+    }
+    IM_ASSERT(wrb->Count == v->ImageCount);
+    return wrb;
+}
+
 static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline pipeline, VkCommandBuffer command_buffer, ImGui_ImplVulkanH_FrameRenderBuffers* rb, int fb_width, int fb_height)
 {
     // Bind pipeline and descriptor sets:
@@ -315,6 +351,99 @@ static void ImGui_ImplVulkan_SetupRenderState(ImDrawData* draw_data, VkPipeline
     }
 }
 
+// Write the indices of all visible ImDrawCmd to 'idx_dst' and fill g_DrawBatches.
+// Indices are rebased relative to a shared base vertex so that consecutive commands using the same texture and
+// scissor rectangle can be drawn with one call, even when they come from different draw lists.
+// With 16-bit indices a base vertex can only cover 64K vertices, after which a new one is started.
+static void ImGui_ImplVulkan_BuildDrawBatches(ImDrawData* draw_data, ImDrawIdx* idx_dst, int fb_width, int fb_height)
+{
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+
+    g_DrawBatches.resize(0);
+    ImGui_ImplVulkan_DrawBatch* last_batch = NULL;
+    uint32_t idx_write = 0;
+    int global_vtx_offset = 0;
+    int batch_vtx_offset = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback != NULL)
+            {
+                ImGui_ImplVulkan_DrawBatch callback_batch = {};
+                callback_batch.CmdList = cmd_list;
+                callback_batch.Cmd = pcmd;
+                g_DrawBatches.push_back(callback_batch);
+                last_batch = NULL;
+                continue;
+            }
+            if (pcmd->ElemCount == 0)
+                continue;
+
+            // Project scissor/clipping rectangles into framebuffer space
+            ImVec4 clip_rect;
+            clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
+            clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
+            clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
+            clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
+            if (!(clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f))
+                continue;
+
+            // Negative offsets are illegal for vkCmdSetScissor
+            if (clip_rect.x < 0.0f)
+                clip_rect.x = 0.0f;
+            if (clip_rect.y < 0.0f)
+                clip_rect.y = 0.0f;
+            VkRect2D scissor;
+            scissor.offset.x = (int32_t)(clip_rect.x);
+            scissor.offset.y = (int32_t)(clip_rect.y);
+            scissor.extent.width = (uint32_t)(clip_rect.z - clip_rect.x);
+            scissor.extent.height = (uint32_t)(clip_rect.w - clip_rect.y);
+
+            // Rebase indices on the current base vertex, or start a new one if they wouldn't fit in ImDrawIdx
+            const int cmd_vtx_offset = global_vtx_offset + (int)pcmd->VtxOffset;
+            if (sizeof(ImDrawIdx) == 2)
+            {
+                int cmd_vtx_count = cmd_list->VtxBuffer.Size - (int)pcmd->VtxOffset;
+                if (cmd_vtx_count > 0x10000)
+                    cmd_vtx_count = 0x10000;
+                if (cmd_vtx_offset - batch_vtx_offset + cmd_vtx_count > 0x10000)
+                    batch_vtx_offset = cmd_vtx_offset;
+            }
+            const ImDrawIdx* idx_src = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            const ImDrawIdx idx_rebase = (ImDrawIdx)(cmd_vtx_offset - batch_vtx_offset);
+            if (idx_rebase == 0)
+                memcpy(idx_dst + idx_write, idx_src, pcmd->ElemCount * sizeof(ImDrawIdx));
+            else
+                for (unsigned int i = 0; i < pcmd->ElemCount; i++)
+                    idx_dst[idx_write + i] = (ImDrawIdx)(idx_src[i] + idx_rebase);
+
+            // Merge with previous batch when possible
+            if (last_batch != NULL && last_batch->VtxOffset == batch_vtx_offset && last_batch->TextureId == pcmd->TextureId && memcmp(&last_batch->Scissor, &scissor, sizeof(VkRect2D)) == 0)
+            {
+                last_batch->ElemCount += pcmd->ElemCount;
+            }
+            else
+            {
+                ImGui_ImplVulkan_DrawBatch batch = {};
+                batch.Scissor = scissor;
+                batch.TextureId = pcmd->TextureId;
+                batch.IdxOffset = idx_write;
+                batch.ElemCount = pcmd->ElemCount;
+                batch.VtxOffset = batch_vtx_offset;
+                g_DrawBatches.push_back(batch);
+                last_batch = &g_DrawBatches.back();
+            }
+            idx_write += pcmd->ElemCount;
+        }
+        global_vtx_offset += cmd_list->VtxBuffer.Size;
+    }
+}
+
 // Render function
 void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline)
 {
@@ -328,16 +457,7 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
     if (pipeline == VK_NULL_HANDLE)
         pipeline = g_Pipeline;
 
-    // Allocate array to store enough vertex/index buffers
-    ImGui_ImplVulkanH_WindowRenderBuffers* wrb = &g_MainWindowRenderBuffers;
-    if (wrb->FrameRenderBuffers == NULL)
-    {
-        wrb->Index = 0;
-        wrb->Count = v->ImageCount;
-        wrb->FrameRenderBuffers = (ImGui_ImplVulkanH_FrameRenderBuffers*)IM_ALLOC(sizeof(ImGui_ImplVulkanH_FrameRenderBuffers) * wrb->Count);
-        memset(wrb->FrameRenderBuffers, 0, sizeof(ImGui_ImplVulkanH_FrameRenderBuffers) * wrb->Count);
-    }
-    IM_ASSERT(wrb->Count == v->ImageCount);
+    ImGui_ImplVulkanH_WindowRenderBuffers* wrb = ImGui_ImplVulkan_GetWindowRenderBuffers();
     wrb->Index = (wrb->Index + 1) % wrb->Count;
     ImGui_ImplVulkanH_FrameRenderBuffers* rb = &wrb->FrameRenderBuffers[wrb->Index];
 
@@ -351,7 +471,8 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
         if (rb->IndexBuffer == VK_NULL_HANDLE || rb->IndexBufferSize < index_size)
             CreateOrResizeBuffer(rb->IndexBuffer, rb->IndexBufferMemory, rb->IndexBufferSize, index_size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT);
 
-        // Upload vertex/index data into a single contiguous GPU buffer
+        // Upload vertex data into a single contiguous GPU buffer
+        // Index data is written by ImGui_ImplVulkan_BuildDrawBatches(), only for visible commands
         ImDrawVert* vtx_dst = NULL;
         ImDrawIdx* idx_dst = NULL;
         VkResult err = vkMapMemory(v->Device, rb->VertexBufferMemory, 0, vertex_size, 0, (void**)(&vtx_dst));
@@ -362,10 +483,9 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
         {
             const ImDrawList* cmd_list = draw_data->CmdLists[n];
             memcpy(vtx_dst, cmd_list->VtxBuffer.Data, cmd_list->VtxBuffer.Size * sizeof(ImDrawVert));
-            memcpy(idx_dst, cmd_list->IdxBuffer.Data, cmd_list->IdxBuffer.Size * sizeof(ImDrawIdx));
             vtx_dst += cmd_list->VtxBuffer.Size;
-            idx_dst += cmd_list->IdxBuffer.Size;
         }
+        ImGui_ImplVulkan_BuildDrawBatches(draw_data, idx_dst, fb_width, fb_height);
         VkMappedMemoryRange range[2] = {};
         range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
         range[0].memory = rb->VertexBufferMemory;
@@ -378,65 +498,39 @@ void ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer comm
         vkUnmapMemory(v->Device, rb->VertexBufferMemory);
         vkUnmapMemory(v->Device, rb->IndexBufferMemory);
     }
+    else
+    {
+        // No vertices: we still need to call user callbacks
+        ImGui_ImplVulkan_BuildDrawBatches(draw_data, NULL, fb_width, fb_height);
+    }
 
     // Setup desired Vulkan state
     ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
 
-    // Will project scissor/clipping rectangles into framebuffer space
-    ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
-    ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
-
-    // Render command lists
-    // (Because we merged all buffers into a single one, we maintain our own offset into them)
-    int global_vtx_offset = 0;
-    int global_idx_offset = 0;
-    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    // Render batches
+    const VkRect2D* last_scissor = NULL;
+    for (int batch_n = 0; batch_n < g_DrawBatches.Size; batch_n++)
     {
-        const ImDrawList* cmd_list = draw_data->CmdLists[n];
-        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        const ImGui_ImplVulkan_DrawBatch* batch = &g_DrawBatches[batch_n];
+        if (batch->Cmd != NULL)
         {
-            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
-            if (pcmd->UserCallback != NULL)
-            {
-                // User callback, registered via ImDrawList::AddCallback()
-                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
-                if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
-                    ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
-                else
-                    pcmd->UserCallback(cmd_list, pcmd);
-            }
+            // User callback, registered via ImDrawList::AddCallback()
+            // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+            if (batch->Cmd->UserCallback == ImDrawCallback_ResetRenderState)
+                ImGui_ImplVulkan_SetupRenderState(draw_data, pipeline, command_buffer, rb, fb_width, fb_height);
             else
-            {
-                // Project scissor/clipping rectangles into framebuffer space
-                ImVec4 clip_rect;
-                clip_rect.x = (pcmd->ClipRect.x - clip_off.x) * clip_scale.x;
-                clip_rect.y = (pcmd->ClipRect.y - clip_off.y) * clip_scale.y;
-                clip_rect.z = (pcmd->ClipRect.z - clip_off.x) * clip_scale.x;
-                clip_rect.w = (pcmd->ClipRect.w - clip_off.y) * clip_scale.y;
-
-                if (clip_rect.x < fb_width && clip_rect.y < fb_height && clip_rect.z >= 0.0f && clip_rect.w >= 0.0f)
-                {
-                    // Negative offsets are illegal for vkCmdSetScissor
-                    if (clip_rect.x < 0.0f)
-                        clip_rect.x = 0.0f;
-                    if (clip_rect.y < 0.0f)
-                        clip_rect.y = 0.0f;
-
-                    // Apply scissor/clipping rectangle
-                    VkRect2D scissor;
-                    scissor.offset.x = (int32_t)(clip_rect.x);
-                    scissor.offset.y = (int32_t)(clip_rect.y);
-                    scissor.extent.width = (uint32_t)(clip_rect.z - clip_rect.x);
-                    scissor.extent.height = (uint32_t)(clip_rect.w - clip_rect.y);
-                    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
-
-                    // Draw
-                    vkCmdDrawIndexed(command_buffer, pcmd->ElemCount, 1, pcmd->IdxOffset + global_idx_offset, pcmd->VtxOffset + global_vtx_offset, 0);
-                }
-            }
+                batch->Cmd->UserCallback(batch->CmdList, batch->Cmd);
+            last_scissor = NULL;
+            continue;
         }
-        global_idx_offset += cmd_list->IdxBuffer.Size;
-        global_vtx_offset += cmd_list->VtxBuffer.Size;
+
+        // Apply scissor/clipping rectangle, unless unchanged (consecutive batches differing only by base vertex)
+        if (last_scissor == NULL || memcmp(last_scissor, &batch->Scissor, sizeof(VkRect2D)) != 0)
+            vkCmdSetScissor(command_buffer, 0, 1, &batch->Scissor);
+        last_scissor = &batch->Scissor;
+
+        // Draw
+        vkCmdDrawIndexed(command_buffer, batch->ElemCount, 1, batch->IdxOffset, batch->VtxOffset, 0);
     }
 }
 
@@ -588,10 +682,108 @@ bool ImGui_ImplVulkan_CreateFontsTexture(VkCommandBuffer command_buffer)
 
     // Store our identifier
     io.Fonts->TexID = (ImTextureID)(intptr_t)g_FontImage;
+    io.Fonts->ClearTexDirtyRects();
 
     return true;
 }
 
+void ImGui_ImplVulkan_UpdateFontsTexture(VkCommandBuffer command_buffer)
+{
+    ImGui_ImplVulkan_InitInfo* v = &g_VulkanInitInfo;
+    ImGuiIO& io = ImGui::GetIO();
+    ImFontAtlas* atlas = io.Fonts;
+    if (g_FontImage == VK_NULL_HANDLE || atlas->TexDirtyRects.Size == 0)
+        return;
+    if (!atlas->IsBuilt()) // CPU pixel data was cleared: nothing to upload from
+    {
+        atlas->ClearTexDirtyRects();
+        return;
+    }
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    // Use the upload buffer of the frame about to be rendered by ImGui_ImplVulkan_RenderDrawData(),
+    // so we don't overwrite data which may still be read by a frame in flight.
+    ImGui_ImplVulkanH_WindowRenderBuffers* wrb = ImGui_ImplVulkan_GetWindowRenderBuffers();
+    ImGui_ImplVulkanH_FrameRenderBuffers* rb = &wrb->FrameRenderBuffers[(wrb->Index + 1) % wrb->Count];
+    size_t upload_size = 0;
+    for (int n = 0; n < atlas->TexDirtyRects.Size; n++)
+        upload_size += (size_t)atlas->TexDirtyRects[n].Width * atlas->TexDirtyRects[n].Height * 4;
+    if (rb->FontUploadBuffer == VK_NULL_HANDLE || rb->FontUploadBufferSize < upload_size)
+        CreateOrResizeBuffer(rb->FontUploadBuffer, rb->FontUploadBufferMemory, rb->FontUploadBufferSize, upload_size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT);
+
+    // Upload to Buffer: pack modified regions one after another, one copy region each
+    ImVector<VkBufferImageCopy> regions;
+    regions.resize(atlas->TexDirtyRects.Size);
+    {
+        unsigned char* map = NULL;
+        VkResult err = vkMapMemory(v->Device, rb->FontUploadBufferMemory, 0, upload_size, 0, (void**)(&map));
+        check_vk_result(err);
+        size_t offset = 0;
+        for (int n = 0; n < atlas->TexDirtyRects.Size; n++)
+        {
+            const ImFontAtlasRect& r = atlas->TexDirtyRects[n];
+            const size_t row_size = (size_t)r.Width * 4;
+            for (int y = 0; y < r.Height; y++)
+                memcpy(map + offset + y * row_size, pixels + ((size_t)(r.Y + y) * width + r.X) * 4, row_size);
+
+            VkBufferImageCopy& region = regions[n];
+            memset(&region, 0, sizeof(region));
+            region.bufferOffset = offset;
+            region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+            region.imageSubresource.layerCount = 1;
+            region.imageOffset.x = r.X;
+            region.imageOffset.y = r.Y;
+            region.imageExtent.width = r.Width;
+            region.imageExtent.height = r.Height;
+            region.imageExtent.depth = 1;
+            offset += row_size * r.Height;
+        }
+        VkMappedMemoryRange range[1] = {};
+        range[0].sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range[0].memory = rb->FontUploadBufferMemory;
+        range[0].size = VK_WHOLE_SIZE;
+        err = vkFlushMappedMemoryRanges(v->Device, 1, range);
+        check_vk_result(err);
+        vkUnmapMemory(v->Device, rb->FontUploadBufferMemory);
+    }
+    atlas->ClearTexDirtyRects();
+
+    // Copy to Image:
+    {
+        VkImageMemoryBarrier copy_barrier[1] = {};
+        copy_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        copy_barrier[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        copy_barrier[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        copy_barrier[0].oldLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        copy_barrier[0].newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        copy_barrier[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        copy_barrier[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        copy_barrier[0].image = g_FontImage;
+        copy_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy_barrier[0].subresourceRange.levelCount = 1;
+        copy_barrier[0].subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, NULL, 0, NULL, 1, copy_barrier);
+
+        vkCmdCopyBufferToImage(command_buffer, rb->FontUploadBuffer, g_FontImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, (uint32_t)regions.Size, regions.Data);
+
+        VkImageMemoryBarrier use_barrier[1] = {};
+        use_barrier[0].sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        use_barrier[0].srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        use_barrier[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        use_barrier[0].oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+        use_barrier[0].newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+        use_barrier[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        use_barrier[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        use_barrier[0].image = g_FontImage;
+        use_barrier[0].subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        use_barrier[0].subresourceRange.levelCount = 1;
+        use_barrier[0].subresourceRange.layerCount = 1;
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, NULL, 0, NULL, 1, use_barrier);
+    }
+}
+
 static void ImGui_ImplVulkan_CreateShaderModules(VkDevice device, const VkAllocationCallbacks* allocator)
 {
     // Create the shader modules
@@ -884,6 +1076,7 @@ void    ImGui_ImplVulkan_DestroyDeviceObjects()
     if (g_DescriptorSetLayout)  { vkDestroyDescriptorSetLayout(v->Device, g_DescriptorSetLayout, v->Allocator); g_DescriptorSetLayout = VK_NULL_HANDLE; }
     if (g_PipelineLayout)       { vkDestroyPipelineLayout(v->Device, g_PipelineLayout, v->Allocator); g_PipelineLayout = VK_NULL_HANDLE; }
     if (g_Pipeline)             { vkDestroyPipeline(v->Device, g_Pipeline, v->Allocator); g_Pipeline = VK_NULL_HANDLE; }
+    g_DrawBatches.clear();
 }
 
 bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info, VkRenderPass render_pass)
@@ -892,6 +1085,8 @@ bool    ImGui_ImplVulkan_Init(ImGui_ImplVulkan_InitInfo* info, VkRenderPass rend
     ImGuiIO& io = ImGui::GetIO();
     io.BackendRendererName = "imgui_impl_vulkan";
     io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;  // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    if (info->UseTexUpdates)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // The app uploads io.Fonts->TexDirtyRects[] with ImGui_ImplVulkan_UpdateFontsTexture(), allowing for ImFontAtlasFlags_DynamicGlyphs.
 
     IM_ASSERT(info->Instance != VK_NULL_HANDLE);
     IM_ASSERT(info->PhysicalDevice != VK_NULL_HANDLE);
@@ -1299,8 +1494,11 @@ void ImGui_ImplVulkanH_DestroyFrameRenderBuffers(VkDevice device, ImGui_ImplVulk
     if (buffers->VertexBufferMemory) { vkFreeMemory(device, buffers->VertexBufferMemory, allocator); buffers->VertexBufferMemory = VK_NULL_HANDLE; }
     if (buffers->IndexBuffer) { vkDestroyBuffer(device, buffers->IndexBuffer, allocator); buffers->IndexBuffer = VK_NULL_HANDLE; }
     if (buffers->IndexBufferMemory) { vkFreeMemory(device, buffers->IndexBufferMemory, allocator); buffers->IndexBufferMemory = VK_NULL_HANDLE; }
+    if (buffers->FontUploadBuffer) { vkDestroyBuffer(device, buffers->FontUploadBuffer, allocator); buffers->FontUploadBuffer = VK_NULL_HANDLE; }
+    if (buffers->FontUploadBufferMemory) { vkFreeMemory(device, buffers->FontUploadBufferMemory, allocator); buffers->FontUploadBufferMemory = VK_NULL_HANDLE; }
     buffers->VertexBufferSize = 0;
     buffers->IndexBufferSize = 0;
+    buffers->FontUploadBufferSize = 0;
 }
 
 void ImGui_ImplVulkanH_DestroyWindowRenderBuffers(VkDevice device, ImGui_ImplVulkanH_WindowRenderBuffers* buffers, const VkAllocationCallbacks* allocator)
@@ -3,6 +3,7 @@
 
 // Implemented features:
 //  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Incremental font atlas texture updates (ImGuiBackendFlags_RendererHasTexUpdates). Opt-in with InitInfo::UseTexUpdates, then call ImGui_ImplVulkan_UpdateFontsTexture() outside of the render pass.
 // Missing features:
 //  [ ] Renderer: User texture binding. Changes of ImTextureID aren't supported by this backend! See https://github.com/ocornut/imgui/pull/914
 
@@ -41,6 +42,7 @@ struct ImGui_ImplVulkan_InitInfo
     VkSampleCountFlagBits        MSAASamples;   // >= VK_SAMPLE_COUNT_1_BIT
     const VkAllocationCallbacks* Allocator;
     void                (*CheckVkResultFn)(VkResult err);
+    bool                UseTexUpdates;          // Set to true if you call ImGui_ImplVulkan_UpdateFontsTexture() every frame: enables ImGuiBackendFlags_RendererHasTexUpdates (required by ImFontAtlasFlags_DynamicGlyphs)
 };
 
 // Called by user code
@@ -50,6 +52,7 @@ IMGUI_IMPL_API void     ImGui_ImplVulkan_NewFrame();
 IMGUI_IMPL_API void     ImGui_ImplVulkan_RenderDrawData(ImDrawData* draw_data, VkCommandBuffer command_buffer, VkPipeline pipeline = VK_NULL_HANDLE);
 IMGUI_IMPL_API bool     ImGui_ImplVulkan_CreateFontsTexture(VkCommandBuffer command_buffer);
 IMGUI_IMPL_API void     ImGui_ImplVulkan_DestroyFontUploadObjects();
+IMGUI_IMPL_API void     ImGui_ImplVulkan_UpdateFontsTexture(VkCommandBuffer command_buffer); // Upload io.Fonts->TexDirtyRects[]. Requires InitInfo::UseTexUpdates. Call every frame before beginning the render pass in which ImGui_ImplVulkan_RenderDrawData() is called.
 IMGUI_IMPL_API void     ImGui_ImplVulkan_SetMinImageCount(uint32_t min_image_count); // To override MinImageCount after initialization (e.g. if swap chain is recreated)
 
 
@@ -0,0 +1,1135 @@
+// dear imgui: "null" benchmark application
+// (compile and link imgui, create context, run headless with NO INPUTS, NO GRAPHICS OUTPUT, report timings)
+// This runs a set of scenes (demo window + synthetic stress scenes) for a fixed number of frames and reports
+// per-phase CPU timings (NewFrame, widget submission, EndFrame, Render), vertex/index counts and allocations.
+// Output is CSV (default) or JSON so it can be tracked by continuous integration on a machine without a GPU.
+// Use '-softraster' to also render every frame with the CPU rasterizer backend (imgui_impl_softraster), and '-snapshot FILE'
+// to write its last frame as a .ppm image.
+//
+// Usage: example_null_benchmark [-json] [-frames N] [-warmup N] [-scene NAME] [-o FILE] [-defer-tessellation] [-threads N] [-font FILE] [-dynamic-glyphs] [-atlas-cache FILE] [-text-layout-cache BYTES] [-merge-draw-data] [-softraster] [-snapshot FILE] [-storage] [-hash] [-log] [-filter] [-filter-typing] [-memory]
+
+#include "imgui.h"
+#include "imgui_internal.h"     // ImHashStr(), for -hash
+#include "imgui_impl_softraster.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Helpers
+//-----------------------------------------------------------------------------
+
+static double GetTimeInMs()
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double, std::milli> >(steady_clock::now().time_since_epoch()).count();
+}
+
+// Count every allocation going through ImGui::MemAlloc() so we can report allocations per frame
+// (atomic as font atlas build jobs allocate from worker threads when using -threads)
+static std::atomic<int> g_AllocCount(0);
+static void* CountingMalloc(size_t sz, void* user_data) { IM_UNUSED(user_data); g_AllocCount++; return malloc(sz); }
+static void  CountingFree(void* ptr, void* user_data)   { IM_UNUSED(user_data); free(ptr); }
+
+// Minimal io.ParallelForFn / ImFontAtlas::ParallelForFn implementation: spawn worker threads which pull jobs from a shared counter.
+// (a real application would use its own persistent job system instead of creating threads every call)
+static int g_ThreadsCount = 1;
+static void ParallelFor(void* user_data, ImGuiJobFn job_fn, void* job_user_data, int jobs_count)
+{
+    IM_UNUSED(user_data);
+    std::atomic<int> next_job(0);
+    auto worker = [&]() { for (int job_n = next_job++; job_n < jobs_count; job_n = next_job++) job_fn(job_user_data, job_n); };
+    std::vector<std::thread> threads;
+    for (int n = 1; n < g_ThreadsCount && n < jobs_count; n++)
+        threads.push_back(std::thread(worker));
+    worker();
+    for (size_t n = 0; n < threads.size(); n++)
+        threads[n].join();
+}
+
+// Optional font loaded with every glyph it contains, to measure atlas building cost (with or without ImFontAtlasFlags_DynamicGlyphs)
+static const char* g_FontFilename = NULL;
+static bool g_DynamicGlyphs = false;
+static const char* g_AtlasCacheFilename = NULL; // Load the atlas from this file if valid, otherwise build it and save it there
+static bool g_MergeDrawData = false;            // Enable io.ConfigDrawDataMerge
+static int g_TextLayoutCacheSize = -1;          // Override io.ConfigMemoryTextLayoutCacheSize (0 to disable the cache)
+static bool g_SoftRaster = false;               // Render every frame with imgui_impl_softraster
+static const char* g_SnapshotFilename = NULL;   // Write the last frame rendered by imgui_impl_softraster to this file (.ppm)
+
+// Fill the whole display with a single window, so stress scenes are not hidden by clipping decisions based on window size
+static void BeginFullscreenWindow(const char* name)
+{
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings);
+}
+
+//-----------------------------------------------------------------------------
+// Scenes
+//-----------------------------------------------------------------------------
+
+static void SceneDemo()
+{
+    ImGui::ShowDemoWindow(NULL);
+    ImGui::ShowMetricsWindow(NULL);
+}
+
+static void SceneText10k()
+{
+    BeginFullscreenWindow("Text 10k");
+    for (int n = 0; n < 10000; n++)
+        ImGui::Text("Line %05d: The quick brown fox jumps over the lazy dog.", n);
+    ImGui::End();
+}
+
+static void SceneButtons5k()
+{
+    BeginFullscreenWindow("Buttons 5k");
+    for (int n = 0; n < 5000; n++)
+    {
+        ImGui::PushID(n);
+        ImGui::Button("Button");
+        if ((n % 20) != 19)
+            ImGui::SameLine();
+        ImGui::PopID();
+    }
+    ImGui::End();
+}
+
+static void SubmitTreeNodes(int depth, int max_depth, int breadth)
+{
+    for (int n = 0; n < breadth; n++)
+    {
+        ImGui::SetNextItemOpen(true, ImGuiCond_Always);
+        if (!ImGui::TreeNode((void*)(intptr_t)n, "Node %d (depth %d)", n, depth))
+            continue;
+        if (depth + 1 < max_depth)
+            SubmitTreeNodes(depth + 1, max_depth, breadth);
+        else
+            ImGui::BulletText("Leaf");
+        ImGui::TreePop();
+    }
+}
+
+static void SceneTreeDeep()
+{
+    BeginFullscreenWindow("Tree Deep");
+    SubmitTreeNodes(0, 8, 3);
+    ImGui::End();
+}
+
+static void SceneInputTextHuge()
+{
+    static char* buf = NULL;
+    static size_t buf_size = 0;
+    if (buf == NULL)
+    {
+        // ~1 MB of text spread over ~20k lines, allocated once and intentionally kept for the lifetime of the application
+        const int lines_count = 20000;
+        buf_size = (size_t)lines_count * 64 + 1;
+        buf = (char*)malloc(buf_size);
+        char* p = buf;
+        for (int n = 0; n < lines_count; n++)
+            p += sprintf(p, "%05d: Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n", n);
+    }
+    BeginFullscreenWindow("InputText Huge");
+    ImGui::InputTextMultiline("##huge", buf, buf_size, ImVec2(-FLT_MIN, -FLT_MIN));
+    ImGui::End();
+}
+
+// Same ~1 MB of text, focused and being typed into at the top: one character inserted every frame
+static void ShowInputTextEdit(ImGuiInputTextFlags flags)
+{
+    static ImVector<char> buf;
+    if (ImGui::GetFrameCount() == 1)
+    {
+        const int lines_count = 20000;
+        buf.resize(lines_count * 64 + 64 * 1024);
+        char* p = buf.Data;
+        for (int n = 0; n < lines_count; n++)
+            p += sprintf(p, "%05d: Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n", n);
+    }
+    BeginFullscreenWindow("InputText Edit");
+    if (ImGui::GetFrameCount() == 1)
+        ImGui::SetKeyboardFocusHere();
+    else
+        ImGui::GetIO().AddInputCharacter((unsigned int)('a' + ImGui::GetFrameCount() % 26));
+    ImGui::InputTextMultiline("##edit", buf.Data, (size_t)buf.Size, ImVec2(-FLT_MIN, -FLT_MIN), flags);
+    ImGui::End();
+}
+
+static void SceneInputTextEdit()        { ShowInputTextEdit(ImGuiInputTextFlags_None); }
+static void SceneInputTextEditLarge()   { ShowInputTextEdit(ImGuiInputTextFlags_LargeBuffer); }
+
+// ~7 MB of text over 100k lines, focused and scrolled down by a page every other frame
+static void ShowInputTextScroll(ImGuiInputTextFlags flags)
+{
+    static ImVector<char> buf;
+    ImGuiIO& io = ImGui::GetIO();
+    if (ImGui::GetFrameCount() == 1)
+    {
+        const int lines_count = 100000;
+        buf.resize(lines_count * 72 + 1);
+        char* p = buf.Data;
+        for (int n = 0; n < lines_count; n++)
+            p += sprintf(p, "%06d: Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n", n);
+        io.KeyMap[ImGuiKey_PageDown] = ImGuiKey_PageDown;
+    }
+    io.KeysDown[ImGuiKey_PageDown] = (ImGui::GetFrameCount() & 1) != 0;
+    BeginFullscreenWindow("InputText Scroll");
+    if (ImGui::GetFrameCount() == 1)
+        ImGui::SetKeyboardFocusHere();
+    ImGui::InputTextMultiline("##scroll", buf.Data, (size_t)buf.Size, ImVec2(-FLT_MIN, -FLT_MIN), flags);
+    ImGui::End();
+}
+
+static void SceneInputTextScroll100k()      { ShowInputTextScroll(ImGuiInputTextFlags_None); }
+static void SceneInputTextScroll100kLarge() { ShowInputTextScroll(ImGuiInputTextFlags_LargeBuffer); }
+
+// Many windows each drawing long polylines and filled shapes, tessellation-heavy
+static void ShowDashboardWindows(ImGuiWindowFlags extra_flags)
+{
+    const int windows_count = 40;
+    const int points_count = 2000;
+    static ImVec2 points[points_count];
+    for (int window_n = 0; window_n < windows_count; window_n++)
+    {
+        char name[32];
+        sprintf(name, "Plot %02d", window_n);
+        ImGui::SetNextWindowPos(ImVec2((float)(window_n % 8) * 240.0f, (float)(window_n / 8) * 216.0f));
+        ImGui::SetNextWindowSize(ImVec2(240.0f, 216.0f));
+        ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings | extra_flags);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const ImVec2 p = ImGui::GetCursorScreenPos();
+        for (int n = 0; n < points_count; n++)
+            points[n] = ImVec2(p.x + n * 0.1f, p.y + 80.0f + sinf(n * 0.05f + window_n) * 60.0f);
+        draw_list->AddPolyline(points, points_count, IM_COL32(255, 200, 0, 255), false, 1.0f);
+        draw_list->AddPolyline(points, points_count, IM_COL32(0, 200, 255, 255), false, 2.5f);
+        for (int n = 0; n < 20; n++)
+            draw_list->AddCircleFilled(ImVec2(p.x + 10.0f + n * 10.0f, p.y + 170.0f), 4.0f, IM_COL32(255, 0, 255, 255));
+        ImGui::End();
+    }
+}
+
+static void SceneDashboard40()
+{
+    ShowDashboardWindows(ImGuiWindowFlags_None);
+}
+
+// Same windows with static contents using ImGuiWindowFlags_RetainDrawList: drawing commands are only hashed
+static void SceneRetained40()
+{
+    ShowDashboardWindows(ImGuiWindowFlags_RetainDrawList);
+}
+
+// Text using 3000 different codepoints (U+0100 to U+0CB7).
+// Run with '-font FILE' to use a font covering them, and '-dynamic-glyphs' to rasterize them on demand.
+static void SceneUnicode3k()
+{
+    BeginFullscreenWindow("Unicode");
+    char line[50 * 3 + 1];
+    for (int line_n = 0; line_n < 60; line_n++)
+    {
+        char* p = line;
+        for (int n = 0; n < 50; n++)
+        {
+            const unsigned int c = 0x0100 + line_n * 50 + n; // Encode as UTF-8 (2 or 3 bytes)
+            if (c < 0x800) { *p++ = (char)(0xC0 + (c >> 6)); }
+            else           { *p++ = (char)(0xE0 + (c >> 12)); *p++ = (char)(0x80 + ((c >> 6) & 0x3F)); }
+            *p++ = (char)(0x80 + (c & 0x3F));
+        }
+        *p = 0;
+        ImGui::TextUnformatted(line, p);
+    }
+    ImGui::End();
+}
+
+// Word-wrapped paragraphs of ASCII and CJK text (measured every frame even when clipped), stressing UTF-8 decoding and text measurement.
+static void SceneTextWrapped2k()
+{
+    static const char lorem_text[] = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod. ";
+    static char ascii_text[(sizeof(lorem_text) - 1) * 8 + 1];
+    static char cjk_text[100 * 3 + 1];
+    if (ascii_text[0] == 0)
+    {
+        for (int n = 0; n < 8; n++)
+            memcpy(ascii_text + (sizeof(lorem_text) - 1) * n, lorem_text, sizeof(lorem_text));
+        char* p = cjk_text;
+        for (int n = 0; n < 100; n++)
+        {
+            const unsigned int c = 0x4E00 + n * 37; // CJK Unified Ideographs, encoded as 3 bytes UTF-8
+            *p++ = (char)(0xE0 + (c >> 12));
+            *p++ = (char)(0x80 + ((c >> 6) & 0x3F));
+            *p++ = (char)(0x80 + (c & 0x3F));
+        }
+        *p = 0;
+    }
+    BeginFullscreenWindow("Text Wrapped");
+    for (int n = 0; n < 1000; n++)
+    {
+        ImGui::TextWrapped("%s", ascii_text);
+        ImGui::TextWrapped("%s", cjk_text);
+    }
+    ImGui::End();
+}
+
+// A 1M rows log of word-wrapped entries of variable heights, clipped with ImGuiListClipperHeights, scrolling every frame.
+static void SceneClipperVariable1M()
+{
+    static ImGuiListClipperHeights heights;
+    BeginFullscreenWindow("Clipper Variable");
+    heights.Resize(1000000);
+    ImGui::SetScrollY(ImGui::GetScrollMaxY() * (float)((ImGui::GetFrameCount() * 7919) % 1000) / 1000.0f);
+    ImGuiListClipper clipper;
+    clipper.BeginWithHeights(&heights);
+    while (clipper.Step())
+        for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            ImGui::TextWrapped("[%07d] Lorem ipsum dolor sit amet, consectetur adipiscing elit.%s", n,
+                (n % 3 == 0) ? " Sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris nisi ut aliquip ex ea commodo consequat. Duis aute irure dolor in reprehenderit in voluptate velit esse cillum dolore eu fugiat nulla pariatur." : "");
+    ImGui::End();
+}
+
+// A ~32 MB log (500k lines) displayed with TextUnformatted() and scrolled every frame, with 10 lines appended every frame
+static void SceneTextLog32MB()
+{
+    static ImGuiTextBuffer buf;
+    if (ImGui::GetFrameCount() == 1)
+    {
+        buf.clear();
+        buf.reserve(500000 * 64 + 64 * 1024);
+        for (int n = 0; n < 500000; n++)
+            buf.appendf("[%07d] Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n", n);
+    }
+    for (int n = 0; n < 10; n++)
+        buf.appendf("[frame %05d] Sed do eiusmod tempor incididunt ut labore et dolore.\n", ImGui::GetFrameCount());
+    BeginFullscreenWindow("Text Log");
+    ImGui::SetScrollY(ImGui::GetScrollMaxY() * (float)((ImGui::GetFrameCount() * 7919) % 1000) / 1000.0f);
+    ImGui::TextUnformatted(buf.begin(), buf.end());
+    ImGui::End();
+}
+
+// Very long polylines exercising every AddPolyline() code path (textured, non-thick and thick anti-aliased lines)
+// Build with 'make WITH_SIMD=0' (defines IMGUI_DISABLE_SIMD) to compare with the scalar code paths.
+static void ScenePolylines100k()
+{
+    const int points_count = 10000; // Keep each polyline under 64K vertices (16-bit indices)
+    static ImVec2 points[points_count];
+    BeginFullscreenWindow("Polylines");
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 p = ImGui::GetCursorScreenPos();
+    const float thickness[] = { 1.0f, 1.5f, 2.5f };
+    for (int line_n = 0; line_n < 10; line_n++)
+    {
+        for (int n = 0; n < points_count; n++)
+            points[n] = ImVec2(p.x + n * 0.19f, p.y + 50.0f + line_n * 100.0f + sinf(n * 0.02f + line_n) * 40.0f);
+        draw_list->AddPolyline(points, points_count, IM_COL32(255, 200, line_n * 20, 255), false, thickness[line_n % IM_ARRAYSIZE(thickness)]);
+    }
+    ImGui::End();
+}
+
+struct BenchmarkScene
+{
+    const char* Name;
+    void        (*Func)();
+};
+
+static const BenchmarkScene g_Scenes[] =
+{
+    { "demo",            SceneDemo },
+    { "text_10k",        SceneText10k },
+    { "buttons_5k",      SceneButtons5k },
+    { "tree_deep",       SceneTreeDeep },
+    { "inputtext_huge",  SceneInputTextHuge },
+    { "inputtext_edit",  SceneInputTextEdit },
+    { "inputtext_edit_large", SceneInputTextEditLarge },
+    { "inputtext_scroll_100k", SceneInputTextScroll100k },
+    { "inputtext_scroll_100k_large", SceneInputTextScroll100kLarge },
+    { "dashboard_40",    SceneDashboard40 },
+    { "retained_40",     SceneRetained40 },
+    { "polylines_100k",  ScenePolylines100k },
+    { "unicode_3k",      SceneUnicode3k },
+    { "text_wrapped_2k", SceneTextWrapped2k },
+    { "clipper_variable_1m", SceneClipperVariable1M },
+    { "text_log_32mb",   SceneTextLog32MB },
+};
+
+//-----------------------------------------------------------------------------
+// Runner
+//-----------------------------------------------------------------------------
+
+struct BenchmarkResult
+{
+    const char* Name;
+    int         Frames;
+    double      AtlasMs;            // Time to build the font atlas
+    double      NewFrameMs;         // Averages per frame
+    double      SubmitMs;
+    double      EndFrameMs;
+    double      RenderMs;
+    double      RasterMs;           // ImGui_ImplSoftRaster_RenderDrawData() (with -softraster), not included in FrameMs
+    double      FrameMs;
+    double      FrameMsMin;
+    double      FrameMsMax;
+    int         VtxCount;           // Values for the last frame
+    int         IdxCount;
+    int         DrawLists;
+    int         DrawCmds;
+    int         ActiveAllocations;
+    double      AllocsPerFrame;
+    size_t      MemTagLiveBytes[ImGuiMemTag_COUNT]; // Live allocations per category for the last frame (build with WITH_MEMORY_TAGS=1)
+    int         MemTagLiveCount[ImGuiMemTag_COUNT];
+};
+
+// Write pixels as a binary .ppm image (alpha is dropped)
+static void WriteSnapshot(const char* filename, const ImU32* pixels, int width, int height)
+{
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Cannot write '%s'\n", filename);
+        return;
+    }
+    fprintf(f, "P6\n%d %d\n255\n", width, height);
+    for (int n = 0; n < width * height; n++)
+    {
+        const unsigned char rgb[3] = { (unsigned char)(pixels[n] >> IM_COL32_R_SHIFT), (unsigned char)(pixels[n] >> IM_COL32_G_SHIFT), (unsigned char)(pixels[n] >> IM_COL32_B_SHIFT) };
+        fwrite(rgb, 1, 3, f);
+    }
+    fclose(f);
+}
+
+static void RunScene(const BenchmarkScene& scene, int warmup_frames, int frames, bool defer_tessellation, BenchmarkResult* out)
+{
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset; // Like most renderer backends, allow draw lists with more than 64K vertices
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasTexUpdates; // Pretend to upload io.Fonts->TexDirtyRects[] (required by ImFontAtlasFlags_DynamicGlyphs)
+    io.ConfigDrawListsDeferTessellation = defer_tessellation;
+    io.ConfigDrawDataMerge = g_MergeDrawData;
+    if (g_TextLayoutCacheSize >= 0)
+        io.ConfigMemoryTextLayoutCacheSize = g_TextLayoutCacheSize;
+    if (g_ThreadsCount > 1)
+    {
+        io.ParallelForFn = ParallelFor;
+        io.Fonts->ParallelForFn = ParallelFor;
+    }
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+
+    // Build atlas
+    if (g_FontFilename != NULL)
+    {
+        static const ImWchar ranges[] = { 0x0020, 0xFFFF, 0 }; // Every glyph available in the font
+        io.Fonts->AddFontFromFileTTF(g_FontFilename, 16.0f, NULL, ranges);
+    }
+    if (g_DynamicGlyphs)
+        io.Fonts->Flags |= ImFontAtlasFlags_DynamicGlyphs;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    const double atlas_t0 = GetTimeInMs();
+    if (io.Fonts->ConfigData.Size == 0)
+        io.Fonts->AddFontDefault(); // Otherwise done by GetTexDataAsRGBA32(), but the cache needs the fonts to be added first
+    if (g_AtlasCacheFilename != NULL && !io.Fonts->LoadBuildCacheFromFile(g_AtlasCacheFilename))
+    {
+        io.Fonts->Build();
+        io.Fonts->SaveBuildCacheToFile(g_AtlasCacheFilename);
+    }
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ImVector<ImU32> framebuffer;
+    if (g_SoftRaster)
+    {
+        ImGui_ImplSoftRaster_Init();
+        ImGui_ImplSoftRaster_CreateFontsTexture();
+        framebuffer.resize((int)io.DisplaySize.x * (int)io.DisplaySize.y);
+    }
+
+    memset(out, 0, sizeof(*out));
+    out->AtlasMs = GetTimeInMs() - atlas_t0;
+    out->Name = scene.Name;
+    out->Frames = frames;
+    out->FrameMsMin = 1e30;
+    int alloc_count_start = 0;
+    for (int n = 0; n < warmup_frames + frames; n++)
+    {
+        const bool measured = (n >= warmup_frames);
+        if (n == warmup_frames)
+            alloc_count_start = g_AllocCount;
+
+        const double t0 = GetTimeInMs();
+        ImGui::NewFrame();
+        const double t1 = GetTimeInMs();
+        scene.Func();
+        const double t2 = GetTimeInMs();
+        ImGui::EndFrame();
+        const double t3 = GetTimeInMs();
+        ImGui::Render();
+        const double t4 = GetTimeInMs();
+        if (g_SoftRaster)
+        {
+            for (int pixel_n = 0; pixel_n < framebuffer.Size; pixel_n++)
+                framebuffer[pixel_n] = IM_COL32(115, 140, 153, 255);
+            ImGui_ImplSoftRaster_RenderDrawData(ImGui::GetDrawData(), framebuffer.Data, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
+        }
+        else
+        {
+            io.Fonts->ClearTexDirtyRects(); // A renderer backend would upload the modified regions of the texture here
+        }
+        const double t5 = GetTimeInMs();
+
+        if (!measured)
+            continue;
+        out->NewFrameMs += t1 - t0;
+        out->SubmitMs += t2 - t1;
+        out->EndFrameMs += t3 - t2;
+        out->RenderMs += t4 - t3;
+        out->RasterMs += t5 - t4;
+        out->FrameMs += t4 - t0;
+        if (t4 - t0 < out->FrameMsMin) out->FrameMsMin = t4 - t0;
+        if (t4 - t0 > out->FrameMsMax) out->FrameMsMax = t4 - t0;
+    }
+
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    out->VtxCount = draw_data->TotalVtxCount;
+    out->IdxCount = draw_data->TotalIdxCount;
+    out->DrawLists = draw_data->CmdListsCount;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+        out->DrawCmds += draw_data->CmdLists[n]->CmdBuffer.Size;
+    out->ActiveAllocations = io.MetricsActiveAllocations;
+    for (int tag = 0; tag < ImGuiMemTag_COUNT; tag++)
+        if (const ImGuiMemTagStats* stats = ImGui::GetMemTagStats(tag))
+        {
+            out->MemTagLiveBytes[tag] = stats->LiveBytes;
+            out->MemTagLiveCount[tag] = stats->LiveCount;
+        }
+
+    const double inv_frames = (frames > 0) ? 1.0 / frames : 0.0;
+    out->AllocsPerFrame = (g_AllocCount - alloc_count_start) * inv_frames;
+    out->NewFrameMs *= inv_frames;
+    out->SubmitMs *= inv_frames;
+    out->EndFrameMs *= inv_frames;
+    out->RenderMs *= inv_frames;
+    out->RasterMs *= inv_frames;
+    out->FrameMs *= inv_frames;
+    if (frames == 0)
+        out->FrameMsMin = 0.0;
+
+    if (g_SoftRaster)
+    {
+        if (g_SnapshotFilename != NULL)
+            WriteSnapshot(g_SnapshotFilename, framebuffer.Data, (int)io.DisplaySize.x, (int)io.DisplaySize.y);
+        ImGui_ImplSoftRaster_Shutdown();
+        framebuffer.clear();
+    }
+    ImGui::DestroyContext();
+}
+
+//-----------------------------------------------------------------------------
+// ImGuiStorage micro-benchmark (-storage)
+// Build with WITH_HASHED_STORAGE=1 to measure the IMGUI_USE_HASHED_STORAGE implementation.
+//-----------------------------------------------------------------------------
+
+struct StorageBenchmarkResult
+{
+    int         KeysCount;
+    double      BuildMs;            // Add all keys to Data[] then call BuildSortByKey()
+    double      InsertNs;           // Average SetInt() of a new key into a storage holding KeysCount keys
+    double      LookupNs;           // Average GetInt() of an existing key
+    double      LookupMissNs;       // Average GetInt() of a missing key
+};
+
+static ImGuiID StorageBenchmarkKey(ImU32 n)
+{
+    // Spread keys like ImHashStr() output would (odd multiplier: unique keys for unique n)
+    return (n + 1) * 0x9E3779B1u;
+}
+
+static void RunStorageBenchmark(int keys_count, StorageBenchmarkResult* out)
+{
+    const int inserts_count = 1000;
+    const int lookups_count = 1000000;
+    ImGuiStorage storage;
+    volatile ImU32 sink = 0;
+
+    double t0 = GetTimeInMs();
+    storage.Data.reserve(keys_count + inserts_count);
+    for (int n = 0; n < keys_count; n++)
+        storage.Data.push_back(ImGuiStorage::ImGuiStoragePair(StorageBenchmarkKey((ImU32)n), n));
+    storage.BuildSortByKey();
+    double t1 = GetTimeInMs();
+    out->KeysCount = keys_count;
+    out->BuildMs = t1 - t0;
+
+    ImU32 seed = 1234;
+    t0 = GetTimeInMs();
+    for (int n = 0; n < lookups_count; n++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        sink += (ImU32)storage.GetInt(StorageBenchmarkKey((seed >> 8) % (ImU32)keys_count), -1);
+    }
+    t1 = GetTimeInMs();
+    out->LookupNs = (t1 - t0) * 1e6 / lookups_count;
+
+    t0 = GetTimeInMs();
+    for (int n = 0; n < lookups_count; n++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        sink += (ImU32)storage.GetInt(StorageBenchmarkKey((ImU32)keys_count + inserts_count + (seed >> 8)), -1);
+    }
+    t1 = GetTimeInMs();
+    out->LookupMissNs = (t1 - t0) * 1e6 / lookups_count;
+
+    t0 = GetTimeInMs();
+    for (int n = 0; n < inserts_count; n++)
+        storage.SetInt(StorageBenchmarkKey((ImU32)(keys_count + n)), n);
+    t1 = GetTimeInMs();
+    out->InsertNs = (t1 - t0) * 1e6 / inserts_count;
+    IM_ASSERT(storage.Data.Size == keys_count + inserts_count);
+}
+
+static void OutputStorageResults(FILE* f, const StorageBenchmarkResult* results, int results_count, bool output_json)
+{
+#ifdef IMGUI_USE_HASHED_STORAGE
+    const char* impl = "hashed";
+#else
+    const char* impl = "sorted";
+#endif
+    if (output_json)
+        fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"storage\": \"%s\",\n  \"results\": [\n", IMGUI_VERSION, impl);
+    else
+        fprintf(f, "storage,keys,build_ms,insert_ns,lookup_ns,lookup_miss_ns\n");
+    for (int n = 0; n < results_count; n++)
+    {
+        const StorageBenchmarkResult& r = results[n];
+        if (output_json)
+            fprintf(f, "    { \"keys\": %d, \"build_ms\": %.4f, \"insert_ns\": %.1f, \"lookup_ns\": %.1f, \"lookup_miss_ns\": %.1f }%s\n",
+                r.KeysCount, r.BuildMs, r.InsertNs, r.LookupNs, r.LookupMissNs, (n + 1 < results_count) ? "," : "");
+        else
+            fprintf(f, "%s,%d,%.4f,%.1f,%.1f,%.1f\n", impl, r.KeysCount, r.BuildMs, r.InsertNs, r.LookupNs, r.LookupMissNs);
+    }
+    if (output_json)
+        fprintf(f, "  ]\n}\n");
+}
+
+//-----------------------------------------------------------------------------
+// ID hashing benchmark (-hash)
+// Build with WITH_CRC32C_HASH=1 to measure the IMGUI_USE_CRC32C_HASH implementation.
+//-----------------------------------------------------------------------------
+
+struct HashBenchmarkResult
+{
+    const char* Name;
+    int         LabelsCount;
+    double      AvgLength;
+    double      NsPerId;            // Average ImHashStr() time, with a seed like GetID() inside a window
+    double      MBPerSec;
+    int         Collisions;         // Number of labels whose ID is equal to the ID of another label of the set
+    double      ExpectedCollisions; // Same for an ideal 32-bit hash
+};
+
+// Realistic label sets: all labels of a set are distinct, so any identical ID is a collision
+static int FormatHashBenchmarkLabel(int set_n, int n, char* buf, int buf_size)
+{
+    switch (set_n)
+    {
+    case 0:  return ImFormatString(buf, buf_size, "Button %d", n);
+    case 1:  return ImFormatString(buf, buf_size, "Enable feature##option_%d_%d", n % 97, n / 97);
+    case 2:  return ImFormatString(buf, buf_size, "Window %d###window_%d", n % 10, n);
+    default: return ImFormatString(buf, buf_size, "assets/textures/characters/hero_%04d/diffuse_%d.png", n / 8, n % 8);
+    }
+}
+
+static int IMGUI_CDECL CompareIDs(const void* lhs, const void* rhs)
+{
+    const ImGuiID a = *(const ImGuiID*)lhs, b = *(const ImGuiID*)rhs;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+static void RunHashBenchmark(int set_n, int labels_count, HashBenchmarkResult* out)
+{
+    static const char* names[] = { "short", "hidden_id", "triple_hash", "path" };
+    ImVector<char> buf;
+    ImVector<int> offsets;
+    char label[128];
+    for (int n = 0; n < labels_count; n++)
+    {
+        const int len = FormatHashBenchmarkLabel(set_n, n, label, IM_ARRAYSIZE(label));
+        offsets.push_back(buf.Size);
+        buf.resize(buf.Size + len + 1);
+        memcpy(buf.Data + offsets.back(), label, (size_t)len + 1);
+    }
+
+    const ImGuiID seed = ImHashStr("Dear ImGui Demo");
+    ImVector<ImGuiID> ids;
+    ids.resize(labels_count);
+    const int repeat_count = 10;
+    const double t0 = GetTimeInMs();
+    for (int repeat_n = 0; repeat_n < repeat_count; repeat_n++)
+        for (int n = 0; n < labels_count; n++)
+            ids[n] = ImHashStr(buf.Data + offsets[n], 0, seed);
+    const double t1 = GetTimeInMs();
+
+    ImQsort(ids.Data, (size_t)ids.Size, sizeof(ImGuiID), CompareIDs);
+    int collisions = 0;
+    for (int n = 1; n < ids.Size; n++)
+        if (ids[n] == ids[n - 1])
+            collisions++;
+
+    out->Name = names[set_n];
+    out->LabelsCount = labels_count;
+    out->AvgLength = (double)(buf.Size - labels_count) / labels_count;
+    out->NsPerId = (t1 - t0) * 1e6 / ((double)labels_count * repeat_count);
+    out->MBPerSec = (double)(buf.Size - labels_count) * repeat_count / ((t1 - t0) * 1e-3) / (1024.0 * 1024.0);
+    out->Collisions = collisions;
+    out->ExpectedCollisions = (double)labels_count * (labels_count - 1) / 2.0 / 4294967296.0;
+}
+
+static void OutputHashResults(FILE* f, const HashBenchmarkResult* results, int results_count, bool output_json)
+{
+#if !defined(IMGUI_USE_CRC32C_HASH)
+    const char* impl = "crc32";
+#elif defined(IMGUI_ENABLE_SSE4_2_CRC)
+    const char* impl = "crc32c_sse4.2";
+#elif defined(IMGUI_ENABLE_ARM_CRC)
+    const char* impl = "crc32c_arm";
+#else
+    const char* impl = "crc32c_table";
+#endif
+    if (output_json)
+        fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"hash\": \"%s\",\n  \"results\": [\n", IMGUI_VERSION, impl);
+    else
+        fprintf(f, "hash,labels,count,avg_length,ns_per_id,mb_per_s,collisions,expected_collisions\n");
+    for (int n = 0; n < results_count; n++)
+    {
+        const HashBenchmarkResult& r = results[n];
+        if (output_json)
+            fprintf(f, "    { \"labels\": \"%s\", \"count\": %d, \"avg_length\": %.1f, \"ns_per_id\": %.2f, \"mb_per_s\": %.1f, \"collisions\": %d, \"expected_collisions\": %.1f }%s\n",
+                r.Name, r.LabelsCount, r.AvgLength, r.NsPerId, r.MBPerSec, r.Collisions, r.ExpectedCollisions, (n + 1 < results_count) ? "," : "");
+        else
+            fprintf(f, "%s,%s,%d,%.1f,%.2f,%.1f,%d,%.1f\n", impl, r.Name, r.LabelsCount, r.AvgLength, r.NsPerId, r.MBPerSec, r.Collisions, r.ExpectedCollisions);
+    }
+    if (output_json)
+        fprintf(f, "  ]\n}\n");
+}
+
+//-----------------------------------------------------------------------------
+// Log appending benchmark (-log)
+// Compare ImGuiTextBuffer + line offsets (like the ExampleAppLog demo used to) with ImGuiTextLineBuffer.
+//-----------------------------------------------------------------------------
+
+struct LogBenchmarkResult
+{
+    const char* Name;
+    int         LinesCount;
+    double      NsPerLine;          // Average appendf() of a line, including line offsets bookkeeping
+    double      LinesPerSec;
+    int         LinesKept;
+};
+
+static void RunLogBenchmark(int variant_n, int lines_count, LogBenchmarkResult* out)
+{
+    static const char* names[] = { "text_buffer", "line_buffer", "line_buffer_ring_100k" };
+    double t0 = 0.0, t1 = 0.0;
+    int lines_kept = 0;
+    if (variant_n == 0)
+    {
+        ImGuiTextBuffer buf;
+        ImVector<int> line_offsets;
+        line_offsets.push_back(0);
+        t0 = GetTimeInMs();
+        for (int n = 0; n < lines_count; n++)
+        {
+            int old_size = buf.size();
+            buf.appendf("[%07d] [info] Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n", n);
+            for (int new_size = buf.size(); old_size < new_size; old_size++)
+                if (buf[old_size] == '\n')
+                    line_offsets.push_back(old_size + 1);
+        }
+        t1 = GetTimeInMs();
+        lines_kept = line_offsets.Size - 1;
+    }
+    else
+    {
+        ImGuiTextLineBuffer buf(64 * 1024, (variant_n == 2) ? 100000 : 0);
+        t0 = GetTimeInMs();
+        for (int n = 0; n < lines_count; n++)
+            buf.appendf("[%07d] [info] Lorem ipsum dolor sit amet, consectetur adipiscing elit.\n", n);
+        t1 = GetTimeInMs();
+        lines_kept = buf.size();
+    }
+    out->Name = names[variant_n];
+    out->LinesCount = lines_count;
+    out->NsPerLine = (t1 - t0) * 1e6 / lines_count;
+    out->LinesPerSec = lines_count / ((t1 - t0) * 1e-3);
+    out->LinesKept = lines_kept;
+}
+
+static void OutputLogResults(FILE* f, const LogBenchmarkResult* results, int results_count, bool output_json)
+{
+    if (output_json)
+        fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"results\": [\n", IMGUI_VERSION);
+    else
+        fprintf(f, "log,lines,ns_per_line,lines_per_s,lines_kept\n");
+    for (int n = 0; n < results_count; n++)
+    {
+        const LogBenchmarkResult& r = results[n];
+        if (output_json)
+            fprintf(f, "    { \"log\": \"%s\", \"lines\": %d, \"ns_per_line\": %.1f, \"lines_per_s\": %.0f, \"lines_kept\": %d }%s\n",
+                r.Name, r.LinesCount, r.NsPerLine, r.LinesPerSec, r.LinesKept, (n + 1 < results_count) ? "," : "");
+        else
+            fprintf(f, "%s,%d,%.1f,%.0f,%d\n", r.Name, r.LinesCount, r.NsPerLine, r.LinesPerSec, r.LinesKept);
+    }
+    if (output_json)
+        fprintf(f, "  ]\n}\n");
+}
+
+//-----------------------------------------------------------------------------
+// Text filter benchmark (-filter)
+// Filter 500k log lines with ImGuiTextFilter::PassFilter() one line at a time, then with PassFilterLines() (use -threads N to split it into jobs).
+// Build with 'make WITH_SIMD=0' (defines IMGUI_DISABLE_SIMD) to measure the scalar ImStristr().
+//-----------------------------------------------------------------------------
+
+struct FilterBenchmarkResult
+{
+    const char* Filter;
+    int         LinesCount;
+    int         PassCount;
+    double      PassFilterMs;       // Average time to call PassFilter() on every line
+    double      PassFilterLinesMs;  // Average time of a PassFilterLines() call on every line
+};
+
+static void RunFilterBenchmark(const ImGuiTextLineBuffer& log, const char* filter_text, FilterBenchmarkResult* out)
+{
+    const int repeat_count = 5;
+    ImGuiTextFilter filter(filter_text);
+    ImVector<ImU32> bits;
+    bits.resize((log.size() + 31) / 32);
+    volatile ImU32 sink = 0;
+
+    double t0 = GetTimeInMs();
+    int pass_count = 0;
+    for (int repeat_n = 0; repeat_n < repeat_count; repeat_n++)
+    {
+        pass_count = 0;
+        for (int line_n = 0; line_n < log.size(); line_n++)
+            if (filter.PassFilter(log[line_n].Begin, log[line_n].End))
+                pass_count++;
+        sink += (ImU32)pass_count;
+    }
+    double t1 = GetTimeInMs();
+    out->PassFilterMs = (t1 - t0) / repeat_count;
+
+    t0 = GetTimeInMs();
+    for (int repeat_n = 0; repeat_n < repeat_count; repeat_n++)
+        sink += (ImU32)filter.PassFilterLines(&log[0].Begin, log.size(), bits.Data, (int)sizeof(ImGuiTextLineBuffer::Line));
+    t1 = GetTimeInMs();
+    out->PassFilterLinesMs = (t1 - t0) / repeat_count;
+    out->Filter = filter_text;
+    out->LinesCount = log.size();
+    out->PassCount = pass_count;
+    IM_ASSERT(filter.PassFilterLines(&log[0].Begin, log.size(), bits.Data, (int)sizeof(ImGuiTextLineBuffer::Line)) == pass_count);
+}
+
+static void RunFilterBenchmarks(FilterBenchmarkResult* results, int results_count)
+{
+    static const char* filters[] = { "dolor", "[error]", "warn,error", "-info", "CONSECTETUR,-[0" };
+    IM_ASSERT(results_count == IM_ARRAYSIZE(filters));
+    ImGui::CreateContext();
+    if (g_ThreadsCount > 1)
+        ImGui::GetIO().ParallelForFn = ParallelFor;
+    ImGuiTextLineBuffer log;
+    static const char* levels[] = { "info", "info", "info", "warning", "error" };
+    for (int n = 0; n < 500000; n++)
+        log.appendf("[%07d] [%s] Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor %d.\n", n, levels[n % 5], (n % 1000) * 7919);
+    for (int n = 0; n < results_count; n++)
+        RunFilterBenchmark(log, filters[n], &results[n]);
+    ImGui::DestroyContext();
+}
+
+static void OutputFilterResults(FILE* f, const FilterBenchmarkResult* results, int results_count, bool output_json)
+{
+#if defined(IMGUI_ENABLE_SSE2)
+    const char* impl = "sse2";
+#elif defined(IMGUI_ENABLE_NEON)
+    const char* impl = "neon";
+#else
+    const char* impl = "scalar";
+#endif
+    if (output_json)
+        fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"stristr\": \"%s\",\n  \"threads\": %d,\n  \"results\": [\n", IMGUI_VERSION, impl, g_ThreadsCount);
+    else
+        fprintf(f, "stristr,threads,filter,lines,pass,pass_filter_ms,pass_filter_lines_ms\n");
+    for (int n = 0; n < results_count; n++)
+    {
+        const FilterBenchmarkResult& r = results[n];
+        if (output_json)
+            fprintf(f, "    { \"filter\": \"%s\", \"lines\": %d, \"pass\": %d, \"pass_filter_ms\": %.3f, \"pass_filter_lines_ms\": %.3f }%s\n",
+                r.Filter, r.LinesCount, r.PassCount, r.PassFilterMs, r.PassFilterLinesMs, (n + 1 < results_count) ? "," : "");
+        else
+            fprintf(f, "%s,%d,\"%s\",%d,%d,%.3f,%.3f\n", impl, g_ThreadsCount, r.Filter, r.LinesCount, r.PassCount, r.PassFilterMs, r.PassFilterLinesMs);
+    }
+    if (output_json)
+        fprintf(f, "  ]\n}\n");
+}
+
+//-----------------------------------------------------------------------------
+// Incremental text filter benchmark (-filter-typing)
+// Type a filter one character at a time over 1M log lines, comparing PassFilterLines() on every line with
+// PassFilterLinesCached() which only tests the previous matches again when the filter is narrowed.
+//-----------------------------------------------------------------------------
+
+struct FilterTypingBenchmarkResult
+{
+    char        Input[32];
+    int         PassCount;
+    double      PassFilterLinesMs;  // Time of a PassFilterLines() call on every line
+    double      CachedMs;           // Time of a PassFilterLinesCached() call following the previous keystroke
+};
+
+static const char* g_FilterTypingInput = "tempor 7919";
+
+static void RunFilterTypingBenchmark(FilterTypingBenchmarkResult* results, int results_count)
+{
+    IM_ASSERT(results_count == (int)strlen(g_FilterTypingInput));
+    ImGui::CreateContext();
+    if (g_ThreadsCount > 1)
+        ImGui::GetIO().ParallelForFn = ParallelFor;
+    ImGuiTextLineBuffer log;
+    static const char* levels[] = { "info", "info", "info", "warning", "error" };
+    for (int n = 0; n < 1000000; n++)
+        log.appendf("[%07d] [%s] Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor %d.\n", n, levels[n % 5], (n % 1000) * 7919);
+    const char* const* lines = &log[0].Begin;
+    const int stride = (int)sizeof(ImGuiTextLineBuffer::Line);
+
+    ImGuiTextFilter filter;
+    ImGuiTextFilter filter_cached;
+    ImVector<ImU32> bits;
+    bits.resize((log.size() + 31) / 32);
+    for (int n = 0; n < results_count; n++)
+    {
+        FilterTypingBenchmarkResult& r = results[n];
+        ImStrncpy(r.Input, g_FilterTypingInput, (size_t)n + 2);
+        ImStrncpy(filter.InputBuf, r.Input, IM_ARRAYSIZE(filter.InputBuf));
+        ImStrncpy(filter_cached.InputBuf, r.Input, IM_ARRAYSIZE(filter_cached.InputBuf));
+        filter.Build();
+        filter_cached.Build();
+
+        double t0 = GetTimeInMs();
+        r.PassCount = filter.PassFilterLines(lines, log.size(), bits.Data, stride);
+        double t1 = GetTimeInMs();
+        r.PassFilterLinesMs = t1 - t0;
+
+        t0 = GetTimeInMs();
+        const ImVector<int>& matches = filter_cached.PassFilterLinesCached(lines, log.size(), stride);
+        t1 = GetTimeInMs();
+        r.CachedMs = t1 - t0;
+        IM_ASSERT(matches.Size == r.PassCount);
+    }
+    ImGui::DestroyContext();
+}
+
+static void OutputFilterTypingResults(FILE* f, const FilterTypingBenchmarkResult* results, int results_count, bool output_json)
+{
+    if (output_json)
+        fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"threads\": %d,\n  \"results\": [\n", IMGUI_VERSION, g_ThreadsCount);
+    else
+        fprintf(f, "threads,input,pass,pass_filter_lines_ms,cached_ms\n");
+    for (int n = 0; n < results_count; n++)
+    {
+        const FilterTypingBenchmarkResult& r = results[n];
+        if (output_json)
+            fprintf(f, "    { \"input\": \"%s\", \"pass\": %d, \"pass_filter_lines_ms\": %.3f, \"cached_ms\": %.3f }%s\n",
+                r.Input, r.PassCount, r.PassFilterLinesMs, r.CachedMs, (n + 1 < results_count) ? "," : "");
+        else
+            fprintf(f, "%d,\"%s\",%d,%.3f,%.3f\n", g_ThreadsCount, r.Input, r.PassCount, r.PassFilterLinesMs, r.CachedMs);
+    }
+    if (output_json)
+        fprintf(f, "  ]\n}\n");
+}
+
+static void OutputCSV(FILE* f, const BenchmarkResult* results, int results_count)
+{
+    fprintf(f, "scene,frames,newframe_ms,submit_ms,endframe_ms,render_ms,frame_ms,frame_ms_min,frame_ms_max,vtx_count,idx_count,draw_lists,draw_cmds,active_allocations,allocs_per_frame,atlas_ms,raster_ms\n");
+    for (int n = 0; n < results_count; n++)
+    {
+        const BenchmarkResult& r = results[n];
+        fprintf(f, "%s,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%d,%d,%.1f,%.4f,%.4f\n",
+            r.Name, r.Frames, r.NewFrameMs, r.SubmitMs, r.EndFrameMs, r.RenderMs, r.FrameMs, r.FrameMsMin, r.FrameMsMax,
+            r.VtxCount, r.IdxCount, r.DrawLists, r.DrawCmds, r.ActiveAllocations, r.AllocsPerFrame, r.AtlasMs, r.RasterMs);
+    }
+}
+
+static void OutputJSON(FILE* f, const BenchmarkResult* results, int results_count)
+{
+#if defined(IMGUI_DISABLE_SIMD)
+    const char* simd = "none";
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    const char* simd = "sse2";
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    const char* simd = "neon";
+#else
+    const char* simd = "none";
+#endif
+    fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"simd\": \"%s\",\n  \"scenes\": [\n", IMGUI_VERSION, simd);
+    for (int n = 0; n < results_count; n++)
+    {
+        const BenchmarkResult& r = results[n];
+        fprintf(f, "    { \"scene\": \"%s\", \"frames\": %d, \"newframe_ms\": %.4f, \"submit_ms\": %.4f, \"endframe_ms\": %.4f, \"render_ms\": %.4f, "
+            "\"frame_ms\": %.4f, \"frame_ms_min\": %.4f, \"frame_ms_max\": %.4f, \"vtx_count\": %d, \"idx_count\": %d, \"draw_lists\": %d, "
+            "\"draw_cmds\": %d, \"active_allocations\": %d, \"allocs_per_frame\": %.1f, \"atlas_ms\": %.4f, \"raster_ms\": %.4f }%s\n",
+            r.Name, r.Frames, r.NewFrameMs, r.SubmitMs, r.EndFrameMs, r.RenderMs, r.FrameMs, r.FrameMsMin, r.FrameMsMax,
+            r.VtxCount, r.IdxCount, r.DrawLists, r.DrawCmds, r.ActiveAllocations, r.AllocsPerFrame, r.AtlasMs, r.RasterMs, (n + 1 < results_count) ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+}
+
+// Live memory per allocation category at the end of each scene (-memory)
+static void OutputMemory(FILE* f, const BenchmarkResult* results, int results_count, bool output_json)
+{
+    if (output_json)
+        fprintf(f, "{\n  \"imgui_version\": \"%s\",\n  \"memory\": [\n", IMGUI_VERSION);
+    else
+        fprintf(f, "scene,tag,live_bytes,live_allocs\n");
+    for (int n = 0; n < results_count; n++)
+        for (int tag = 0; tag < ImGuiMemTag_COUNT; tag++)
+        {
+            const BenchmarkResult& r = results[n];
+            if (output_json)
+                fprintf(f, "    { \"scene\": \"%s\", \"tag\": \"%s\", \"live_bytes\": %d, \"live_allocs\": %d }%s\n",
+                    r.Name, ImGui::GetMemTagName(tag), (int)r.MemTagLiveBytes[tag], r.MemTagLiveCount[tag], (n + 1 < results_count || tag + 1 < ImGuiMemTag_COUNT) ? "," : "");
+            else
+                fprintf(f, "%s,%s,%d,%d\n", r.Name, ImGui::GetMemTagName(tag), (int)r.MemTagLiveBytes[tag], r.MemTagLiveCount[tag]);
+        }
+    if (output_json)
+        fprintf(f, "  ]\n}\n");
+}
+
+int main(int argc, char** argv)
+{
+    bool output_json = false;
+    int frames = 100;
+    int warmup_frames = 10;
+    const char* scene_filter = NULL;
+    const char* output_filename = NULL;
+    bool defer_tessellation = false;
+    bool storage_benchmark = false;
+    bool hash_benchmark = false;
+    bool log_benchmark = false;
+    bool filter_benchmark = false;
+    bool filter_typing_benchmark = false;
+    bool output_memory = false;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "-json") == 0)                      { output_json = true; }
+        else if (strcmp(argv[n], "-frames") == 0 && n + 1 < argc) { frames = atoi(argv[++n]); }
+        else if (strcmp(argv[n], "-warmup") == 0 && n + 1 < argc) { warmup_frames = atoi(argv[++n]); }
+        else if (strcmp(argv[n], "-scene") == 0 && n + 1 < argc)  { scene_filter = argv[++n]; }
+        else if (strcmp(argv[n], "-o") == 0 && n + 1 < argc)      { output_filename = argv[++n]; }
+        else if (strcmp(argv[n], "-defer-tessellation") == 0)   { defer_tessellation = true; }
+        else if (strcmp(argv[n], "-threads") == 0 && n + 1 < argc) { g_ThreadsCount = atoi(argv[++n]); }
+        else if (strcmp(argv[n], "-font") == 0 && n + 1 < argc)   { g_FontFilename = argv[++n]; }
+        else if (strcmp(argv[n], "-dynamic-glyphs") == 0)       { g_DynamicGlyphs = true; }
+        else if (strcmp(argv[n], "-atlas-cache") == 0 && n + 1 < argc) { g_AtlasCacheFilename = argv[++n]; }
+        else if (strcmp(argv[n], "-text-layout-cache") == 0 && n + 1 < argc) { g_TextLayoutCacheSize = atoi(argv[++n]); }
+        else if (strcmp(argv[n], "-merge-draw-data") == 0)      { g_MergeDrawData = true; }
+        else if (strcmp(argv[n], "-softraster") == 0)           { g_SoftRaster = true; }
+        else if (strcmp(argv[n], "-snapshot") == 0 && n + 1 < argc) { g_SnapshotFilename = argv[++n]; }
+        else if (strcmp(argv[n], "-storage") == 0)              { storage_benchmark = true; }
+        else if (strcmp(argv[n], "-hash") == 0)                 { hash_benchmark = true; }
+        else if (strcmp(argv[n], "-log") == 0)                  { log_benchmark = true; }
+        else if (strcmp(argv[n], "-filter") == 0)               { filter_benchmark = true; }
+        else if (strcmp(argv[n], "-filter-typing") == 0)        { filter_typing_benchmark = true; }
+        else if (strcmp(argv[n], "-memory") == 0)               { output_memory = true; }
+        else
+        {
+            fprintf(stderr, "Usage: %s [-json] [-frames N] [-warmup N] [-scene NAME] [-o FILE] [-defer-tessellation] [-threads N] [-font FILE] [-dynamic-glyphs] [-atlas-cache FILE] [-text-layout-cache BYTES] [-merge-draw-data] [-softraster] [-snapshot FILE] [-storage] [-hash] [-log] [-filter] [-filter-typing] [-memory]\nScenes:", argv[0]);
+            for (int scene_n = 0; scene_n < IM_ARRAYSIZE(g_Scenes); scene_n++)
+                fprintf(stderr, " %s", g_Scenes[scene_n].Name);
+            fprintf(stderr, "\n");
+            return 1;
+        }
+    }
+
+    if (output_memory && ImGui::GetMemTagStats(ImGuiMemTag_Misc) == NULL)
+    {
+        fprintf(stderr, "-memory requires building with WITH_MEMORY_TAGS=1 (IMGUI_ENABLE_MEMORY_TAGS)\n");
+        return 1;
+    }
+
+    IMGUI_CHECKVERSION();
+    ImGui::SetAllocatorFunctions(CountingMalloc, CountingFree, NULL);
+
+    static const int storage_keys_counts[] = { 1000, 100000, 1000000 };
+    StorageBenchmarkResult storage_results[IM_ARRAYSIZE(storage_keys_counts)];
+    HashBenchmarkResult hash_results[4];
+    LogBenchmarkResult log_results[3];
+    FilterBenchmarkResult filter_results[5];
+    FilterTypingBenchmarkResult filter_typing_results[11];
+    BenchmarkResult results[IM_ARRAYSIZE(g_Scenes)];
+    int results_count = 0;
+    if (storage_benchmark)
+    {
+        for (int n = 0; n < IM_ARRAYSIZE(storage_keys_counts); n++)
+            RunStorageBenchmark(storage_keys_counts[n], &storage_results[n]);
+    }
+    else if (hash_benchmark)
+    {
+        for (int n = 0; n < IM_ARRAYSIZE(hash_results); n++)
+            RunHashBenchmark(n, 1000000, &hash_results[n]);
+    }
+    else if (log_benchmark)
+    {
+        for (int n = 0; n < IM_ARRAYSIZE(log_results); n++)
+            RunLogBenchmark(n, 2000000, &log_results[n]);
+    }
+    else if (filter_benchmark)
+    {
+        RunFilterBenchmarks(filter_results, IM_ARRAYSIZE(filter_results));
+    }
+    else if (filter_typing_benchmark)
+    {
+        RunFilterTypingBenchmark(filter_typing_results, IM_ARRAYSIZE(filter_typing_results));
+    }
+    else
+    {
+        for (int scene_n = 0; scene_n < IM_ARRAYSIZE(g_Scenes); scene_n++)
+            if (scene_filter == NULL || strcmp(scene_filter, g_Scenes[scene_n].Name) == 0)
+                RunScene(g_Scenes[scene_n], warmup_frames, frames, defer_tessellation, &results[results_count++]);
+        if (results_count == 0)
+        {
+            fprintf(stderr, "Unknown scene '%s'\n", scene_filter);
+            return 1;
+        }
+    }
+
+    FILE* f = output_filename ? fopen(output_filename, "wb") : stdout;
+    if (f == NULL)
+    {
+        fprintf(stderr, "Cannot open '%s' for writing\n", output_filename);
+        return 1;
+    }
+    if (storage_benchmark)
+        OutputStorageResults(f, storage_results, IM_ARRAYSIZE(storage_results), output_json);
+    else if (hash_benchmark)
+        OutputHashResults(f, hash_results, IM_ARRAYSIZE(hash_results), output_json);
+    else if (log_benchmark)
+        OutputLogResults(f, log_results, IM_ARRAYSIZE(log_results), output_json);
+    else if (filter_benchmark)
+        OutputFilterResults(f, filter_results, IM_ARRAYSIZE(filter_results), output_json);
+    else if (filter_typing_benchmark)
+        OutputFilterTypingResults(f, filter_typing_results, IM_ARRAYSIZE(filter_typing_results), output_json);
+    else if (output_memory)
+        OutputMemory(f, results, results_count, output_json);
+    else if (output_json)
+        OutputJSON(f, results, results_count);
+    else
+        OutputCSV(f, results, results_count);
+    if (f != stdout)
+        fclose(f);
+    return 0;
+}
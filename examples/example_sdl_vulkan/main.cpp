@@ -269,6 +269,10 @@ static void FrameRender(ImGui_ImplVulkanH_Window* wd, ImDrawData* draw_data)
         err = vkBeginCommandBuffer(fd->CommandBuffer, &info);
         check_vk_result(err);
     }
+
+    // Upload modified regions of the font atlas (must be done outside of the render pass)
+    ImGui_ImplVulkan_UpdateFontsTexture(fd->CommandBuffer);
+
     {
         VkRenderPassBeginInfo info = {};
         info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
@@ -388,6 +392,7 @@ int main(int, char**)
     init_info.MinImageCount = g_MinImageCount;
     init_info.ImageCount = wd->ImageCount;
     init_info.CheckVkResultFn = check_vk_result;
+    init_info.UseTexUpdates = true; // We call ImGui_ImplVulkan_UpdateFontsTexture() in FrameRender()
     ImGui_ImplVulkan_Init(&init_info, wd->RenderPass);
 
     // Load Fonts
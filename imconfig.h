@@ -43,12 +43,29 @@
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 
+//---- Disable SSE2/NEON accelerated code paths (e.g. AddPolyline() tessellation). They are enabled by default when the compiler targets SSE2 or AArch64 NEON.
+// The SIMD paths produce exactly the same output as the scalar paths, this is mostly useful for comparing performances.
+//#define IMGUI_DISABLE_SIMD
+
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
 
 //---- Pack colors to BGRA8 instead of RGBA8 (to avoid converting from one to another)
 //#define IMGUI_USE_BGRA_PACKED_COLOR
 
+//---- Use an open-addressing hash table in ImGuiStorage (window state storage, tree nodes open state, pools) instead of a sorted array.
+// Insertions are O(1) instead of O(N), which helps with very large amounts of tree nodes or windows. Pairs in ImGuiStorage::Data[] are then not sorted.
+//#define IMGUI_USE_HASHED_STORAGE
+
+//---- Hash IDs with CRC32C instead of CRC32, using the SSE4.2 or ARMv8 CRC32 instructions when the compiler targets them (e.g. -msse4.2, -march=armv8-a+crc).
+// This makes ImHashStr()/ImHashData() (all PushID()/GetID() calls) several times faster on long labels. The "###" operator is still supported.
+// Note that this changes the value of every ID: .ini data storing IDs (e.g. tables settings) won't be matched anymore.
+//#define IMGUI_USE_CRC32C_HASH
+
+//---- Track memory allocations per category (windows, draw lists, fonts, settings, etc.), see ImGui::GetMemTagStats() and the Metrics window.
+// Every allocation made with IM_ALLOC()/ImGui::MemAlloc() is then prefixed with a 16 bytes header storing its size and category.
+//#define IMGUI_ENABLE_MEMORY_TAGS
+
 //---- Use 32-bit for ImWchar (default is 16-bit) to support unicode planes 1-16. (e.g. point beyond 0xFFFF like emoticons, dingbats, symbols, shapes, ancient languages, etc...)
 //#define IMGUI_USE_WCHAR32
 
@@ -60,8 +60,11 @@ CODE
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 // [SECTION] MISC HELPERS/UTILITIES (Color functions)
 // [SECTION] ImGuiStorage
+// [SECTION] ImGuiTextLayoutCache
+// [SECTION] ImGuiFrameArena
 // [SECTION] ImGuiTextFilter
 // [SECTION] ImGuiTextBuffer
+// [SECTION] ImGuiTextLineBuffer
 // [SECTION] ImGuiListClipper
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
@@ -823,6 +826,7 @@ static const float NAV_WINDOWING_LIST_APPEAR_DELAY          = 0.15f;    // Time
 static const float WINDOWS_RESIZE_FROM_EDGES_HALF_THICKNESS = 4.0f;     // Extend outside and inside windows. Affect FindHoveredWindow().
 static const float WINDOWS_RESIZE_FROM_EDGES_FEEDBACK_TIMER = 0.04f;    // Reduce visual noise by only highlighting the border after a certain time.
 static const float WINDOWS_MOUSE_WHEEL_SCROLL_LOCK_TIMER    = 2.00f;    // Lock scrolled window (so it doesn't pick child windows that are scrolling through) for a certain time, unless mouse moved.
+static const int   WINDOWS_RETAIN_DRAW_LIST_STABLE_BUILDS   = 3;        // With ImGuiWindowFlags_RetainDrawList: only hash drawing commands after this many consecutive full builds produced the same commands.
 
 //-------------------------------------------------------------------------
 // [SECTION] FORWARD DECLARATIONS
@@ -835,6 +839,7 @@ static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* wind
 
 static void             AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list);
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
+static void             UpdateWindowRetainedDrawList(ImGuiWindow* window);
 
 static ImRect           GetViewportRect();
 
@@ -919,10 +924,16 @@ static void*   MallocWrapper(size_t size, void* user_data)    { IM_UNUSED(user_d
 static void    FreeWrapper(void* ptr, void* user_data)        { IM_UNUSED(user_data); IM_UNUSED(ptr); IM_ASSERT(0); }
 #endif
 
-static void*  (*GImAllocatorAllocFunc)(size_t size, void* user_data) = MallocWrapper;
-static void   (*GImAllocatorFreeFunc)(void* ptr, void* user_data) = FreeWrapper;
+static ImGuiMemAllocFunc    GImAllocatorAllocFunc = MallocWrapper;
+static ImGuiMemFreeFunc     GImAllocatorFreeFunc = FreeWrapper;
 static void*    GImAllocatorUserData = NULL;
 
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+// Current category and per-category statistics of allocations (see IMGUI_ENABLE_MEMORY_TAGS). Global like the allocators since allocations may outlive a context.
+static ImGuiMemTag          GImMemTag = ImGuiMemTag_Misc;
+static ImGuiMemTagStats     GImMemTagStats[ImGuiMemTag_COUNT];
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] USER FACING STRUCTURES (ImGuiStyle, ImGuiIO)
 //-----------------------------------------------------------------------------
@@ -1039,6 +1050,10 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigMemoryTextLayoutCacheSize = 256 * 1024;
+    ConfigMemoryFrameArenaSize = 0;
+    ConfigDrawListsDeferTessellation = false;
+    ConfigDrawDataMerge = false;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -1048,6 +1063,8 @@ ImGuiIO::ImGuiIO()
     ClipboardUserData = NULL;
     ImeSetInputScreenPosFn = ImeSetInputScreenPosFn_DefaultImpl;
     ImeWindowHandle = NULL;
+    ParallelForFn = NULL;
+    ParallelForUserData = NULL;
 
     // Input (NB: we already have memset zero the entire structure!)
     MousePos = ImVec2(-FLT_MAX, -FLT_MAX);
@@ -1309,25 +1326,70 @@ const ImWchar* ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin)
     return buf_mid_line;
 }
 
+// Return true when the 'count' first characters of both strings are equal, ignoring the case of ASCII letters (count <= 0 returns true)
+static inline bool ImStrnicmpAscii(const char* str1, const char* str2, int count)
+{
+    for (int n = 0; n < count; n++)
+        if (ImToUpper(str1[n]) != ImToUpper(str2[n]))
+            return false;
+    return true;
+}
+
+// Candidate positions are found by comparing the first and the last character of the needle, 16 positions at a time with SIMD.
+// Only ASCII letters are folded (like toupper() with the default "C" locale), so UTF-8 sequences are never altered.
 const char* ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
 {
     if (!needle_end)
         needle_end = needle + strlen(needle);
+    if (!haystack_end)
+        haystack_end = haystack + strlen(haystack);
+    const int needle_len = (int)(needle_end - needle);
+    if (needle_len <= 0 || haystack_end - haystack < needle_len)
+        return NULL;
 
-    const char un0 = (char)toupper(*needle);
-    while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
-    {
-        if (toupper(*haystack) == un0)
-        {
-            const char* b = needle + 1;
-            for (const char* a = haystack + 1; b < needle_end; a++, b++)
-                if (toupper(*a) != toupper(*b))
-                    break;
-            if (b == needle_end)
-                return haystack;
-        }
-        haystack++;
+    const char* haystack_last = haystack_end - needle_len; // Last position where needle may start
+    const char un0 = ImToUpper(needle[0]);
+    const char unl = ImToUpper(needle_end[-1]);
+#if defined(IMGUI_ENABLE_SSE2)
+    const __m128i v_first = _mm_set1_epi8(un0);
+    const __m128i v_last = _mm_set1_epi8(unl);
+    const __m128i v_before_a = _mm_set1_epi8('a' - 1);
+    const __m128i v_after_z = _mm_set1_epi8('z' + 1);
+    const __m128i v_case = _mm_set1_epi8('a' - 'A');
+    for (; haystack_last - haystack >= 15; haystack += 16)
+    {
+        // As signed bytes, UTF-8 sequences bytes (0x80..0xFF) are below 'a' and are not folded
+        __m128i v_block_first = _mm_loadu_si128((const __m128i*)(const void*)haystack);
+        __m128i v_block_last = _mm_loadu_si128((const __m128i*)(const void*)(haystack + needle_len - 1));
+        v_block_first = _mm_sub_epi8(v_block_first, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(v_block_first, v_before_a), _mm_cmplt_epi8(v_block_first, v_after_z)), v_case));
+        v_block_last = _mm_sub_epi8(v_block_last, _mm_and_si128(_mm_and_si128(_mm_cmpgt_epi8(v_block_last, v_before_a), _mm_cmplt_epi8(v_block_last, v_after_z)), v_case));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(v_block_first, v_first), _mm_cmpeq_epi8(v_block_last, v_last)));
+        for (const char* candidate = haystack; mask != 0; candidate++, mask >>= 1)
+            if ((mask & 1) && ImStrnicmpAscii(candidate + 1, needle + 1, needle_len - 2))
+                return candidate;
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    const uint8x16_t v_first = vdupq_n_u8((uint8_t)un0);
+    const uint8x16_t v_last = vdupq_n_u8((uint8_t)unl);
+    const uint8x16_t v_before_a = vdupq_n_u8('a' - 1);
+    const uint8x16_t v_after_z = vdupq_n_u8('z' + 1);
+    const uint8x16_t v_case = vdupq_n_u8('a' - 'A');
+    for (; haystack_last - haystack >= 15; haystack += 16)
+    {
+        uint8x16_t v_block_first = vld1q_u8((const uint8_t*)haystack);
+        uint8x16_t v_block_last = vld1q_u8((const uint8_t*)(haystack + needle_len - 1));
+        v_block_first = vsubq_u8(v_block_first, vandq_u8(vandq_u8(vcgtq_u8(v_block_first, v_before_a), vcltq_u8(v_block_first, v_after_z)), v_case));
+        v_block_last = vsubq_u8(v_block_last, vandq_u8(vandq_u8(vcgtq_u8(v_block_last, v_before_a), vcltq_u8(v_block_last, v_after_z)), v_case));
+        const uint8x16_t v_match = vandq_u8(vceqq_u8(v_block_first, v_first), vceqq_u8(v_block_last, v_last));
+        ImU64 mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(v_match), 4)), 0); // 4 bits per position
+        for (const char* candidate = haystack; mask != 0; candidate++, mask >>= 4)
+            if ((mask & 1) && ImStrnicmpAscii(candidate + 1, needle + 1, needle_len - 2))
+                return candidate;
     }
+#endif
+    for (; haystack <= haystack_last; haystack++)
+        if (ImToUpper(haystack[0]) == un0 && ImToUpper(haystack[needle_len - 1]) == unl && ImStrnicmpAscii(haystack + 1, needle + 1, needle_len - 2))
+            return haystack;
     return NULL;
 }
 
@@ -1406,6 +1468,8 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS
 
+#ifndef IMGUI_USE_CRC32C_HASH
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -1431,7 +1495,7 @@ static const ImU32 GCrc32LookupTable[256] =
 
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements. (see IMGUI_USE_CRC32C_HASH)
 ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
 {
     ImU32 crc = ~seed;
@@ -1447,7 +1511,7 @@ ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
 // Because this syntax is rarely used we are optimizing for the common case.
 // - If we reach ### in the string we discard the hash so far and reset to the seed.
 // - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements. (see IMGUI_USE_CRC32C_HASH)
 ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
 {
     seed = ~seed;
@@ -1476,6 +1540,96 @@ ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     return ~crc;
 }
 
+#else // #ifndef IMGUI_USE_CRC32C_HASH
+
+// CRC32C (Castagnoli polynomial) is computed by the SSE4.2 and ARMv8 CRC32 instructions 8 bytes at a time.
+// Without them we use a lookup table, which outputs the same values (so IDs don't depend on the target CPU) but isn't faster than CRC32.
+#if !defined(IMGUI_ENABLE_SSE4_2_CRC) && !defined(IMGUI_ENABLE_ARM_CRC)
+static const ImU32 GCrc32cLookupTable[256] =
+{
+    0x00000000,0xF26B8303,0xE13B70F7,0x1350F3F4,0xC79A971F,0x35F1141C,0x26A1E7E8,0xD4CA64EB,0x8AD958CF,0x78B2DBCC,0x6BE22838,0x9989AB3B,0x4D43CFD0,0xBF284CD3,0xAC78BF27,0x5E133C24,
+    0x105EC76F,0xE235446C,0xF165B798,0x030E349B,0xD7C45070,0x25AFD373,0x36FF2087,0xC494A384,0x9A879FA0,0x68EC1CA3,0x7BBCEF57,0x89D76C54,0x5D1D08BF,0xAF768BBC,0xBC267848,0x4E4DFB4B,
+    0x20BD8EDE,0xD2D60DDD,0xC186FE29,0x33ED7D2A,0xE72719C1,0x154C9AC2,0x061C6936,0xF477EA35,0xAA64D611,0x580F5512,0x4B5FA6E6,0xB93425E5,0x6DFE410E,0x9F95C20D,0x8CC531F9,0x7EAEB2FA,
+    0x30E349B1,0xC288CAB2,0xD1D83946,0x23B3BA45,0xF779DEAE,0x05125DAD,0x1642AE59,0xE4292D5A,0xBA3A117E,0x4851927D,0x5B016189,0xA96AE28A,0x7DA08661,0x8FCB0562,0x9C9BF696,0x6EF07595,
+    0x417B1DBC,0xB3109EBF,0xA0406D4B,0x522BEE48,0x86E18AA3,0x748A09A0,0x67DAFA54,0x95B17957,0xCBA24573,0x39C9C670,0x2A993584,0xD8F2B687,0x0C38D26C,0xFE53516F,0xED03A29B,0x1F682198,
+    0x5125DAD3,0xA34E59D0,0xB01EAA24,0x42752927,0x96BF4DCC,0x64D4CECF,0x77843D3B,0x85EFBE38,0xDBFC821C,0x2997011F,0x3AC7F2EB,0xC8AC71E8,0x1C661503,0xEE0D9600,0xFD5D65F4,0x0F36E6F7,
+    0x61C69362,0x93AD1061,0x80FDE395,0x72966096,0xA65C047D,0x5437877E,0x4767748A,0xB50CF789,0xEB1FCBAD,0x197448AE,0x0A24BB5A,0xF84F3859,0x2C855CB2,0xDEEEDFB1,0xCDBE2C45,0x3FD5AF46,
+    0x7198540D,0x83F3D70E,0x90A324FA,0x62C8A7F9,0xB602C312,0x44694011,0x5739B3E5,0xA55230E6,0xFB410CC2,0x092A8FC1,0x1A7A7C35,0xE811FF36,0x3CDB9BDD,0xCEB018DE,0xDDE0EB2A,0x2F8B6829,
+    0x82F63B78,0x709DB87B,0x63CD4B8F,0x91A6C88C,0x456CAC67,0xB7072F64,0xA457DC90,0x563C5F93,0x082F63B7,0xFA44E0B4,0xE9141340,0x1B7F9043,0xCFB5F4A8,0x3DDE77AB,0x2E8E845F,0xDCE5075C,
+    0x92A8FC17,0x60C37F14,0x73938CE0,0x81F80FE3,0x55326B08,0xA759E80B,0xB4091BFF,0x466298FC,0x1871A4D8,0xEA1A27DB,0xF94AD42F,0x0B21572C,0xDFEB33C7,0x2D80B0C4,0x3ED04330,0xCCBBC033,
+    0xA24BB5A6,0x502036A5,0x4370C551,0xB11B4652,0x65D122B9,0x97BAA1BA,0x84EA524E,0x7681D14D,0x2892ED69,0xDAF96E6A,0xC9A99D9E,0x3BC21E9D,0xEF087A76,0x1D63F975,0x0E330A81,0xFC588982,
+    0xB21572C9,0x407EF1CA,0x532E023E,0xA145813D,0x758FE5D6,0x87E466D5,0x94B49521,0x66DF1622,0x38CC2A06,0xCAA7A905,0xD9F75AF1,0x2B9CD9F2,0xFF56BD19,0x0D3D3E1A,0x1E6DCDEE,0xEC064EED,
+    0xC38D26C4,0x31E6A5C7,0x22B65633,0xD0DDD530,0x0417B1DB,0xF67C32D8,0xE52CC12C,0x1747422F,0x49547E0B,0xBB3FFD08,0xA86F0EFC,0x5A048DFF,0x8ECEE914,0x7CA56A17,0x6FF599E3,0x9D9E1AE0,
+    0xD3D3E1AB,0x21B862A8,0x32E8915C,0xC083125F,0x144976B4,0xE622F5B7,0xF5720643,0x07198540,0x590AB964,0xAB613A67,0xB831C993,0x4A5A4A90,0x9E902E7B,0x6CFBAD78,0x7FAB5E8C,0x8DC0DD8F,
+    0xE330A81A,0x115B2B19,0x020BD8ED,0xF0605BEE,0x24AA3F05,0xD6C1BC06,0xC5914FF2,0x37FACCF1,0x69E9F0D5,0x9B8273D6,0x88D28022,0x7AB90321,0xAE7367CA,0x5C18E4C9,0x4F48173D,0xBD23943E,
+    0xF36E6F75,0x0105EC76,0x12551F82,0xE03E9C81,0x34F4F86A,0xC69F7B69,0xD5CF889D,0x27A40B9E,0x79B737BA,0x8BDCB4B9,0x988C474D,0x6AE7C44E,0xBE2DA0A5,0x4C4623A6,0x5F16D052,0xAD7D5351,
+};
+#endif
+
+static ImU32 ImCrc32c(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+#if defined(IMGUI_ENABLE_SSE4_2_CRC)
+#if defined(__x86_64__) || defined(_M_X64)
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = (ImU32)_mm_crc32_u64(crc, v);
+    }
+#endif
+    for (; data_size >= 4; data += 4, data_size -= 4)
+    {
+        ImU32 v;
+        memcpy(&v, data, 4);
+        crc = _mm_crc32_u32(crc, v);
+    }
+    while (data_size-- != 0)
+        crc = _mm_crc32_u8(crc, *data++);
+#elif defined(IMGUI_ENABLE_ARM_CRC)
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = __crc32cd(crc, v);
+    }
+    while (data_size-- != 0)
+        crc = __crc32cb(crc, *data++);
+#else
+    const ImU32* crc32_lut = GCrc32cLookupTable;
+    while (data_size-- != 0)
+        crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
+#endif
+    return crc;
+}
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImU32 ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    return ~ImCrc32c(~seed, (const unsigned char*)data_p, data_size);
+}
+
+// Zero-terminated string hash, with support for ### to reset back to seed value
+// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+// - As each ### discards the hash so far, we only need to hash from the last ### onward.
+// - Because this syntax is rarely used, scanning for '#' with memchr() is fast, and we can hash 8 bytes at a time.
+ImU32 ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
+{
+    const unsigned char* data = (const unsigned char*)data_p;
+    const unsigned char* data_end = data + (data_size != 0 ? data_size : strlen(data_p));
+    for (const unsigned char* p = data; p < data_end; p++)
+    {
+        p = (const unsigned char*)memchr(p, '#', (size_t)(data_end - p));
+        if (p == NULL)
+            break;
+        if (data_end - p >= 3 && p[1] == '#' && p[2] == '#')
+            data = p;
+    }
+    return ~ImCrc32c(~seed, data, (size_t)(data_end - data));
+}
+
+#endif // #ifndef IMGUI_USE_CRC32C_HASH
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -1608,6 +1762,35 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+// Skip characters which don't need UTF-8 decoding nor control character handling, 16 bytes at a time when SIMD is available.
+// This lets text functions process long ASCII runs with a tight loop.
+const char* ImTextSkipPrintableAscii(const char* in_text, const char* in_text_end)
+{
+#if defined(IMGUI_ENABLE_SSE2)
+    // As signed bytes, 0x20..0x7F are > 0x1F while control characters and UTF-8 sequences bytes (0x80..0xFF) are not.
+    const __m128i v_max_control = _mm_set1_epi8(0x1F);
+    while (in_text_end - in_text >= 16)
+    {
+        const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)in_text);
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(v, v_max_control)) != 0xFFFF)
+            break;
+        in_text += 16;
+    }
+#elif defined(IMGUI_ENABLE_NEON)
+    const int8x16_t v_max_control = vdupq_n_s8(0x1F);
+    while (in_text_end - in_text >= 16)
+    {
+        const int8x16_t v = vld1q_s8((const int8_t*)in_text);
+        if (vminvq_u8(vcgtq_s8(v, v_max_control)) != 0xFF)
+            break;
+        in_text += 16;
+    }
+#endif
+    while (in_text < in_text_end && (signed char)*in_text > 0x1F)
+        in_text++;
+    return in_text;
+}
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
@@ -1812,6 +1995,8 @@ void ImGui::ColorConvertHSVtoRGB(float h, float s, float v, float& out_r, float&
 // Helper: Key->value storage
 //-----------------------------------------------------------------------------
 
+#ifndef IMGUI_USE_HASHED_STORAGE
+
 // std::lower_bound but without the bullshit
 static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImGuiID key)
 {
@@ -1835,6 +2020,26 @@ static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiSt
     return first;
 }
 
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStorage::ImGuiStoragePair>&>(storage->Data), key);
+    if (it == storage->Data.end() || it->key != key)
+        return NULL;
+    return it;
+}
+
+// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrAdd(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& default_pair)
+{
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(storage->Data, default_pair.key);
+    if (it == storage->Data.end() || it->key != default_pair.key)
+    {
+        IM_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
+        it = storage->Data.insert(it, default_pair);
+    }
+    return it;
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
@@ -1852,12 +2057,97 @@ void ImGuiStorage::BuildSortByKey()
         ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairCompareByID);
 }
 
+#else // #ifndef IMGUI_USE_HASHED_STORAGE
+
+// Pairs are stored in insertion order in Data[], Slots[] maps keys to their index with linear probing.
+// Robin Hood insertion keeps keys ordered by distance to their home slot, so a lookup for a missing key stops
+// as soon as it meets a key closer to its home slot. Load factor is kept under 3/4. There is no removal.
+static inline int StorageHomeSlot(ImGuiID key, int mask)
+{
+    const ImU32 h = key * 0x9E3779B1u; // IDs are usually hashes already, but mix anyway as small integers are valid keys too
+    return (int)(h ^ (h >> 16)) & mask;
+}
+
+static void StorageSlotsInsert(ImGuiStorage* storage, ImGuiID key, int idx)
+{
+    ImGuiStorage::ImGuiStorageSlot carry = { key, idx };
+    ImGuiStorage::ImGuiStorageSlot* slots = storage->Slots.Data;
+    const int mask = storage->Slots.Size - 1;
+    int pos = StorageHomeSlot(key, mask);
+    for (int dist = 0; ; pos = (pos + 1) & mask, dist++)
+    {
+        ImGuiStorage::ImGuiStorageSlot* slot = &slots[pos];
+        if (slot->idx == -1)
+        {
+            *slot = carry;
+            return;
+        }
+        const int slot_dist = (pos - StorageHomeSlot(slot->key, mask)) & mask;
+        if (slot_dist < dist)
+        {
+            ImSwap(*slot, carry);
+            dist = slot_dist;
+        }
+    }
+}
+
+static void StorageSlotsRebuild(ImGuiStorage* storage, int slots_count)
+{
+    storage->Slots.resize(slots_count);
+    for (int n = 0; n < slots_count; n++)
+        storage->Slots.Data[n].idx = -1;
+    for (int n = 0; n < storage->Data.Size; n++)
+        StorageSlotsInsert(storage, storage->Data.Data[n].key, n);
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    IM_ASSERT(storage->Slots.Size > 0 || storage->Data.Size == 0); // Call BuildSortByKey() after modifying Data[] directly
+    if (storage->Slots.Size == 0)
+        return NULL;
+    const ImGuiStorage::ImGuiStorageSlot* slots = storage->Slots.Data;
+    const int mask = storage->Slots.Size - 1;
+    int pos = StorageHomeSlot(key, mask);
+    for (int dist = 0; ; pos = (pos + 1) & mask, dist++)
+    {
+        const ImGuiStorage::ImGuiStorageSlot* slot = &slots[pos];
+        if (slot->idx == -1)
+            return NULL;
+        if (slot->key == key)
+            return &storage->Data.Data[slot->idx];
+        if (((pos - StorageHomeSlot(slot->key, mask)) & mask) < dist)
+            return NULL;
+    }
+}
+
+static ImGuiStorage::ImGuiStoragePair* StorageFindOrAdd(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& default_pair)
+{
+    if (ImGuiStorage::ImGuiStoragePair* it = StorageFind(storage, default_pair.key))
+        return it;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
+    if ((storage->Data.Size + 1) * 4 > storage->Slots.Size * 3)
+        StorageSlotsRebuild(storage, storage->Slots.Size ? storage->Slots.Size * 2 : 16);
+    storage->Data.push_back(default_pair);
+    StorageSlotsInsert(storage, default_pair.key, storage->Data.Size - 1);
+    return &storage->Data.back();
+}
+
+// For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then index them once.
+void ImGuiStorage::BuildSortByKey()
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Storage);
+    int slots_count = 16;
+    while (Data.Size * 4 > slots_count * 3)
+        slots_count *= 2;
+    StorageSlotsRebuild(this, slots_count);
+}
+
+#endif // #ifndef IMGUI_USE_HASHED_STORAGE
+
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -1867,27 +2157,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = StorageFind(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -1897,30 +2180,17 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &StorageFindOrAdd(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_i = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -1930,24 +2200,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_f = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_p = val;
+    StorageFindOrAdd(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -1956,6 +2214,217 @@ void ImGuiStorage::SetAllInt(int v)
         Data[i].val_i = v;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiTextLayoutCache
+//-----------------------------------------------------------------------------
+
+static int TextLayoutCalcMemoryUsed(const ImGuiTextLayout& layout)
+{
+    return (int)(sizeof(ImGuiTextLayout) + sizeof(ImGuiStorage::ImGuiStoragePair)) + layout.LineBreaks.Capacity * (int)sizeof(int);
+}
+
+static void TextLayoutUnlink(ImGuiTextLayoutCache* cache, int idx)
+{
+    ImGuiTextLayout* layout = &cache->Layouts[idx];
+    if (layout->LruPrev != -1) { cache->Layouts[layout->LruPrev].LruNext = layout->LruNext; } else { cache->LruHead = layout->LruNext; }
+    if (layout->LruNext != -1) { cache->Layouts[layout->LruNext].LruPrev = layout->LruPrev; } else { cache->LruTail = layout->LruPrev; }
+    layout->LruPrev = layout->LruNext = -1;
+}
+
+static void TextLayoutLinkFront(ImGuiTextLayoutCache* cache, int idx)
+{
+    ImGuiTextLayout* layout = &cache->Layouts[idx];
+    layout->LruPrev = -1;
+    layout->LruNext = cache->LruHead;
+    if (cache->LruHead != -1) { cache->Layouts[cache->LruHead].LruPrev = idx; } else { cache->LruTail = idx; }
+    cache->LruHead = idx;
+}
+
+void ImGuiTextLayoutCache::Clear()
+{
+    for (int n = 0; n < Layouts.Size; n++)
+        Layouts[n].LineBreaks.clear();
+    Layouts.clear();
+    Map.Clear();
+    TempLineBreaks.clear();
+    LruHead = LruTail = FreeHead = -1;
+    LayoutsCount = StaleKeysCount = 0;
+    MemoryUsed = 0;
+}
+
+// Glyphs version is part of the key so that layouts are invalidated whenever the atlas is rebuilt or glyphs are added.
+// The text is hashed 8 bytes at a time: a byte-wise ImHashData() would cost about as much as measuring the text again.
+// (we also don't want ImHashStr() which resets the hash on "###")
+ImGuiID ImGuiTextLayoutCache::CalcKey(const ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    const ImU32 glyphs_version = font->ContainerAtlas ? (ImU32)font->ContainerAtlas->GlyphsVersion : 0;
+    const float params[2] = { font_size, wrap_width };
+    ImGuiID seed = ImHashData(&font, sizeof(font), glyphs_version);
+    seed = ImHashData(params, sizeof(params), seed);
+
+    const ImU64 k = 0x9E3779B97F4A7C15ULL;
+    ImU64 h = (seed ^ (ImU64)(text_end - text)) * k;
+    for (; text_end - text >= 8; text += 8)
+    {
+        ImU64 w;
+        memcpy(&w, text, 8);
+        h = (h ^ w) * k;
+        h ^= h >> 32;
+    }
+    for (; text < text_end; text++)
+        h = (h ^ (unsigned char)*text) * k;
+    h ^= h >> 29;
+    return (ImGuiID)(h ^ (h >> 32));
+}
+
+const ImGuiTextLayout* ImGuiTextLayoutCache::Find(ImGuiID key, int text_length)
+{
+    const int idx = Map.GetInt(key, 0) - 1;
+    if (idx < 0 || Layouts[idx].TextLength != text_length)
+    {
+        MissesCount++;
+        return NULL;
+    }
+    HitsCount++;
+    if (idx != LruHead)
+    {
+        TextLayoutUnlink(this, idx);
+        TextLayoutLinkFront(this, idx);
+    }
+    return &Layouts[idx];
+}
+
+void ImGuiTextLayoutCache::Add(ImGuiID key, int text_length, const ImVec2& size, ImVector<int>* line_breaks)
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_TextLayout);
+    int* p_idx = Map.GetIntRef(key, -1); // -1: new key, 0: evicted layout, >0: index into Layouts[] + 1
+    int idx = *p_idx - 1;
+    if (idx >= 0)
+    {
+        // Replace colliding layout in place
+        MemoryUsed -= TextLayoutCalcMemoryUsed(Layouts[idx]);
+        TextLayoutUnlink(this, idx);
+    }
+    else
+    {
+        if (*p_idx == 0)
+            StaleKeysCount--;
+        if (FreeHead != -1)
+        {
+            idx = FreeHead;
+            FreeHead = Layouts[idx].LruNext;
+        }
+        else
+        {
+            idx = Layouts.Size;
+            Layouts.push_back(ImGuiTextLayout());
+        }
+        *p_idx = idx + 1;
+        LayoutsCount++;
+    }
+    TextLayoutLinkFront(this, idx);
+
+    ImGuiTextLayout* layout = &Layouts[idx];
+    layout->Key = key;
+    layout->TextLength = text_length;
+    layout->Size = size;
+    layout->LineBreaks.swap(*line_breaks);
+    line_breaks->resize(0);
+    MemoryUsed += TextLayoutCalcMemoryUsed(*layout);
+}
+
+void ImGuiTextLayoutCache::Trim(int memory_budget)
+{
+    while (MemoryUsed > memory_budget && LruTail != LruHead)
+    {
+        const int idx = LruTail;
+        ImGuiTextLayout* layout = &Layouts[idx];
+        MemoryUsed -= TextLayoutCalcMemoryUsed(*layout);
+        Map.SetInt(layout->Key, 0); // ImGuiStorage has no removal
+        StaleKeysCount++;
+        LayoutsCount--;
+        layout->LineBreaks.clear();
+        TextLayoutUnlink(this, idx);
+        layout->LruNext = FreeHead;
+        FreeHead = idx;
+    }
+
+    // Rebuild map when evicted keys outnumber cached layouts
+    if (StaleKeysCount > 64 && StaleKeysCount > LayoutsCount)
+    {
+        Map.Clear();
+        Map.Data.reserve(LayoutsCount);
+        for (int idx = LruHead; idx != -1; idx = Layouts[idx].LruNext)
+            Map.Data.push_back(ImGuiStorage::ImGuiStoragePair(Layouts[idx].Key, idx + 1));
+        Map.BuildSortByKey();
+        StaleKeysCount = 0;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiFrameArena
+//-----------------------------------------------------------------------------
+
+void ImGuiFrameArena::Clear()
+{
+    for (int n = 0; n < HeapAllocs.Size; n++)
+        IM_FREE(HeapAllocs[n]);
+    HeapAllocs.clear();
+    if (Data)
+        IM_FREE(Data);
+    Data = NULL;
+    Capacity = Used = 0;
+}
+
+// Called by NewFrame(): invalidate all allocations of the previous frame
+void ImGuiFrameArena::Reset(int capacity)
+{
+    for (int n = 0; n < HeapAllocs.Size; n++)
+        IM_FREE(HeapAllocs[n]);
+    HeapAllocs.resize(0);
+    UsedLastFrame = Used;
+    Used = 0;
+    if (capacity != Capacity)
+    {
+        if (Data)
+            IM_FREE(Data);
+        Data = (capacity > 0) ? (char*)IM_ALLOC((size_t)capacity) : NULL;
+        Capacity = capacity;
+        UsedHighWaterMark = 0;
+    }
+}
+
+void* ImGuiFrameArena::Alloc(size_t size)
+{
+    const size_t aligned_size = (size + 15) & ~(size_t)15; // Keep 16 bytes alignment, like malloc()
+    if (aligned_size <= (size_t)(Capacity - Used))
+    {
+        void* ptr = Data + Used;
+        Used += (int)aligned_size;
+        UsedHighWaterMark = ImMax(UsedHighWaterMark, Used);
+        AllocsCount++;
+        return ptr;
+    }
+    void* ptr = IM_ALLOC(size);
+    HeapAllocs.push_back(ptr);
+    HeapAllocsCount++;
+    return ptr;
+}
+
+void ImGuiFrameArena::Free(void* ptr)
+{
+    if (ptr == NULL || Contains(ptr))
+        return;
+    for (int n = HeapAllocs.Size - 1; n >= 0; n--)
+        if (HeapAllocs[n] == ptr)
+        {
+            IM_FREE(ptr);
+            HeapAllocs.erase_unsorted(&HeapAllocs[n]);
+            return;
+        }
+    IM_ASSERT(0 && "Pointer was not allocated with MemAllocFrame() during this frame!");
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextFilter
 //-----------------------------------------------------------------------------
@@ -1963,6 +2432,7 @@ void ImGuiStorage::SetAllInt(int v)
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 ImGuiTextFilter::ImGuiTextFilter(const char* default_filter)
 {
+    CacheLinesCount = CacheLinesBase = 0;
     if (default_filter)
     {
         ImStrncpy(InputBuf, default_filter, IM_ARRAYSIZE(InputBuf));
@@ -2058,6 +2528,190 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+struct ImGuiTextFilterLinesJobData
+{
+    const ImGuiTextFilter*  Filter;
+    const char*             Lines;
+    int                     LinesCount;
+    int                     Stride;
+    ImU32*                  OutBits;
+    int*                    OutPassCounts;  // One per job
+};
+
+// Jobs process multiples of 32 lines, so that each of them writes to different words of OutBits[]
+static const int TEXT_FILTER_LINES_PER_JOB = 32 * 512;
+
+static void PassFilterLinesJob(void* user_data, int job_index)
+{
+    ImGuiTextFilterLinesJobData* data = (ImGuiTextFilterLinesJobData*)user_data;
+    const int line_begin = job_index * TEXT_FILTER_LINES_PER_JOB;
+    const int line_end = ImMin(line_begin + TEXT_FILTER_LINES_PER_JOB, data->LinesCount);
+    int pass_count = 0;
+    for (int word_begin = line_begin; word_begin < line_end; word_begin += 32)
+    {
+        ImU32 word = 0;
+        const int word_end = ImMin(word_begin + 32, line_end);
+        for (int line_n = word_begin; line_n < word_end; line_n++)
+        {
+            const char* const* line = (const char* const*)(const void*)(data->Lines + (size_t)line_n * data->Stride);
+            if (data->Filter->PassFilter(line[0], line[1]))
+            {
+                word |= (ImU32)1 << (line_n & 31);
+                pass_count++;
+            }
+        }
+        data->OutBits[word_begin >> 5] = word;
+    }
+    data->OutPassCounts[job_index] = pass_count;
+}
+
+int ImGuiTextFilter::PassFilterLines(const char* const* lines, int lines_count, ImU32* out_bits, int stride) const
+{
+    if (lines_count <= 0)
+        return 0;
+    if (Filters.empty())
+    {
+        memset(out_bits, 0xFF, (size_t)(lines_count >> 5) * sizeof(ImU32));
+        if (lines_count & 31)
+            out_bits[lines_count >> 5] = ((ImU32)1 << (lines_count & 31)) - 1;
+        return lines_count;
+    }
+
+    const int jobs_count = (lines_count + TEXT_FILTER_LINES_PER_JOB - 1) / TEXT_FILTER_LINES_PER_JOB;
+    ImVector<int> pass_counts;
+    pass_counts.resize(jobs_count);
+    ImGuiTextFilterLinesJobData data;
+    data.Filter = this;
+    data.Lines = (const char*)(const void*)lines;
+    data.LinesCount = lines_count;
+    data.Stride = stride;
+    data.OutBits = out_bits;
+    data.OutPassCounts = pass_counts.Data;
+    ImGuiContext* ctx = GImGui;
+    if (ctx != NULL && ctx->IO.ParallelForFn != NULL && jobs_count > 1)
+        ctx->IO.ParallelForFn(ctx->IO.ParallelForUserData, PassFilterLinesJob, &data, jobs_count);
+    else
+        for (int job_n = 0; job_n < jobs_count; job_n++)
+            PassFilterLinesJob(&data, job_n);
+
+    int pass_count = 0;
+    for (int job_n = 0; job_n < jobs_count; job_n++)
+        pass_count += pass_counts[job_n];
+    return pass_count;
+}
+
+// Return true when every text passing 'filter' also passes 'prev_filter'.
+// This is the case when include terms were extended (a text containing the new term also contains the previous one)
+// and exclude terms were appended. Since the first matching term decides the result, terms cannot be reordered.
+// Set '*out_same_terms' when both filters have the same terms (e.g. after typing a blank), and thus the same results.
+static bool TextFilterIsNarrowerThan(const ImGuiTextFilter& filter, const ImGuiTextFilter& prev_filter, bool* out_same_terms)
+{
+    *out_same_terms = false;
+    if (filter.Filters.Size < prev_filter.Filters.Size)
+        return false;
+    bool same_terms = (filter.Filters.Size == prev_filter.Filters.Size);
+    for (int i = 0; i != filter.Filters.Size; i++)
+    {
+        const ImGuiTextFilter::ImGuiTextRange& f = filter.Filters[i];
+        if (i >= prev_filter.Filters.Size)
+        {
+            if (!f.empty() && f.b[0] != '-')
+                return false;
+            continue;
+        }
+        const ImGuiTextFilter::ImGuiTextRange& prev_f = prev_filter.Filters[i];
+        if (f.e - f.b == prev_f.e - prev_f.b && memcmp(f.b, prev_f.b, (size_t)(f.e - f.b)) == 0)
+            continue;
+        if (f.empty() || prev_f.empty() || f.b[0] == '-' || prev_f.b[0] == '-')
+            return false;
+        if (ImStristr(f.b, f.e, prev_f.b, prev_f.e) == NULL)
+            return false;
+        same_terms = false;
+    }
+    *out_same_terms = same_terms;
+    return true;
+}
+
+const ImVector<int>& ImGuiTextFilter::PassFilterLinesCached(const char* const* lines, int lines_count, int stride, int lines_base)
+{
+    const char* lines_data = (const char*)(const void*)lines;
+
+    // Lines removed from the front (e.g. ImGuiTextLineBuffer with MaxLines): drop their matches and shift the other indices
+    const int lines_removed = lines_base - CacheLinesBase;
+    CacheLinesBase = lines_base;
+    if (lines_removed < 0 || lines_removed > CacheLinesCount)
+    {
+        CacheMatches.resize(0); // Buffer was cleared, or all lines tested were removed
+        CacheLinesCount = 0;
+    }
+    else if (lines_removed > 0)
+    {
+        int dst_n = 0;
+        for (int src_n = 0; src_n < CacheMatches.Size; src_n++)
+            if (CacheMatches[src_n] >= lines_removed)
+                CacheMatches[dst_n++] = CacheMatches[src_n] - lines_removed;
+        CacheMatches.resize(dst_n);
+        CacheLinesCount -= lines_removed;
+    }
+
+    const bool input_changed = CacheInputBuf.empty() || strcmp(CacheInputBuf.Data, InputBuf) != 0;
+    bool cache_valid = !CacheInputBuf.empty() && lines_count >= CacheLinesCount;
+    if (cache_valid && input_changed)
+    {
+        ImGuiTextFilter prev_filter(CacheInputBuf.Data);
+        bool same_terms = false;
+        cache_valid = TextFilterIsNarrowerThan(*this, prev_filter, &same_terms);
+        if (cache_valid && !same_terms)
+        {
+            // Narrowed filter: test previous matches again
+            int dst_n = 0;
+            for (int src_n = 0; src_n < CacheMatches.Size; src_n++)
+            {
+                const char* const* line = (const char* const*)(const void*)(lines_data + (size_t)CacheMatches[src_n] * stride);
+                if (PassFilter(line[0], line[1]))
+                    CacheMatches[dst_n++] = CacheMatches[src_n];
+            }
+            CacheMatches.resize(dst_n);
+        }
+    }
+    if (!cache_valid)
+    {
+        CacheMatches.resize(0);
+        CacheLinesCount = 0;
+    }
+    if (input_changed)
+    {
+        const int input_len = (int)strlen(InputBuf);
+        CacheInputBuf.resize(input_len + 1);
+        memcpy(CacheInputBuf.Data, InputBuf, (size_t)input_len + 1);
+    }
+
+    // Test lines added since last call (all lines if the cache was discarded)
+    const int new_lines_count = lines_count - CacheLinesCount;
+    if (new_lines_count > TEXT_FILTER_LINES_PER_JOB)
+    {
+        // Many lines: use PassFilterLines() which can spread them over io.ParallelForFn jobs
+        ImVector<ImU32> bits;
+        bits.resize((new_lines_count + 31) >> 5);
+        const int pass_count = PassFilterLines((const char* const*)(const void*)(lines_data + (size_t)CacheLinesCount * stride), new_lines_count, bits.Data, stride);
+        CacheMatches.reserve(CacheMatches.Size + pass_count);
+        for (int line_n = 0; line_n < new_lines_count; line_n++)
+            if (bits[line_n >> 5] & ((ImU32)1 << (line_n & 31)))
+                CacheMatches.push_back(CacheLinesCount + line_n);
+    }
+    else
+    {
+        for (int line_n = CacheLinesCount; line_n < lines_count; line_n++)
+        {
+            const char* const* line = (const char* const*)(const void*)(lines_data + (size_t)line_n * stride);
+            if (PassFilter(line[0], line[1]))
+                CacheMatches.push_back(line_n);
+        }
+    }
+    CacheLinesCount = lines_count;
+    return CacheMatches;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextBuffer
 //-----------------------------------------------------------------------------
@@ -2074,25 +2728,202 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
 
 char ImGuiTextBuffer::EmptyString[1] = { 0 };
 
-void ImGuiTextBuffer::append(const char* str, const char* str_end)
+void ImGuiTextBuffer::append(const char* str, const char* str_end)
+{
+    int len = str_end ? (int)(str_end - str) : (int)strlen(str);
+
+    // Add zero-terminator the first time
+    const int write_off = (Buf.Size != 0) ? Buf.Size : 1;
+    const int needed_sz = write_off + len;
+    if (write_off + len >= Buf.Capacity)
+    {
+        int new_capacity = Buf.Capacity * 2;
+        Buf.reserve(needed_sz > new_capacity ? needed_sz : new_capacity);
+    }
+
+    Buf.resize(needed_sz);
+    memcpy(&Buf[write_off - 1], str, (size_t)len);
+    Buf[write_off - 1 + len] = 0;
+}
+
+void ImGuiTextBuffer::appendf(const char* fmt, ...)
+{
+    va_list args;
+    va_start(args, fmt);
+    appendfv(fmt, args);
+    va_end(args);
+}
+
+// Helper: Text buffer for logging/accumulating text
+void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
+{
+    va_list args_copy;
+    va_copy(args_copy, args);
+
+    int len = ImFormatStringV(NULL, 0, fmt, args);         // FIXME-OPT: could do a first pass write attempt, likely successful on first pass.
+    if (len <= 0)
+    {
+        va_end(args_copy);
+        return;
+    }
+
+    // Add zero-terminator the first time
+    const int write_off = (Buf.Size != 0) ? Buf.Size : 1;
+    const int needed_sz = write_off + len;
+    if (write_off + len >= Buf.Capacity)
+    {
+        int new_capacity = Buf.Capacity * 2;
+        Buf.reserve(needed_sz > new_capacity ? needed_sz : new_capacity);
+    }
+
+    Buf.resize(needed_sz);
+    ImFormatStringV(&Buf[write_off - 1], (size_t)len + 1, fmt, args_copy);
+    va_end(args_copy);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiTextLineBuffer
+//-----------------------------------------------------------------------------
+
+void ImGuiTextLineBuffer::clear()
+{
+    for (int n = 0; n < Chunks.Size; n++)
+        IM_FREE(Chunks[n].Data);
+    if (SpareChunk)
+        IM_FREE(SpareChunk);
+    SpareChunk = NULL;
+    Chunks.clear();
+    Lines.clear();
+    LinesFirst = LinesDiscarded = 0;
+    LastLineOpen = false;
+}
+
+ImGuiTextLineBuffer& ImGuiTextLineBuffer::operator=(const ImGuiTextLineBuffer& src)
+{
+    if (this == &src)
+        return *this;
+    clear();
+    MaxLines = src.MaxLines;
+    ChunkSize = src.ChunkSize;
+    Lines.reserve(src.size());
+    for (int n = 0; n < src.size(); n++)
+    {
+        const Line& line = src[n];
+        append(line.Begin, line.End);
+        if (n + 1 < src.size() || !src.LastLineOpen)
+            append("\n");
+        Lines.back().UserData = line.UserData;
+    }
+    LinesDiscarded = src.LinesDiscarded;
+    return *this;
+}
+
+void ImGuiTextLineBuffer::_ReleaseChunk(char* data, int capacity)
+{
+    if (SpareChunk == NULL && capacity == ChunkSize)
+        SpareChunk = data;
+    else
+        IM_FREE(data);
+}
+
+// Return a pointer to 'len' writable bytes (+ 1 for a zero-terminator) following the last line.
+// When the current chunk is full, the unterminated last line is moved to a new chunk so that every line stays contiguous.
+char* ImGuiTextLineBuffer::_PrepareWrite(int len)
+{
+    if (Chunks.Size > 0 && Chunks.back().Size + len < Chunks.back().Capacity)
+        return Chunks.back().Data + Chunks.back().Size;
+
+    Line* open_line = LastLineOpen ? &Lines.back() : NULL;
+    const int open_len = open_line ? (int)(open_line->End - open_line->Begin) : 0;
+    const int capacity = ImMax(ChunkSize, open_len + len + 1);
+    char* data;
+    if (SpareChunk != NULL && capacity == ChunkSize)
+    {
+        data = SpareChunk;
+        SpareChunk = NULL;
+    }
+    else
+    {
+        data = (char*)IM_ALLOC((size_t)capacity);
+    }
+    if (open_line)
+    {
+        memcpy(data, open_line->Begin, (size_t)open_len);
+        Chunk& prev_chunk = Chunks.back();
+        prev_chunk.Size -= open_len;
+        if (prev_chunk.Size == 0)
+        {
+            _ReleaseChunk(prev_chunk.Data, prev_chunk.Capacity);
+            Chunks.pop_back();
+        }
+        open_line->Begin = data;
+        open_line->End = data + open_len;
+    }
+    Chunk chunk;
+    chunk.Data = data;
+    chunk.Size = open_len;
+    chunk.Capacity = capacity;
+    Chunks.push_back(chunk);
+    return data + open_len;
+}
+
+// Add 'len' bytes written at 'p' (returned by _PrepareWrite()) to the buffer, splitting them into lines
+void ImGuiTextLineBuffer::_CommitWrite(char* p, int len)
 {
-    int len = str_end ? (int)(str_end - str) : (int)strlen(str);
-
-    // Add zero-terminator the first time
-    const int write_off = (Buf.Size != 0) ? Buf.Size : 1;
-    const int needed_sz = write_off + len;
-    if (write_off + len >= Buf.Capacity)
+    Chunks.back().Size += len;
+    const char* p_end = p + len;
+    while (p < p_end)
     {
-        int new_capacity = Buf.Capacity * 2;
-        Buf.reserve(needed_sz > new_capacity ? needed_sz : new_capacity);
+        if (!LastLineOpen)
+        {
+            Line line;
+            line.Begin = line.End = p;
+            line.UserData = 0;
+            Lines.push_back(line);
+            LastLineOpen = true;
+
+            // Discard oldest line, and its chunk once no line refers to it
+            if (MaxLines > 0 && size() > MaxLines)
+            {
+                LinesFirst++;
+                LinesDiscarded++;
+                const char* first_line_begin = Lines[LinesFirst].Begin;
+                while (Chunks.Size > 1 && (first_line_begin < Chunks[0].Data || first_line_begin >= Chunks[0].Data + Chunks[0].Size))
+                {
+                    _ReleaseChunk(Chunks[0].Data, Chunks[0].Capacity);
+                    Chunks.erase(Chunks.Data);
+                }
+                if (LinesFirst >= 1024 && LinesFirst * 2 >= Lines.Size)
+                {
+                    Lines.erase(Lines.Data, Lines.Data + LinesFirst);
+                    LinesFirst = 0;
+                }
+            }
+        }
+        char* line_end = (char*)memchr(p, '\n', (size_t)(p_end - p));
+        Line& line = Lines.back();
+        if (line_end == NULL)
+        {
+            line.End = p_end;
+            break;
+        }
+        line.End = line_end;
+        LastLineOpen = false;
+        p = line_end + 1;
     }
+}
 
-    Buf.resize(needed_sz);
-    memcpy(&Buf[write_off - 1], str, (size_t)len);
-    Buf[write_off - 1 + len] = 0;
+void ImGuiTextLineBuffer::append(const char* str, const char* str_end)
+{
+    const int len = str_end ? (int)(str_end - str) : (int)strlen(str);
+    if (len <= 0)
+        return;
+    char* p = _PrepareWrite(len);
+    memcpy(p, str, (size_t)len);
+    _CommitWrite(p, len);
 }
 
-void ImGuiTextBuffer::appendf(const char* fmt, ...)
+void ImGuiTextLineBuffer::appendf(const char* fmt, ...)
 {
     va_list args;
     va_start(args, fmt);
@@ -2100,31 +2931,43 @@ void ImGuiTextBuffer::appendf(const char* fmt, ...)
     va_end(args);
 }
 
-// Helper: Text buffer for logging/accumulating text
-void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
+void ImGuiTextLineBuffer::appendfv(const char* fmt, va_list args)
 {
     va_list args_copy;
     va_copy(args_copy, args);
 
-    int len = ImFormatStringV(NULL, 0, fmt, args);         // FIXME-OPT: could do a first pass write attempt, likely successful on first pass.
-    if (len <= 0)
+    // Format directly into the current chunk, which typically has enough room
+    // ImFormatStringV() returns the truncated length: only a result filling all available space may have been truncated.
+    int len = -1;
+    if (Chunks.Size > 0)
     {
-        va_end(args_copy);
-        return;
+        Chunk& chunk = Chunks.back();
+        const int avail = chunk.Capacity - chunk.Size;
+        if (avail > 1)
+        {
+            len = ImFormatStringV(chunk.Data + chunk.Size, (size_t)avail, fmt, args);
+            if (len >= avail - 1)
+                len = -1;
+        }
     }
-
-    // Add zero-terminator the first time
-    const int write_off = (Buf.Size != 0) ? Buf.Size : 1;
-    const int needed_sz = write_off + len;
-    if (write_off + len >= Buf.Capacity)
+    if (len < 0)
     {
-        int new_capacity = Buf.Capacity * 2;
-        Buf.reserve(needed_sz > new_capacity ? needed_sz : new_capacity);
+        // Measure, then format into a new chunk (or the current one if the text exactly fits)
+        va_list args_measure;
+        va_copy(args_measure, args_copy);
+        len = ImFormatStringV(NULL, 0, fmt, args_measure);
+        va_end(args_measure);
+        if (len <= 0)
+        {
+            va_end(args_copy);
+            return;
+        }
+        char* p = _PrepareWrite(len);
+        ImFormatStringV(p, (size_t)len + 1, fmt, args_copy);
     }
-
-    Buf.resize(needed_sz);
-    ImFormatStringV(&Buf[write_off - 1], (size_t)len + 1, fmt, args_copy);
     va_end(args_copy);
+    if (len > 0)
+        _CommitWrite(Chunks.back().Data + Chunks.back().Size, len);
 }
 
 //-----------------------------------------------------------------------------
@@ -2133,6 +2976,18 @@ void ImGuiTextBuffer::appendfv(const char* fmt, va_list args)
 // the API mid-way through development and support two ways to using the clipper, needs some rework (see TODO)
 //-----------------------------------------------------------------------------
 
+// We create the union of the ClipRect and the NavScoringRect which at worst should be 1 page away from ClipRect
+static ImRect CalcListClippingRect(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    ImRect unclipped_rect = window->ClipRect;
+    if (g.NavMoveRequest)
+        unclipped_rect.Add(g.NavScoringRect);
+    if (g.NavJustMovedToId && window->NavLastIds[0] == g.NavJustMovedToId)
+        unclipped_rect.Add(ImRect(window->Pos + window->NavRectRel[0].Min, window->Pos + window->NavRectRel[0].Max));
+    return unclipped_rect;
+}
+
 // Helper to calculate coarse clipping of large list of evenly sized items.
 // NB: Prefer using the ImGuiListClipper higher-level helper if you can! Read comments and instructions there on how those use this sort of pattern.
 // NB: 'items_count' is only used to clamp the result, if you don't know your count you can use INT_MAX
@@ -2153,13 +3008,7 @@ void ImGui::CalcListClipping(int items_count, float items_height, int* out_items
         return;
     }
 
-    // We create the union of the ClipRect and the NavScoringRect which at worst should be 1 page away from ClipRect
-    ImRect unclipped_rect = window->ClipRect;
-    if (g.NavMoveRequest)
-        unclipped_rect.Add(g.NavScoringRect);
-    if (g.NavJustMovedToId && window->NavLastIds[0] == g.NavJustMovedToId)
-        unclipped_rect.Add(ImRect(window->Pos + window->NavRectRel[0].Min, window->Pos + window->NavRectRel[0].Max));
-
+    ImRect unclipped_rect = CalcListClippingRect(window);
     const ImVec2 pos = window->DC.CursorPos;
     int start = (int)((unclipped_rect.Min.y - pos.y) / items_height);
     int end = (int)((unclipped_rect.Max.y - pos.y) / items_height);
@@ -2213,25 +3062,106 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     StartPosY = window->DC.CursorPos.y;
     ItemsHeight = items_height;
     ItemsCount = items_count;
+    ItemsHeights = NULL;
     StepNo = 0;
     DisplayStart = -1;
     DisplayEnd = 0;
 }
 
+// Use case C: items of variable heights, stored in a persistent ImGuiListClipperHeights
+void ImGuiListClipper::BeginWithHeights(ImGuiListClipperHeights* heights)
+{
+    IM_ASSERT(heights != NULL);
+    Begin(heights->Heights.Size, -1.0f);
+    ItemsHeights = heights;
+}
+
 void ImGuiListClipper::End()
 {
     if (ItemsCount < 0) // Already ended
         return;
 
     // In theory here we should assert that ImGui::GetCursorPosY() == StartPosY + DisplayEnd * ItemsHeight, but it feels saner to just seek at the end and not assert/crash the user.
-    if (ItemsCount < INT_MAX && DisplayStart >= 0)
+    if (ItemsHeights != NULL && ItemsCount > 0 && DisplayStart >= 0)
+        SetCursorPosYAndSetupForPrevLine(StartPosY + ItemsHeights->GetTotalHeight(), ItemsHeights->Heights[ItemsCount - 1]);
+    else if (ItemsHeights == NULL && ItemsCount < INT_MAX && DisplayStart >= 0)
         SetCursorPosYAndSetupForPrevLine(StartPosY + ItemsCount * ItemsHeight, ItemsHeight);
     ItemsCount = -1;
     StepNo = 3;
 }
 
+// Step() for use case C: submit visible items one at a time, measuring each of them.
+static bool ListClipperStepWithHeights(ImGuiListClipper* clipper)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiListClipperHeights* heights = clipper->ItemsHeights;
+    IM_ASSERT(heights->Heights.Size == clipper->ItemsCount && "Cannot resize ImGuiListClipperHeights while clipping!");
+
+    // Step 0: locate the first visible item using the heights index, position the cursor on it and let user submit it
+    if (clipper->StepNo == 0)
+    {
+        if (clipper->ItemsCount == 0 || window->SkipItems)
+        {
+            clipper->End();
+            return false;
+        }
+        clipper->StartPosY = window->DC.CursorPos.y;
+        int start = 0;
+        if (g.LogEnabled)
+        {
+            // If logging is active, do not perform any clipping
+            clipper->ClipMaxY = FLT_MAX;
+            clipper->ClipExtraItems = 0;
+        }
+        else
+        {
+            // When performing a navigation request, ensure we have one item extra in the direction we are moving to
+            ImRect unclipped_rect = CalcListClippingRect(window);
+            start = heights->FindItemAtOffset(unclipped_rect.Min.y - clipper->StartPosY);
+            if (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Up && start > 0)
+                start--;
+            clipper->ClipMaxY = unclipped_rect.Max.y;
+            clipper->ClipExtraItems = (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Down) ? 1 : 0;
+        }
+        if (start > 0)
+            SetCursorPosYAndSetupForPrevLine(clipper->StartPosY + heights->GetOffset(start), heights->Heights[start - 1]);
+        clipper->ItemPosY = window->DC.CursorPos.y;
+        clipper->DisplayStart = start;
+        clipper->DisplayEnd = start + 1;
+        clipper->StepNo = 1;
+        return true;
+    }
+
+    // Step 1: measure the item which was just submitted, then let user submit the next one while it is visible
+    IM_ASSERT(clipper->StepNo == 1);
+    const float item_height = ImMax(window->DC.CursorPos.y - clipper->ItemPosY, 0.0f);
+    if (heights->Heights[clipper->DisplayStart] != item_height)
+        heights->SetHeight(clipper->DisplayStart, item_height);
+    bool submit_next = (clipper->DisplayEnd < clipper->ItemsCount);
+    if (submit_next && window->DC.CursorPos.y >= clipper->ClipMaxY)
+    {
+        submit_next = (clipper->ClipExtraItems > 0);
+        clipper->ClipExtraItems--;
+    }
+    if (submit_next)
+    {
+        clipper->ItemPosY = window->DC.CursorPos.y;
+        clipper->DisplayStart = clipper->DisplayEnd;
+        clipper->DisplayEnd++;
+        return true;
+    }
+
+    // Advance the cursor to the end of the list (using estimated heights for items never submitted)
+    clipper->End();
+    return false;
+}
+
 bool ImGuiListClipper::Step()
 {
+    if (ItemsHeights != NULL)
+        return ListClipperStepWithHeights(this);
+
     ImGuiContext& g = *GImGui;
     ImGuiWindow* window = g.CurrentWindow;
 
@@ -2302,6 +3232,86 @@ bool ImGuiListClipper::Step()
     return false;
 }
 
+// Fenwick tree: Tree[i] holds the sum of Heights[i - lowest_bit(i), i - 1].
+static double ListClipperHeightsPrefixSum(const ImVector<double>& tree, int count)
+{
+    double sum = 0.0;
+    for (int i = count; i > 0; i -= (i & -i))
+        sum += tree[i];
+    return sum;
+}
+
+void ImGuiListClipperHeights::Resize(int items_count)
+{
+    IM_ASSERT(items_count >= 0);
+    if (DefaultHeight <= 0.0f)
+        DefaultHeight = ImGui::GetTextLineHeightWithSpacing();
+    const int old_count = Heights.Size;
+    if (items_count == old_count && Tree.Size == old_count + 1)
+        return;
+    Heights.resize(items_count, DefaultHeight);
+    if (Tree.Size != old_count + 1 || items_count - old_count > old_count)
+    {
+        Build();
+        return;
+    }
+
+    // Removing items at the end leaves the nodes of the remaining items untouched. Added nodes are computed from the existing ones.
+    Tree.resize(items_count + 1);
+    for (int i = old_count + 1; i <= items_count; i++)
+        Tree[i] = Heights[i - 1] + ListClipperHeightsPrefixSum(Tree, i - 1) - ListClipperHeightsPrefixSum(Tree, i - (i & -i));
+}
+
+void ImGuiListClipperHeights::SetHeight(int item_idx, float height)
+{
+    IM_ASSERT(item_idx >= 0 && item_idx < Heights.Size && Tree.Size == Heights.Size + 1);
+    const double delta = (double)height - Heights[item_idx];
+    Heights[item_idx] = height;
+    for (int i = item_idx + 1; i < Tree.Size; i += (i & -i))
+        Tree[i] += delta;
+}
+
+void ImGuiListClipperHeights::Build()
+{
+    const int count = Heights.Size;
+    Tree.resize(count + 1);
+    Tree[0] = 0.0;
+    for (int i = 1; i <= count; i++)
+        Tree[i] = Heights[i - 1];
+    for (int i = 1; i <= count; i++)
+    {
+        const int parent = i + (i & -i);
+        if (parent <= count)
+            Tree[parent] += Tree[i];
+    }
+}
+
+float ImGuiListClipperHeights::GetOffset(int item_idx) const
+{
+    IM_ASSERT(item_idx >= 0 && (item_idx == 0 || item_idx < Tree.Size));
+    return (float)ListClipperHeightsPrefixSum(Tree, item_idx);
+}
+
+int ImGuiListClipperHeights::FindItemAtOffset(float offset) const
+{
+    // Descend the tree from the largest power of two, skipping over items which end before 'offset'
+    const int count = Tree.Size - 1;
+    if (count <= 0)
+        return 0;
+    int step = 1;
+    while (step * 2 <= count)
+        step *= 2;
+    int pos = 0;
+    double remaining = offset;
+    for (; step > 0; step >>= 1)
+        if (pos + step <= count && Tree[pos + step] <= remaining)
+        {
+            pos += step;
+            remaining -= Tree[pos];
+        }
+    return ImMin(pos, count - 1);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] STYLING
 //-----------------------------------------------------------------------------
@@ -2909,6 +3919,7 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
     window->IDStack.clear();
     window->DrawList->_ClearFreeMemory();
+    window->DrawListRetainedStableCount = 0;
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
@@ -3192,12 +4203,39 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
     return ImMax(wrap_pos_x - pos.x, 1.0f);
 }
 
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+// With IMGUI_ENABLE_MEMORY_TAGS, each allocation is prefixed with its size and category so MemFree() can update the statistics.
+// The header is padded to 16 bytes to preserve the alignment guarantees of the underlying allocator.
+struct ImGuiMemTagHeader
+{
+    size_t      Size;
+    ImGuiMemTag Tag;
+};
+static const size_t IM_MEM_TAG_HEADER_SIZE = 16;
+IM_STATIC_ASSERT(sizeof(ImGuiMemTagHeader) <= IM_MEM_TAG_HEADER_SIZE);
+#endif
+
 // IM_ALLOC() == ImGui::MemAlloc()
 void* ImGui::MemAlloc(size_t size)
 {
     if (ImGuiContext* ctx = GImGui)
         ctx->IO.MetricsActiveAllocations++;
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    ImGuiMemTagHeader* header = (ImGuiMemTagHeader*)GImAllocatorAllocFunc(size + IM_MEM_TAG_HEADER_SIZE, GImAllocatorUserData);
+    if (header == NULL)
+        return NULL;
+    header->Size = size;
+    header->Tag = GImMemTag;
+    ImGuiMemTagStats& stats = GImMemTagStats[GImMemTag];
+    stats.LiveBytes += size;
+    stats.LiveCount++;
+    stats.TotalCount++;
+    if (stats.PeakBytes < stats.LiveBytes)
+        stats.PeakBytes = stats.LiveBytes;
+    return (char*)header + IM_MEM_TAG_HEADER_SIZE;
+#else
     return GImAllocatorAllocFunc(size, GImAllocatorUserData);
+#endif
 }
 
 // IM_FREE() == ImGui::MemFree()
@@ -3206,9 +4244,63 @@ void ImGui::MemFree(void* ptr)
     if (ptr)
         if (ImGuiContext* ctx = GImGui)
             ctx->IO.MetricsActiveAllocations--;
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    if (ptr == NULL)
+        return;
+    ImGuiMemTagHeader* header = (ImGuiMemTagHeader*)(void*)((char*)ptr - IM_MEM_TAG_HEADER_SIZE);
+    ImGuiMemTagStats& stats = GImMemTagStats[header->Tag];
+    stats.LiveBytes -= header->Size;
+    stats.LiveCount--;
+    ptr = header;
+#endif
     return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
 }
 
+// Set the category of following MemAlloc() calls. Dear ImGui uses IM_MEM_TAG_SCOPE() to tag its own allocations.
+ImGuiMemTag ImGui::SetMemTag(ImGuiMemTag tag)
+{
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    IM_ASSERT(tag >= 0 && tag < ImGuiMemTag_COUNT);
+    ImGuiMemTag backup_tag = GImMemTag;
+    GImMemTag = tag;
+    return backup_tag;
+#else
+    IM_UNUSED(tag);
+    return ImGuiMemTag_Misc;
+#endif
+}
+
+const ImGuiMemTagStats* ImGui::GetMemTagStats(ImGuiMemTag tag)
+{
+    IM_ASSERT(tag >= 0 && tag < ImGuiMemTag_COUNT);
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+    return &GImMemTagStats[tag];
+#else
+    return NULL;
+#endif
+}
+
+const char* ImGui::GetMemTagName(ImGuiMemTag tag)
+{
+    static const char* const names[] = { "Misc", "Windows", "DrawLists", "Fonts", "Settings", "InputText", "Storage", "TextLayout", "User" };
+    IM_STATIC_ASSERT(IM_ARRAYSIZE(names) == ImGuiMemTag_COUNT);
+    IM_ASSERT(tag >= 0 && tag < ImGuiMemTag_COUNT);
+    return names[tag];
+}
+
+// Transient allocation, valid until the next call to NewFrame(). Calling MemFreeFrame() is optional.
+void* ImGui::MemAllocFrame(size_t size)
+{
+    ImGuiContext& g = *GImGui;
+    return g.FrameArena.Alloc(size);
+}
+
+void ImGui::MemFreeFrame(void* ptr)
+{
+    ImGuiContext& g = *GImGui;
+    g.FrameArena.Free(ptr);
+}
+
 const char* ImGui::GetClipboardText()
 {
     ImGuiContext& g = *GImGui;
@@ -3243,13 +4335,21 @@ void ImGui::SetCurrentContext(ImGuiContext* ctx)
 #endif
 }
 
-void ImGui::SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data)
+void ImGui::SetAllocatorFunctions(ImGuiMemAllocFunc alloc_func, ImGuiMemFreeFunc free_func, void* user_data)
 {
     GImAllocatorAllocFunc = alloc_func;
     GImAllocatorFreeFunc = free_func;
     GImAllocatorUserData = user_data;
 }
 
+// This is provided to facilitate copying allocators from one static/DLL boundary to another (e.g. retrieve default allocator of your executable address space)
+void ImGui::GetAllocatorFunctions(ImGuiMemAllocFunc* p_alloc_func, ImGuiMemFreeFunc* p_free_func, void** p_user_data)
+{
+    *p_alloc_func = GImAllocatorAllocFunc;
+    *p_free_func = GImAllocatorFreeFunc;
+    *p_user_data = GImAllocatorUserData;
+}
+
 ImGuiContext* ImGui::CreateContext(ImFontAtlas* shared_font_atlas)
 {
     ImGuiContext* ctx = IM_NEW(ImGuiContext)(shared_font_atlas);
@@ -3749,6 +4849,31 @@ void ImGui::NewFrame()
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
     if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AllowVtxOffset;
+    if (g.IO.ConfigDrawListsDeferTessellation)
+        g.DrawListSharedData.InitialFlags |= ImDrawListFlags_DeferTessellation;
+
+    // Text layout cache
+    ImGuiTextLayoutCache& text_layout_cache = g.TextLayoutCache;
+    text_layout_cache.HitsCountLastFrame = text_layout_cache.HitsCount;
+    text_layout_cache.MissesCountLastFrame = text_layout_cache.MissesCount;
+    text_layout_cache.HitsCount = text_layout_cache.MissesCount = 0;
+    text_layout_cache.MemoryBudget = ImMax(g.IO.ConfigMemoryTextLayoutCacheSize, 0);
+    if (text_layout_cache.MemoryBudget > 0)
+        text_layout_cache.Trim(text_layout_cache.MemoryBudget);
+    else if (text_layout_cache.Layouts.Size > 0)
+        text_layout_cache.Clear();
+    g.DrawListSharedData.TextLayoutCache = (text_layout_cache.MemoryBudget > 0) ? &text_layout_cache : NULL;
+
+    // Discard line indices of long texts which weren't submitted last frame
+    for (int n = g.TextLineIndices.Size - 1; n >= 0; n--)
+        if (g.TextLineIndices[n].LastFrameUsed < g.FrameCount - 1)
+        {
+            g.TextLineIndices[n].LineOffsets.clear();
+            g.TextLineIndices.erase(g.TextLineIndices.Data + n);
+        }
+
+    // Rewind frame arena
+    g.FrameArena.Reset(ImMax(g.IO.ConfigMemoryFrameArenaSize, 0));
 
     g.BackgroundDrawList._ResetForNewFrame();
     g.BackgroundDrawList.PushTextureID(g.IO.Fonts->TexID);
@@ -3999,6 +5124,11 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.OpenPopupStack.clear();
     g.BeginPopupStack.clear();
     g.DrawDataBuilder.ClearFreeMemory();
+    g.DrawListsToTessellate.clear();
+    for (int i = 0; i < g.DrawListsMerged.Size; i++)
+        IM_DELETE(g.DrawListsMerged[i]);
+    g.DrawListsMerged.clear();
+    g.DrawListsMergeOutput.clear();
     g.BackgroundDrawList._ClearFreeMemory();
     g.ForegroundDrawList._ClearFreeMemory();
 
@@ -4009,6 +5139,12 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.ClipboardHandlerData.clear();
     g.MenusIdSubmittedThisFrame.clear();
     g.InputTextState.ClearFreeMemory();
+    g.TextLayoutCache.Clear();
+    g.DrawListSharedData.TextLayoutCache = NULL;
+    for (int i = 0; i < g.TextLineIndices.Size; i++)
+        g.TextLineIndices[i].LineOffsets.clear();
+    g.TextLineIndices.clear();
+    g.FrameArena.Clear();
 
     g.SettingsWindows.clear();
     g.SettingsHandlers.clear();
@@ -4055,6 +5191,29 @@ static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, Im
     }
 }
 
+// With ImGuiWindowFlags_RetainDrawList: compare the hash of this frame drawing commands with the one of the frame which built the buffers.
+// A frame which only hashed commands will still render the retained buffers, so a change not caused by interaction is visible with one frame of latency.
+// After a mismatch the window is fully built every frame until WINDOWS_RETAIN_DRAW_LIST_STABLE_BUILDS consecutive builds produce the same commands,
+// so contents changing every frame (e.g. a live value) are always up to date instead of alternating between stale and rebuilt frames.
+static void UpdateWindowRetainedDrawList(ImGuiWindow* window)
+{
+    ImDrawList* draw_list = &window->DrawListInst;
+    if (draw_list->Flags & ImDrawListFlags_HashOnly)
+    {
+        draw_list->_EndHashOnly();
+        if (draw_list->_CommandsHash != window->DrawListRetainedHash)
+            window->DrawListRetainedStableCount = 0;
+    }
+    else
+    {
+        if (draw_list->_CommandsHash == window->DrawListRetainedHash && window->DrawListRetainedStableCount > 0)
+            window->DrawListRetainedStableCount++;
+        else
+            window->DrawListRetainedStableCount = 1;
+        window->DrawListRetainedHash = draw_list->_CommandsHash;
+    }
+}
+
 static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list)
 {
     // Remove trailing command if unused.
@@ -4130,6 +5289,167 @@ void ImDrawDataBuilder::FlattenIntoSingleLayer()
     }
 }
 
+static void TessellateDeferredDrawListJob(void* job_user_data, int job_index)
+{
+    ImDrawList** draw_lists = (ImDrawList**)job_user_data;
+    draw_lists[job_index]->_TessellateDeferred();
+}
+
+// Generate vertices of primitives recorded with ImDrawListFlags_DeferTessellation, one job per draw list.
+static void TessellateDeferredDrawLists(ImVector<ImDrawList*>* draw_lists)
+{
+    ImGuiContext& g = *GImGui;
+    ImVector<ImDrawList*>& jobs_lists = g.DrawListsToTessellate;
+    jobs_lists.resize(0);
+    for (int n = 0; n < draw_lists->Size; n++)
+        if (draw_lists->Data[n]->_DeferredPrims.Size > 0)
+            jobs_lists.push_back(draw_lists->Data[n]);
+    if (g.IO.ParallelForFn != NULL && jobs_lists.Size > 1)
+        g.IO.ParallelForFn(g.IO.ParallelForUserData, TessellateDeferredDrawListJob, jobs_lists.Data, jobs_lists.Size);
+    else
+        for (int job_n = 0; job_n < jobs_lists.Size; job_n++)
+            TessellateDeferredDrawListJob(jobs_lists.Data, job_n);
+}
+
+// Copy draw lists into context-owned draw lists (io.ConfigDrawDataMerge), joining consecutive draw commands when possible:
+// - They need to use the same texture.
+// - Their clipping rectangles need to be equal, unless the geometry of a command doesn't touch the edges of its own clipping
+//   rectangle: clipping doesn't affect its output, so it can be drawn with any clipping rectangle containing its geometry.
+//   (keep a 1 pixel margin as renderer backends may truncate the scissor rectangle to integer framebuffer coordinates)
+// Indices are rebased while being copied. With 16-bit indices, a new base vertex (ImDrawCmd::VtxOffset) is used every 64K
+// vertices, or a new draw list is started if the renderer backend doesn't support ImGuiBackendFlags_RendererHasVtxOffset.
+static void MergeDrawLists(ImVector<ImDrawList*>* draw_lists)
+{
+    ImGuiContext& g = *GImGui;
+    const bool allow_vtx_offset = (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset) != 0;
+    const float fb_scale = ImMin(g.IO.DisplayFramebufferScale.x, g.IO.DisplayFramebufferScale.y);
+    const float margin = (fb_scale > 0.0f) ? ImMax(1.0f / fb_scale, 1.0f) : 1.0f;
+
+    ImVector<ImDrawList*>& out_lists = g.DrawListsMergeOutput;
+    out_lists.resize(0);
+    int merged_lists_used = 0;
+    int cmds_before = 0;
+    ImDrawList* dst = NULL;
+    ImRect batch_clip_rect;             // Clipping rectangle of last command of 'dst'
+    ImRect batch_bb;                    // Bounding box of the geometry of last command of 'dst'
+    bool batch_clip_rect_exact = false; // Last command of 'dst' contains geometry affected by clipping: its rectangle can't be changed
+    bool batch_mergeable = false;
+    for (int list_n = 0; list_n < draw_lists->Size; list_n++)
+    {
+        ImDrawList* src = draw_lists->Data[list_n];
+        bool has_callbacks = false;
+        for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size && !has_callbacks; cmd_n++)
+            has_callbacks = (src->CmdBuffer.Data[cmd_n].UserCallback != NULL);
+        cmds_before += src->CmdBuffer.Size;
+        if (has_callbacks)
+        {
+            // Callbacks may rely on their parent draw list: keep it as is
+            out_lists.push_back(src);
+            dst = NULL;
+            continue;
+        }
+
+        // Start a new destination draw list when needed
+        if (dst == NULL || (sizeof(ImDrawIdx) == 2 && !allow_vtx_offset && dst->VtxBuffer.Size + src->VtxBuffer.Size > (1 << 16)))
+        {
+            if (merged_lists_used == g.DrawListsMerged.Size)
+            {
+                ImDrawList* draw_list = IM_NEW(ImDrawList)(&g.DrawListSharedData);
+                draw_list->_OwnerName = "##Merged";
+                g.DrawListsMerged.push_back(draw_list);
+            }
+            dst = g.DrawListsMerged[merged_lists_used++];
+            dst->CmdBuffer.resize(0);
+            dst->IdxBuffer.resize(0);
+            dst->VtxBuffer.resize(0);
+            out_lists.push_back(dst);
+            batch_mergeable = false;
+        }
+
+        const int vtx_base = dst->VtxBuffer.Size;
+        dst->VtxBuffer.resize(vtx_base + src->VtxBuffer.Size);
+        memcpy(dst->VtxBuffer.Data + vtx_base, src->VtxBuffer.Data, (size_t)src->VtxBuffer.Size * sizeof(ImDrawVert));
+        for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd* src_cmd = &src->CmdBuffer.Data[cmd_n];
+            if (src_cmd->ElemCount == 0)
+                continue;
+
+            // Rebase indices on the base vertex of last command, unless they wouldn't fit in ImDrawIdx
+            const int cmd_vtx_offset = vtx_base + (int)src_cmd->VtxOffset;
+            int dst_vtx_offset = (dst->CmdBuffer.Size > 0) ? (int)dst->CmdBuffer.back().VtxOffset : 0;
+            if (sizeof(ImDrawIdx) == 2)
+            {
+                const int cmd_vtx_count = ImMin(src->VtxBuffer.Size - (int)src_cmd->VtxOffset, 1 << 16);
+                if (cmd_vtx_offset - dst_vtx_offset + cmd_vtx_count > (1 << 16))
+                {
+                    IM_ASSERT(allow_vtx_offset);
+                    dst_vtx_offset = cmd_vtx_offset;
+                    batch_mergeable = false;
+                }
+            }
+            const int idx_base = dst->IdxBuffer.Size;
+            const ImDrawIdx idx_rebase = (ImDrawIdx)(cmd_vtx_offset - dst_vtx_offset);
+            const ImDrawIdx* idx_src = src->IdxBuffer.Data + src_cmd->IdxOffset;
+            dst->IdxBuffer.resize(idx_base + (int)src_cmd->ElemCount);
+            ImDrawIdx* idx_dst = dst->IdxBuffer.Data + idx_base;
+            ImRect bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+            const ImDrawVert* vtx_src = src->VtxBuffer.Data + src_cmd->VtxOffset;
+            for (unsigned int i = 0; i < src_cmd->ElemCount; i++)
+            {
+                idx_dst[i] = (ImDrawIdx)(idx_src[i] + idx_rebase);
+                bb.Add(vtx_src[idx_src[i]].pos);
+            }
+
+            // Join with last command when compatible
+            const ImRect clip_rect(src_cmd->ClipRect);
+            ImRect bb_expanded = bb;
+            bb_expanded.Expand(margin);
+            const bool clip_rect_exact = !clip_rect.Contains(bb_expanded);
+            bool merge = batch_mergeable && dst->CmdBuffer.back().TextureId == src_cmd->TextureId;
+            if (merge && batch_clip_rect_exact && clip_rect_exact)
+                merge = (batch_clip_rect.Min.x == clip_rect.Min.x && batch_clip_rect.Min.y == clip_rect.Min.y && batch_clip_rect.Max.x == clip_rect.Max.x && batch_clip_rect.Max.y == clip_rect.Max.y);
+            else if (merge && batch_clip_rect_exact)
+                merge = batch_clip_rect.Contains(bb_expanded);
+            else if (merge && clip_rect_exact)
+                merge = clip_rect.Contains(batch_bb);
+            if (merge)
+            {
+                if (clip_rect_exact)
+                    batch_clip_rect = clip_rect;
+                else if (!batch_clip_rect_exact)
+                    batch_clip_rect.Add(clip_rect);
+                batch_clip_rect_exact |= clip_rect_exact;
+                batch_bb.Add(bb_expanded);
+                ImDrawCmd& dst_cmd = dst->CmdBuffer.back();
+                dst_cmd.ClipRect = batch_clip_rect.ToVec4();
+                dst_cmd.ElemCount += src_cmd->ElemCount;
+            }
+            else
+            {
+                ImDrawCmd dst_cmd;
+                dst_cmd.ClipRect = src_cmd->ClipRect;
+                dst_cmd.TextureId = src_cmd->TextureId;
+                dst_cmd.VtxOffset = (unsigned int)dst_vtx_offset;
+                dst_cmd.IdxOffset = (unsigned int)idx_base;
+                dst_cmd.ElemCount = src_cmd->ElemCount;
+                dst->CmdBuffer.push_back(dst_cmd);
+                batch_clip_rect = clip_rect;
+                batch_clip_rect_exact = clip_rect_exact;
+                batch_bb = bb_expanded;
+                batch_mergeable = true;
+            }
+        }
+    }
+
+    int cmds_after = 0;
+    for (int list_n = 0; list_n < out_lists.Size; list_n++)
+        cmds_after += out_lists[list_n]->CmdBuffer.Size;
+    g.DrawDataMergeCmdsBefore = cmds_before;
+    g.DrawDataMergeCmdsAfter = cmds_after;
+    draw_lists->swap(out_lists);
+}
+
 static void SetupDrawData(ImVector<ImDrawList*>* draw_lists, ImDrawData* draw_data)
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -4239,8 +5559,16 @@ void ImGui::EndFrame()
     g.Windows.swap(g.WindowsTempSortBuffer);
     g.IO.MetricsActiveWindows = g.WindowsActiveCount;
 
-    // Unlock font atlas
+    // Compare hashes of retained draw lists
+    for (int i = 0; i != g.Windows.Size; i++)
+        if (g.Windows[i]->Active && (g.Windows[i]->DrawListInst.Flags & ImDrawListFlags_HashCommands))
+            UpdateWindowRetainedDrawList(g.Windows[i]);
+
+    // Unlock font atlas and rasterize glyphs requested during the frame (ImFontAtlasFlags_DynamicGlyphs)
+    // The renderer backend needs to upload modified regions of the texture (ImFontAtlas::TexDirtyRects)
     g.IO.Fonts->Locked = false;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates)
+        g.IO.Fonts->BuildDynamicGlyphs();
 
     // Clear Input data for next frame
     g.IO.MouseWheel = g.IO.MouseWheelH = 0.0f;
@@ -4257,6 +5585,7 @@ void ImGui::Render()
 
     if (g.FrameCountEnded != g.FrameCount)
         EndFrame();
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     g.FrameCountRendered = g.FrameCount;
     g.IO.MetricsRenderWindows = 0;
     g.DrawDataBuilder.Clear();
@@ -4290,6 +5619,13 @@ void ImGui::Render()
     if (!g.ForegroundDrawList.VtxBuffer.empty())
         AddDrawListToDrawData(&g.DrawDataBuilder.Layers[0], &g.ForegroundDrawList);
 
+    // Generate deferred vertices (optionally on worker threads)
+    TessellateDeferredDrawLists(&g.DrawDataBuilder.Layers[0]);
+
+    // Join draw commands across draw lists (optional)
+    if (g.IO.ConfigDrawDataMerge)
+        MergeDrawLists(&g.DrawDataBuilder.Layers[0]);
+
     // Setup ImDrawData structure for end-user
     SetupDrawData(&g.DrawDataBuilder.Layers[0], &g.DrawData);
     g.IO.MetricsRenderVertices = g.DrawData.TotalVtxCount;
@@ -4314,7 +5650,31 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+
+    // Word-wrapped text layouts are cached, as the same text is typically measured then rendered at the same width every frame
+    ImVec2 text_size;
+    ImGuiTextLayoutCache* text_layout_cache = g.DrawListSharedData.TextLayoutCache;
+    if (wrap_width > 0.0f && text_layout_cache)
+    {
+        if (text_display_end == NULL)
+            text_display_end = text + strlen(text);
+        const int text_length = (int)(text_display_end - text);
+        const ImGuiID key = ImGuiTextLayoutCache::CalcKey(font, font_size, wrap_width, text, text_display_end);
+        if (const ImGuiTextLayout* layout = text_layout_cache->Find(key, text_length))
+        {
+            text_size = layout->Size;
+        }
+        else
+        {
+            text_size = font->CalcTextSizeEx(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL, &text_layout_cache->TempLineBreaks);
+            text_layout_cache->Add(key, text_length, text_size, &text_layout_cache->TempLineBreaks);
+            text_layout_cache->Trim(text_layout_cache->MemoryBudget);
+        }
+    }
+    else
+    {
+        text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    }
 
     // Round
     text_size.x = IM_FLOOR(text_size.x + 0.95f);
@@ -4888,6 +6248,7 @@ static void ApplyWindowSettings(ImGuiWindow* window, ImGuiWindowSettings* settin
 static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Windows);
     //IMGUI_DEBUG_LOG("CreateNewWindow '%s', flags = 0x%08X\n", name, flags);
 
     // Create window the first time
@@ -5452,6 +6813,7 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Windows);
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL && name[0] != '\0');     // Window name required
     IM_ASSERT(g.WithinFrameScope);                  // Forgot to call ImGui::NewFrame()
@@ -5591,7 +6953,19 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->HasCloseButton = (p_open != NULL);
         window->ClipRect = ImVec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
         window->IDStack.resize(1);
-        window->DrawList->_ResetForNewFrame();
+        if (flags & ImGuiWindowFlags_RetainDrawList)
+        {
+            // Keep last frame buffers and only hash drawing commands when the window is not being interacted with and its contents are stable.
+            // The hash is compared in EndFrame(): on mismatch, the window is fully rebuilt on the next frames (see UpdateWindowRetainedDrawList()).
+            const bool is_interacting = (g.HoveredWindow == window || g.ActiveIdWindow == window || g.MovingWindow == window || g.NavWindowingTarget == window || (g.NavWindow == window && !g.NavDisableHighlight));
+            const bool hash_only = window->DrawListRetainedStableCount >= WINDOWS_RETAIN_DRAW_LIST_STABLE_BUILDS && window->WasActive && !window->MemoryCompacted && !is_interacting;
+            window->DrawList->_ResetForNewFrameHashed(hash_only);
+        }
+        else
+        {
+            window->DrawListRetainedStableCount = 0;
+            window->DrawList->_ResetForNewFrame();
+        }
 
         // Restore buffer capacity when woken from a compacted state, to avoid
         if (window->MemoryCompacted)
@@ -5873,7 +7247,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         // DRAWING
 
         // Setup draw list and outer clipping rectangle
-        IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0);
+        IM_ASSERT((window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0) || (window->DrawList->Flags & ImDrawListFlags_HashOnly));
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         PushClipRect(host_rect.Min, host_rect.Max, false);
 
@@ -5904,7 +7278,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
             bool render_decorations_in_parent = false;
             if ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & ImGuiWindowFlags_Popup) && !window_is_child_tooltip)
                 if (window->DrawList->CmdBuffer.back().ElemCount == 0 && parent_window->DrawList->VtxBuffer.Size > 0)
-                    render_decorations_in_parent = true;
+                    if (!((window->DrawList->Flags | parent_window->DrawList->Flags) & ImDrawListFlags_HashCommands)) // Retained draw lists need to own their drawing commands
+                        render_decorations_in_parent = true;
             if (render_decorations_in_parent)
                 window->DrawList = parent_window->DrawList;
 
@@ -9889,6 +11264,7 @@ void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
 {
     ImGuiContext& g = *GImGui;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
 
 #if !IMGUI_DEBUG_INI_SETTINGS
     // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
@@ -9957,6 +11333,7 @@ void ImGui::LoadIniSettingsFromDisk(const char* ini_filename)
 void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
 {
     ImGuiContext& g = *GImGui;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
     IM_ASSERT(g.Initialized);
     //IM_ASSERT(!g.WithinFrameScope && "Cannot be called between NewFrame() and EndFrame()");
     //IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
@@ -10044,6 +11421,7 @@ void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
 const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 {
     ImGuiContext& g = *GImGui;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Settings);
     g.SettingsDirtyTimer = 0.0f;
     g.SettingsIniData.Buf.resize(0);
     g.SettingsIniData.Buf.push_back(0);
@@ -10356,6 +11734,8 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Dear ImGui %s", ImGui::GetVersion());
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
+    if (io.ConfigDrawDataMerge)
+        Text("%d draw commands merged into %d (io.ConfigDrawDataMerge)", g.DrawDataMergeCmdsBefore, g.DrawDataMergeCmdsAfter);
     Text("%d active windows (%d visible)", io.MetricsActiveWindows, io.MetricsRenderWindows);
     Text("%d active allocations", io.MetricsActiveAllocations);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
@@ -10516,6 +11896,44 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         TreePop();
     }
 
+    // Details for Memory
+    if (TreeNode("Memory"))
+    {
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+        if (SmallButton("Reset peaks"))
+            for (int tag = 0; tag < ImGuiMemTag_COUNT; tag++)
+                GImMemTagStats[tag].PeakBytes = GImMemTagStats[tag].LiveBytes;
+        Columns(5, "##MemTags", false);
+        Text("Category"); NextColumn(); Text("Live bytes"); NextColumn(); Text("Peak bytes"); NextColumn(); Text("Live allocs"); NextColumn(); Text("Total allocs"); NextColumn();
+        Separator();
+        size_t total_live_bytes = 0;
+        int total_live_count = 0, total_count = 0;
+        for (int tag = 0; tag < ImGuiMemTag_COUNT; tag++)
+        {
+            const ImGuiMemTagStats& stats = GImMemTagStats[tag];
+            Text("%s", GetMemTagName(tag)); NextColumn();
+            Text("%d", (int)stats.LiveBytes); NextColumn();
+            Text("%d", (int)stats.PeakBytes); NextColumn();
+            Text("%d", stats.LiveCount); NextColumn();
+            Text("%d", stats.TotalCount); NextColumn();
+            total_live_bytes += stats.LiveBytes;
+            total_live_count += stats.LiveCount;
+            total_count += stats.TotalCount;
+        }
+        Separator();
+        Text("Total"); NextColumn();
+        Text("%d", (int)total_live_bytes); NextColumn();
+        NextColumn();
+        Text("%d", total_live_count); NextColumn();
+        Text("%d", total_count); NextColumn();
+        Columns(1);
+#else
+        Text("%d active allocations.", io.MetricsActiveAllocations);
+        Text("Define IMGUI_ENABLE_MEMORY_TAGS in imconfig.h to track allocations per category.");
+#endif
+        TreePop();
+    }
+
     // Misc Details
     if (TreeNode("Internal state"))
     {
@@ -10549,6 +11967,40 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         Text("NavWindowingTarget: '%s'", g.NavWindowingTarget ? g.NavWindowingTarget->Name : "NULL");
         Unindent();
 
+        Text("TEXT LAYOUT CACHE");
+        Indent();
+        ImGuiTextLayoutCache& text_layout_cache = g.TextLayoutCache;
+        Text("Layouts: %d, Memory: %d/%d bytes", text_layout_cache.LayoutsCount, text_layout_cache.MemoryUsed, text_layout_cache.MemoryBudget);
+        Text("Last frame: %d hits, %d misses", text_layout_cache.HitsCountLastFrame, text_layout_cache.MissesCountLastFrame);
+        if (SmallButton("Clear"))
+            text_layout_cache.Clear();
+        for (int n = 0; n < g.TextLineIndices.Size; n++)
+        {
+            const ImGuiTextLineIndex& line_index = g.TextLineIndices[n];
+            Text("Line index 0x%08X: %d lines in %d bytes of text, %d bytes", line_index.ID, line_index.GetLinesCount(), line_index.TextLength, line_index.LineOffsets.Capacity * (int)sizeof(int));
+        }
+        Unindent();
+
+        Text("FRAME ARENA");
+        Indent();
+        ImGuiFrameArena& frame_arena = g.FrameArena;
+        Text("Buffer: %d bytes, used last frame: %d bytes, high-water mark: %d bytes", frame_arena.Capacity, frame_arena.UsedLastFrame, frame_arena.UsedHighWaterMark);
+        Text("Allocations: %d from buffer (heap allocations avoided), %d from heap", frame_arena.AllocsCount, frame_arena.HeapAllocsCount);
+        Unindent();
+
+        Text("FONT ATLAS");
+        Indent();
+        ImFontAtlas* atlas = io.Fonts;
+        Text("Texture: %dx%d, %d dirty rectangles, GlyphsVersion: %d", atlas->TexWidth, atlas->TexHeight, atlas->TexDirtyRects.Size, atlas->GlyphsVersion);
+        if (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs)
+        {
+            if (atlas->DynamicGlyphsMissingCount > 0)
+                TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Dynamic glyphs: texture is full, %d glyphs missing (increase TexDesiredWidth)", atlas->DynamicGlyphsMissingCount);
+            else
+                Text("Dynamic glyphs: no missing glyphs");
+        }
+        Unindent();
+
         TreePop();
     }
 
@@ -10626,6 +12078,8 @@ void ImGui::DebugNodeDrawList(ImGuiWindow* window, const ImDrawList* draw_list,
             TreePop();
         return;
     }
+    if (draw_list->_DeferredPrims.Size > 0)
+        const_cast<ImDrawList*>(draw_list)->_TessellateDeferred(); // Draw list was submitted earlier in this frame: generate vertices so we can inspect them
 
     ImDrawList* fg_draw_list = GetForegroundDrawList(window); // Render additional visuals into the top-most draw list
     if (window && IsItemHovered())
@@ -10736,7 +12190,11 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImGuiWindow* window, const Im
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
-    if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
+    int size_in_bytes = storage->Data.size_in_bytes();
+#ifdef IMGUI_USE_HASHED_STORAGE
+    size_in_bytes += storage->Slots.size_in_bytes();
+#endif
+    if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, size_in_bytes))
         return;
     for (int n = 0; n < storage->Data.Size; n++)
     {
@@ -10814,6 +12272,8 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
     BulletText("Scroll: (%.2f/%.2f,%.2f/%.2f) Scrollbar:%s%s", window->Scroll.x, window->ScrollMax.x, window->Scroll.y, window->ScrollMax.y, window->ScrollbarX ? "X" : "", window->ScrollbarY ? "Y" : "");
     BulletText("Active: %d/%d, WriteAccessed: %d, BeginOrderWithinContext: %d", window->Active, window->WasActive, window->WriteAccessed, (window->Active || window->WasActive) ? window->BeginOrderWithinContext : -1);
     BulletText("Appearing: %d, Hidden: %d (CanSkip %d Cannot %d), SkipItems: %d", window->Appearing, window->Hidden, window->HiddenFramesCanSkipItems, window->HiddenFramesCannotSkipItems, window->SkipItems);
+    if (window->Flags & ImGuiWindowFlags_RetainDrawList)
+        BulletText("RetainDrawList: Hash 0x%08X, StableCount: %d, Reused: %d", window->DrawListRetainedHash, window->DrawListRetainedStableCount, (window->DrawListInst.Flags & ImDrawListFlags_HashOnly) != 0);
     BulletText("NavLastIds: 0x%08X,0x%08X, NavLayerActiveMask: %X", window->NavLastIds[0], window->NavLastIds[1], window->DC.NavLayerActiveMask);
     BulletText("NavLastChildNavWindow: %s", window->NavLastChildNavWindow ? window->NavLastChildNavWindow->Name : "NULL");
     if (!window->NavRectRel[0].IsInverted())
@@ -29,7 +29,7 @@ Index of this file:
 // ImGuiIO
 // Misc data structures (ImGuiInputTextCallbackData, ImGuiSizeCallbackData, ImGuiPayload)
 // Obsolete functions
-// Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
+// Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiTextLineBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
 // Draw List API (ImDrawCallback, ImDrawCmd, ImDrawIdx, ImDrawVert, ImDrawChannel, ImDrawListSplitter, ImDrawListFlags, ImDrawList, ImDrawData)
 // Font API (ImFontConfig, ImFontGlyph, ImFontGlyphRangesBuilder, ImFontAtlasFlags, ImFontAtlas, ImFont)
 
@@ -116,6 +116,7 @@ Index of this file:
 // Forward declarations
 struct ImDrawChannel;               // Temporary storage to output draw commands out of order, used by ImDrawListSplitter and ImDrawList::ChannelsSplit()
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
+struct ImDrawDeferredPrim;          // A primitive recorded by ImDrawList with ImDrawListFlags_DeferTessellation, whose vertices are generated later
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
@@ -131,6 +132,8 @@ struct ImGuiContext;                // Dear ImGui context (opaque structure, unl
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListClipperHeights;     // Helper to store the heights of a list of variable-height items, for ImGuiListClipper
+struct ImGuiMemTagStats;            // Allocation statistics for a category of memory allocations (see IMGUI_ENABLE_MEMORY_TAGS)
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiSizeCallbackData;       // Callback data when using SetNextWindowSizeConstraints() (rare/advanced use)
@@ -138,6 +141,7 @@ struct ImGuiStorage;                // Helper for key->value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
+struct ImGuiTextLineBuffer;         // Helper to append lines of text into fixed-size chunks, for large or fast-growing logs
 
 // Enums/Flags (declared as int for compatibility with old C++, to allow using as flags and to not pollute the top of this file)
 // - Tip: Use your programming IDE navigation facilities on the names in the _central column_ below to find the actual flags/enum lists!
@@ -148,6 +152,7 @@ typedef int ImGuiCond;              // -> enum ImGuiCond_            // Enum: A
 typedef int ImGuiDataType;          // -> enum ImGuiDataType_        // Enum: A primary data type
 typedef int ImGuiDir;               // -> enum ImGuiDir_             // Enum: A cardinal direction
 typedef int ImGuiKey;               // -> enum ImGuiKey_             // Enum: A key identifier (ImGui-side enum)
+typedef int ImGuiMemTag;            // -> enum ImGuiMemTag_          // Enum: A category of memory allocations
 typedef int ImGuiNavInput;          // -> enum ImGuiNavInput_        // Enum: An input identifier for navigation
 typedef int ImGuiMouseButton;       // -> enum ImGuiMouseButton_     // Enum: A mouse button identifier (0=left, 1=right, 2=middle)
 typedef int ImGuiMouseCursor;       // -> enum ImGuiMouseCursor_     // Enum: A mouse cursor identifier
@@ -180,6 +185,10 @@ typedef void* ImTextureID;          // User data for rendering backend to identi
 typedef unsigned int ImGuiID;       // A unique ID used by widgets, typically hashed from a stack of string.
 typedef int (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);
 typedef void (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);
+typedef void (*ImGuiJobFn)(void* job_user_data, int job_index);
+typedef void (*ImGuiParallelForFn)(void* user_data, ImGuiJobFn job_fn, void* job_user_data, int jobs_count); // See io.ParallelForFn
+typedef void* (*ImGuiMemAllocFunc)(size_t sz, void* user_data);
+typedef void (*ImGuiMemFreeFunc)(void* ptr, void* user_data);
 
 // Decoded character types
 // (we generally use UTF-8 encoded string in the API. This is storage specifically for a decoded character used for keyboard input and display)
@@ -788,10 +797,18 @@ namespace ImGui
     // Memory Allocators
     // - All those functions are not reliant on the current context.
     // - If you reload the contents of imgui.cpp at runtime, you may need to call SetCurrentContext() + SetAllocatorFunctions() again because we use global storage for those.
-    IMGUI_API void          SetAllocatorFunctions(void* (*alloc_func)(size_t sz, void* user_data), void (*free_func)(void* ptr, void* user_data), void* user_data = NULL);
+    IMGUI_API void          SetAllocatorFunctions(ImGuiMemAllocFunc alloc_func, ImGuiMemFreeFunc free_func, void* user_data = NULL);
+    IMGUI_API void          GetAllocatorFunctions(ImGuiMemAllocFunc* p_alloc_func, ImGuiMemFreeFunc* p_free_func, void** p_user_data);
     IMGUI_API void*         MemAlloc(size_t size);
     IMGUI_API void          MemFree(void* ptr);
 
+    // Memory Tags
+    // - Requires IMGUI_ENABLE_MEMORY_TAGS in imconfig.h. Each allocation is accounted to the category which was current when calling MemAlloc().
+    // - Statistics use global storage (allocations may outlive a context), they are not thread-safe.
+    IMGUI_API ImGuiMemTag   SetMemTag(ImGuiMemTag tag);                                         // set category of following MemAlloc() calls, return the previous one. Dear ImGui sets its own categories internally.
+    IMGUI_API const ImGuiMemTagStats* GetMemTagStats(ImGuiMemTag tag);                          // return NULL if IMGUI_ENABLE_MEMORY_TAGS is not defined.
+    IMGUI_API const char*   GetMemTagName(ImGuiMemTag tag);
+
 } // namespace ImGui
 
 //-----------------------------------------------------------------------------
@@ -822,6 +839,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_NoNavInputs            = 1 << 18,  // No gamepad/keyboard navigation within the window
     ImGuiWindowFlags_NoNavFocus             = 1 << 19,  // No focusing toward this window with gamepad/keyboard navigation (e.g. skipped by CTRL+TAB)
     ImGuiWindowFlags_UnsavedDocument        = 1 << 20,  // Append '*' to title without affecting the ID, as a convenience to avoid using the ### operator. When used in a tab/docking context, tab is selected on closure and closure is deferred by one frame to allow code to cancel the closure (with a confirmation popup, etc.) without flicker.
+    ImGuiWindowFlags_RetainDrawList         = 1 << 22,  // [BETA] Reuse last frame vertices/indices when the same drawing commands are submitted. Drawing commands are only hashed, if they differ the previous frame contents are displayed once and the draw list is rebuilt on the next frames, until its contents are stable again. Always rebuilt while the window is hovered, active or navigated.
     ImGuiWindowFlags_NoNav                  = ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
     ImGuiWindowFlags_NoDecoration           = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse,
     ImGuiWindowFlags_NoInputs               = ImGuiWindowFlags_NoMouseInputs | ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
@@ -862,9 +880,10 @@ enum ImGuiInputTextFlags_
     ImGuiInputTextFlags_CharsScientific     = 1 << 17,  // Allow 0123456789.+-*/eE (Scientific notation input)
     ImGuiInputTextFlags_CallbackResize      = 1 << 18,  // Callback on buffer capacity changes request (beyond 'buf_size' parameter value), allowing the string to grow. Notify when the string wants to be resized (for string types which hold a cache of their Size). You will be provided a new BufSize in the callback and NEED to honor it. (see misc/cpp/imgui_stdlib.h for an example of using this)
     ImGuiInputTextFlags_CallbackEdit        = 1 << 19,  // Callback on any edit (note that InputText() already returns true on edit, the callback is useful mainly to manipulate the underlying buffer while focus is active)
+    ImGuiInputTextFlags_LargeBuffer         = 1 << 20,  // InputTextMultiline() only: edit through a gap buffer, so typing doesn't move the whole text (for multi-megabyte text). 'buf' is only written back on frames with an edit (and we return true on any edit). Read-only text is captured on activation.
     // [Internal]
-    ImGuiInputTextFlags_Multiline           = 1 << 20,  // For internal use by InputTextMultiline()
-    ImGuiInputTextFlags_NoMarkEdited        = 1 << 21   // For internal use by functions using InputText() before reformatting data
+    ImGuiInputTextFlags_Multiline           = 1 << 21,  // For internal use by InputTextMultiline()
+    ImGuiInputTextFlags_NoMarkEdited        = 1 << 22   // For internal use by functions using InputText() before reformatting data
 };
 
 // Flags for ImGui::TreeNodeEx(), ImGui::CollapsingHeader*()
@@ -1140,7 +1159,8 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasGamepad            = 1 << 0,   // Backend Platform supports gamepad and currently has one connected.
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
-    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3    // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasTexUpdates = 1 << 4    // Backend Renderer supports uploading regions of the font atlas texture listed in io.Fonts->TexDirtyRects[] before rendering. Required by ImFontAtlasFlags_DynamicGlyphs.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -1353,6 +1373,22 @@ enum ImGuiCond_
     ImGuiCond_Appearing     = 1 << 3    // Set the variable if the object/window is appearing after being hidden/inactive (or the first time)
 };
 
+// Enumeration for SetMemTag(), GetMemTagStats()
+// A category of memory allocations, tracked when IMGUI_ENABLE_MEMORY_TAGS is defined.
+enum ImGuiMemTag_
+{
+    ImGuiMemTag_Misc = 0,               // Untagged allocations
+    ImGuiMemTag_Windows,                // ImGuiWindow and per-window data (name, ID stack, columns, etc.)
+    ImGuiMemTag_DrawLists,              // ImDrawList vertex/index/command buffers, ImDrawData
+    ImGuiMemTag_Fonts,                  // ImFontAtlas input data and texture, ImFont glyphs and lookup tables
+    ImGuiMemTag_Settings,               // .ini data and persistent settings
+    ImGuiMemTag_InputText,              // InputText() edit buffers and undo state
+    ImGuiMemTag_Storage,                // ImGuiStorage (window state storage, tree nodes open state, etc.)
+    ImGuiMemTag_TextLayout,             // Text layout cache (see io.ConfigMemoryTextLayoutCacheSize), line indices of long texts
+    ImGuiMemTag_User,                   // Free for application use, e.g. SetMemTag(ImGuiMemTag_User) around your own IM_ALLOC()/ImVector<> usage
+    ImGuiMemTag_COUNT
+};
+
 //-----------------------------------------------------------------------------
 // Helpers: Memory allocations macros
 // IM_MALLOC(), IM_FREE(), IM_NEW(), IM_PLACEMENT_NEW(), IM_DELETE()
@@ -1532,6 +1568,10 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // [BETA] Set to true to only allow moving windows when clicked+dragged from the title bar. Windows without a title bar are not affected.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // [BETA] Free transient windows/tables memory buffers when unused for given amount of time. Set to -1.0f to disable.
+    int         ConfigMemoryTextLayoutCacheSize; // = 256 KB       // [BETA] Memory budget (in bytes) of the cache of word-wrapped text layouts, which makes text wrapped at the same width every frame (e.g. TextWrapped()) only measured once. Set to 0 to disable.
+    int         ConfigMemoryFrameArenaSize;     // = 0              // [BETA] Size (in bytes) of a linear buffer rewound every frame, serving transient allocations (e.g. InputText() clipboard operations) instead of the heap. Set to 0 to disable. See high-water mark in Metrics.
+    bool        ConfigDrawListsDeferTessellation; // = false        // [BETA] Defer generating vertices of lines and filled shapes (ImDrawList::AddPolyline/AddConvexPolyFilled) to Render(), where each draw list can be processed on a worker thread via io.ParallelForFn.
+    bool        ConfigDrawDataMerge;            // = false          // [BETA] At the end of Render(), copy all draw lists into as few ImDrawList as possible, joining consecutive draw commands which use the same texture and compatible clipping rectangles. Fewer draw calls for any renderer backend, for the cost of copying vertices/indices. Draw lists with user callbacks are left untouched.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -1556,6 +1596,12 @@ struct ImGuiIO
     void        (*ImeSetInputScreenPosFn)(int x, int y);
     void*       ImeWindowHandle;                // = NULL           // (Windows) Set this to your HWND to get automatic IME cursor positioning.
 
+    // Optional: Run independent jobs on your worker threads (e.g. tessellation of draw lists when io.ConfigDrawListsDeferTessellation is set, ImGuiTextFilter::PassFilterLines())
+    // Your function must call job_fn(job_user_data, n) for every n in [0, jobs_count) and only return once all calls have completed.
+    // Jobs don't call any ImGui:: function nor allocate memory. Leave to NULL to run jobs sequentially on the calling thread.
+    ImGuiParallelForFn ParallelForFn;
+    void*       ParallelForUserData;
+
     //------------------------------------------------------------------
     // Input - Fill before calling NewFrame()
     //------------------------------------------------------------------
@@ -1700,6 +1746,16 @@ struct ImGuiPayload
     bool IsDelivery() const                 { return Delivery; }
 };
 
+// Allocation statistics for a category of memory allocations: GetMemTagStats()
+// Only updated when IMGUI_ENABLE_MEMORY_TAGS is defined in imconfig.h.
+struct ImGuiMemTagStats
+{
+    size_t          LiveBytes;          // Bytes currently allocated
+    size_t          PeakBytes;          // Highest value of LiveBytes since startup
+    int             LiveCount;          // Number of allocations currently alive
+    int             TotalCount;         // Number of allocations since startup
+};
+
 //-----------------------------------------------------------------------------
 // Obsolete functions (Will be removed! Read 'API BREAKING CHANGES' section in imgui.cpp for details)
 // Please keep your copy of dear imgui up to date! Occasionally set '#define IMGUI_DISABLE_OBSOLETE_FUNCTIONS' in imconfig.h to stay ahead.
@@ -1771,8 +1827,11 @@ struct ImGuiTextFilter
     IMGUI_API           ImGuiTextFilter(const char* default_filter = "");
     IMGUI_API bool      Draw(const char* label = "Filter (inc,-exc)", float width = 0.0f);  // Helper calling InputText+Build
     IMGUI_API bool      PassFilter(const char* text, const char* text_end = NULL) const;
+    IMGUI_API int       PassFilterLines(const char* const* lines, int lines_count, ImU32* out_bits, int stride = 2 * (int)sizeof(const char*)) const; // PassFilter() every line: 'lines' points to the begin/end pointers of the first line, 'stride' bytes apart. Set bit n of out_bits[(lines_count + 31) / 32] for each passing line n. Return number of passing lines. Large arrays are split into io.ParallelForFn jobs.
+    IMGUI_API const ImVector<int>& PassFilterLinesCached(const char* const* lines, int lines_count, int stride = 2 * (int)sizeof(const char*), int lines_base = 0); // Same input as PassFilterLines(), return indices of passing lines (e.g. to use with ImGuiListClipper). Results are kept: when the filter was only narrowed since last call (include term extended e.g. "err" -> "error", or exclude terms appended), only previous matches are tested again. Lines added since last call are tested. 'lines_base' = number of lines removed from the front since the buffer was cleared (pass ImGuiTextLineBuffer::LinesDiscarded when using MaxLines): cached indices are shifted accordingly. Call ClearCache() if lines already tested were otherwise modified or removed.
     IMGUI_API void      Build();
     void                Clear()          { InputBuf[0] = 0; Build(); }
+    void                ClearCache()     { CacheInputBuf.clear(); CacheMatches.clear(); CacheLinesCount = CacheLinesBase = 0; }
     bool                IsActive() const { return !Filters.empty(); }
 
     // [Internal]
@@ -1789,6 +1848,10 @@ struct ImGuiTextFilter
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
+    ImVector<char>          CacheInputBuf;      // Copy of InputBuf used to compute CacheMatches (empty if no cache)
+    ImVector<int>           CacheMatches;       // Indices of passing lines, returned by PassFilterLinesCached()
+    int                     CacheLinesCount;    // Number of lines tested to compute CacheMatches
+    int                     CacheLinesBase;     // 'lines_base' of the last call: lines removed from the front since then are removed from CacheMatches
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -1812,10 +1875,65 @@ struct ImGuiTextBuffer
     IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
 };
 
+// Helper: Append-only text buffer indexed by lines, for logs
+// - Text is stored in chunks of ChunkSize bytes: growing never moves or copies existing text, only the current unterminated line
+//   when it doesn't fit in the current chunk. Pointers to lines stay valid until the lines are discarded.
+// - Each line has an optional UserData value (e.g. a severity level or a color), set to 0 when the line is created.
+// - When MaxLines > 0, adding a line beyond MaxLines discards the oldest line in O(1) (chunks are released once all their lines are discarded).
+// Usage:
+//   static ImGuiTextLineBuffer log(64 * 1024, 100000);   // Keep the last 100k lines
+//   log.appendf("[%05d] Hello\n", frame);
+//   ImGuiListClipper clipper;
+//   clipper.Begin(log.size());
+//   while (clipper.Step())
+//       for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//           ImGui::TextUnformatted(log[i].Begin, log[i].End);
+struct ImGuiTextLineBuffer
+{
+    struct Line
+    {
+        const char*     Begin;
+        const char*     End;            // Excluding the '\n' terminator (text is not zero-terminated)
+        ImU32           UserData;
+    };
+    struct Chunk
+    {
+        char*           Data;
+        int             Size;
+        int             Capacity;
+    };
+    ImVector<Chunk>     Chunks;         // Chunks[0] holds the oldest kept line
+    ImVector<Line>      Lines;          // Kept lines are Lines[LinesFirst] to Lines.back()
+    int                 LinesFirst;
+    int                 LinesDiscarded; // Lines discarded since the last clear(), because of MaxLines. Add to an index to get a stable line number.
+    int                 MaxLines;       // 0: unlimited
+    int                 ChunkSize;      // Capacity of new chunks. Lines longer than this get a chunk of their own.
+    bool                LastLineOpen;   // Last line isn't terminated by '\n': next append continues it
+    char*               SpareChunk;     // Released chunk of ChunkSize bytes, reused by the next chunk allocation
+
+    ImGuiTextLineBuffer(int chunk_size = 64 * 1024, int max_lines = 0) { LinesFirst = LinesDiscarded = 0; MaxLines = max_lines; ChunkSize = chunk_size; LastLineOpen = false; SpareChunk = NULL; }
+    ImGuiTextLineBuffer(const ImGuiTextLineBuffer& src) { LinesFirst = LinesDiscarded = 0; MaxLines = 0; ChunkSize = src.ChunkSize; LastLineOpen = false; SpareChunk = NULL; *this = src; }
+    ~ImGuiTextLineBuffer()              { clear(); }
+    IMGUI_API ImGuiTextLineBuffer& operator=(const ImGuiTextLineBuffer& src);   // Copy kept lines and their UserData into new chunks
+    Line&               operator[](int i)       { IM_ASSERT(i >= 0 && i < size()); return Lines.Data[LinesFirst + i]; }
+    const Line&         operator[](int i) const { IM_ASSERT(i >= 0 && i < size()); return Lines.Data[LinesFirst + i]; }
+    int                 size() const            { return Lines.Size - LinesFirst; }   // Number of lines, including the last unterminated one
+    bool                empty() const           { return Lines.Size == LinesFirst; }
+    IMGUI_API void      clear();                                    // Release all memory
+    IMGUI_API void      append(const char* str, const char* str_end = NULL);
+    IMGUI_API void      appendf(const char* fmt, ...) IM_FMTARGS(2);
+    IMGUI_API void      appendfv(const char* fmt, va_list args) IM_FMTLIST(2);
+    IMGUI_API char*     _PrepareWrite(int len);                     // [Internal]
+    IMGUI_API void      _CommitWrite(char* p, int len);             // [Internal]
+    IMGUI_API void      _ReleaseChunk(char* data, int capacity);    // [Internal]
+};
+
 // Helper: Key->Value storage
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// With '#define IMGUI_USE_HASHED_STORAGE' in imconfig.h, pairs are stored in insertion order and indexed by an open-addressing hash table instead,
+// making insertion O(1) (useful with e.g. tens of thousands of tree nodes). The API is identical, but Data[] is not sorted by key.
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -1833,11 +1951,19 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_USE_HASHED_STORAGE
+    struct ImGuiStorageSlot { ImGuiID key; int idx; };  // idx = Index into Data[], -1 if slot is empty
+    ImVector<ImGuiStorageSlot>      Slots;              // Open-addressing (Robin Hood, linear probing) hash table, size is 0 or a power of two
+#endif
 
     // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+#ifdef IMGUI_USE_HASHED_STORAGE
+    void                Clear() { Data.clear(); Slots.clear(); }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -1860,6 +1986,7 @@ struct ImGuiStorage
     IMGUI_API void      SetAllInt(int val);
 
     // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // (with IMGUI_USE_HASHED_STORAGE: this rebuilds the hash table, which is also required after modifying Data[] directly)
     IMGUI_API void      BuildSortByKey();
 };
 
@@ -1880,6 +2007,7 @@ struct ImGuiStorage
 // - Clipper can measure the height of the first element
 // - Clipper calculate the actual range of elements to display based on the current clipping rectangle, position the cursor before the first visible element.
 // - User code submit visible elements.
+// For items of different heights, use BeginWithHeights() with a persistent ImGuiListClipperHeights instance (see below).
 struct ImGuiListClipper
 {
     int     DisplayStart;
@@ -1890,6 +2018,10 @@ struct ImGuiListClipper
     int     StepNo;
     float   ItemsHeight;
     float   StartPosY;
+    ImGuiListClipperHeights* ItemsHeights;  // Set by BeginWithHeights()
+    float   ItemPosY;                       // With ItemsHeights: position of the item being submitted, to measure it
+    float   ClipMaxY;                       // With ItemsHeights: submit items until reaching this position
+    int     ClipExtraItems;                 // With ItemsHeights: number of items to submit past ClipMaxY (for navigation)
 
     IMGUI_API ImGuiListClipper();
     IMGUI_API ~ImGuiListClipper();
@@ -1899,12 +2031,40 @@ struct ImGuiListClipper
     IMGUI_API void Begin(int items_count, float items_height = -1.0f);  // Automatically called by constructor if you passed 'items_count' or by Step() in Step 1.
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool Step();                                              // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
+    IMGUI_API void BeginWithHeights(ImGuiListClipperHeights* heights);  // Clip heights->Heights.Size items of variable heights. Step() then yields visible items one at a time and measures them.
 
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     inline ImGuiListClipper(int items_count, float items_height = -1.0f) { memset(this, 0, sizeof(*this)); ItemsCount = -1; Begin(items_count, items_height); } // [removed in 1.79]
 #endif
 };
 
+// Helper: Heights of a list of variable-height items, for ImGuiListClipper::BeginWithHeights(). Keep an instance alive alongside your list.
+// Heights are indexed with a Fenwick tree (binary indexed tree) so the first visible item can be located in O(log N), which makes lists of millions of items practical.
+// The clipper measures items when they are displayed and updates their height. Items that were never displayed use DefaultHeight, so the scrollbar is an estimate until then.
+// Usage:
+//   static ImGuiListClipperHeights heights;
+//   heights.Resize(items_count);                 // Add/remove items at the end of the list. Call SetHeight() if you know the height of an item.
+//   ImGuiListClipper clipper;
+//   clipper.BeginWithHeights(&heights);
+//   while (clipper.Step())
+//       for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+//           ImGui::TextWrapped("%s", items[i]);
+struct ImGuiListClipperHeights
+{
+    ImVector<float>     Heights;            // Height of each item, including item spacing (distance between the top of an item and the top of the next one)
+    ImVector<double>    Tree;               // [Internal] Fenwick tree of Heights[], 1-based (Tree[0] is unused)
+    float               DefaultHeight;      // Height of items which have not been measured. Set to GetTextLineHeightWithSpacing() by Resize() if <= 0.0f.
+
+    ImGuiListClipperHeights(float default_height = 0.0f) { DefaultHeight = default_height; }
+    void                Clear()             { Heights.clear(); Tree.clear(); }
+    IMGUI_API void      Resize(int items_count);                    // New items use DefaultHeight. O(log N) per added item.
+    IMGUI_API void      SetHeight(int item_idx, float height);      // O(log N)
+    IMGUI_API void      Build();                                    // Rebuild the index after writing into Heights[] directly. O(N)
+    IMGUI_API float     GetOffset(int item_idx) const;              // Sum of the heights of items [0, item_idx). O(log N)
+    IMGUI_API int       FindItemAtOffset(float offset) const;       // Index of the item covering 'offset', clamped to valid items. O(log N)
+    float               GetTotalHeight() const { return GetOffset(Heights.Size); }
+};
+
 // Helpers macros to generate 32-bit encoded colors
 #ifdef IMGUI_USE_BGRA_PACKED_COLOR
 #define IM_COL32_R_SHIFT    16
@@ -2021,6 +2181,20 @@ struct ImDrawCmdHeader
     unsigned int    VtxOffset;
 };
 
+// [Internal] For use by ImDrawList when ImDrawListFlags_DeferTessellation is set.
+// Indices are written immediately (as ImDrawListSplitter may swap IdxBuffer), vertices are written by ImDrawList::_TessellateDeferred().
+struct ImDrawDeferredPrim
+{
+    int                 VtxOffset;      // Offset of the reserved vertices in VtxBuffer
+    int                 PointsOffset;   // Offset of the points in _DeferredPoints
+    int                 PointsCount;
+    ImU32               Col;
+    float               Thickness;
+    ImDrawListFlags     Flags;          // Draw list flags at the time the primitive was added
+    bool                Closed;         // AddPolyline() only
+    bool                Filled;         // true for AddConvexPolyFilled(), false for AddPolyline()
+};
+
 // [Internal] For use by ImDrawListSplitter
 struct ImDrawChannel
 {
@@ -2067,7 +2241,10 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLines        = 1 << 0,  // Enable anti-aliased lines/borders (*2 the number of triangles for 1.0f wide line or lines thin enough to be drawn using textures, otherwise *3 the number of triangles)
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering.
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
-    ImDrawListFlags_AllowVtxOffset          = 1 << 3   // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+    ImDrawListFlags_DeferTessellation       = 1 << 4,  // AddPolyline()/AddConvexPolyFilled() write indices immediately but record vertices generation for a later call to _TessellateDeferred(). Set when 'io.ConfigDrawListsDeferTessellation' is enabled.
+    ImDrawListFlags_HashCommands            = 1 << 5,  // Hash parameters of drawing commands into _CommandsHash. Vertices written directly after PrimReserve() are not hashed. Set for windows using ImGuiWindowFlags_RetainDrawList.
+    ImDrawListFlags_HashOnly                = 1 << 6   // Only hash drawing commands: CmdBuffer/IdxBuffer/VtxBuffer are left untouched. Set by _ResetForNewFrameHashed().
 };
 
 // Draw command list
@@ -2097,6 +2274,12 @@ struct ImDrawList
     ImVector<ImVec2>        _Path;              // [Internal] current path building
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
+    ImVector<ImDrawDeferredPrim> _DeferredPrims; // [Internal] primitives waiting for their vertices to be generated (ImDrawListFlags_DeferTessellation)
+    ImVector<ImVec2>        _DeferredPoints;    // [Internal] points storage for _DeferredPrims
+    ImU32                   _CommandsHash;      // [Internal] hash of drawing commands submitted this frame (ImDrawListFlags_HashCommands)
+    unsigned int            _HashOnlyVtxCurrentIdx; // [Internal] backup of _VtxCurrentIdx while ImDrawListFlags_HashOnly is set
+    ImVector<ImDrawVert>    _HashOnlyVtxScratch;    // [Internal] PrimReserve() output while ImDrawListFlags_HashOnly is set (discarded)
+    ImVector<ImDrawIdx>     _HashOnlyIdxScratch;    // [Internal]
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
     ImDrawList(const ImDrawListSharedData* shared_data) { memset(this, 0, sizeof(*this)); _Data = shared_data; }
@@ -2182,11 +2365,14 @@ struct ImDrawList
 
     // [Internal helpers]
     IMGUI_API void  _ResetForNewFrame();
+    IMGUI_API void  _ResetForNewFrameHashed(bool hash_only);  // Reset and set ImDrawListFlags_HashCommands. With 'hash_only', buffers of the previous frame are left untouched and ImDrawListFlags_HashOnly is set.
+    IMGUI_API void  _EndHashOnly();             // Restore write pointers after a frame using ImDrawListFlags_HashOnly, so buffers of the previous frame can be rendered again.
     IMGUI_API void  _ClearFreeMemory();
     IMGUI_API void  _PopUnusedDrawCmd();
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
+    IMGUI_API void  _TessellateDeferred();      // Generate vertices of all primitives recorded with ImDrawListFlags_DeferTessellation. Safe to call on a worker thread (one thread per draw list).
 };
 
 // All draw data to render a Dear ImGui frame
@@ -2282,13 +2468,21 @@ struct ImFontAtlasCustomRect
     bool IsPacked() const           { return X != 0xFFFF; }
 };
 
+// Region of the font atlas texture modified after it was built. See ImFontAtlas::TexDirtyRects.
+struct ImFontAtlasRect
+{
+    unsigned short  X, Y;
+    unsigned short  Width, Height;
+};
+
 // Flags for ImFontAtlas build
 enum ImFontAtlasFlags_
 {
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3    // [BETA] Only rasterize glyphs in the 0x0000-0x00FF range in Build(), other glyphs are rasterized on demand when first used. stb_truetype builder only. See BuildDynamicGlyphs().
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2334,6 +2528,36 @@ struct ImFontAtlas
     bool                        IsBuilt() const             { return Fonts.Size > 0 && (TexPixelsAlpha8 != NULL || TexPixelsRGBA32 != NULL); }
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // [BETA] Incremental texture updates (ImGuiBackendFlags_RendererHasTexUpdates)
+    // Regions of the texture modified after Build() are recorded into TexDirtyRects[]. Backends supporting ImGuiBackendFlags_RendererHasTexUpdates
+    // upload those regions from the CPU pixel data (same format as initially uploaded) before rendering, then call ClearTexDirtyRects().
+    // Rectangles are merged when it doesn't waste much area, and collapsed into their bounding box when there are too many of them.
+    IMGUI_API void              AddTexDirtyRect(int x, int y, int w, int h);    // Mark a region of the texture as modified, e.g. after writing into a custom rectangle once the texture was uploaded.
+    void                        ClearTexDirtyRects()        { TexDirtyRects.resize(0); }
+
+    // [BETA] Dynamic glyphs (ImFontAtlasFlags_DynamicGlyphs)
+    // Glyphs of the requested ranges which are missing when calling ImFont::FindGlyph() are queued, then rasterized into the free space
+    // of the texture by BuildDynamicGlyphs(), which is called by ImGui::EndFrame(): they become visible on the next frame.
+    // The texture size is fixed at Build() time (TexDesiredWidth x TexDesiredWidth, defaults to 1024x1024): glyphs which don't fit use the fallback
+    // character and are counted in DynamicGlyphsMissingCount (also shown in Metrics). They are retried when used again, but only a Build() frees space.
+    // - Keep CPU pixel data (don't call ClearTexData()) and font data (if FontDataOwnedByAtlas=false) alive.
+    // - EndFrame() only rasterizes glyphs if the renderer backend sets ImGuiBackendFlags_RendererHasTexUpdates (see TexDirtyRects[]).
+    IMGUI_API bool              BuildDynamicGlyphs();       // Rasterize queued glyphs. Return true if the texture was modified.
+
+    // [BETA] Pre-built atlas cache
+    // Save the output of Build() (Alpha8 texture, glyphs, lookup tables, custom rectangles positions) so next launches can skip building:
+    //     if (!io.Fonts->LoadBuildCacheFromFile("fonts.cache")) { io.Fonts->Build(); io.Fonts->SaveBuildCacheToFile("fonts.cache"); }
+    // Loading returns false (and leaves the atlas unbuilt) if the data doesn't match the current input: fonts data, ImFontConfig fields, custom rectangles, flags.
+    // - Data is specific to the builder (stb_truetype or FreeType + flags) and to the machine endianness: use a different file per builder.
+    // - Pixels you write into custom rectangles are not saved: write them after loading, same as after Build().
+    // - LoadBuildCacheFromMemory() copies what it needs: you may memory-map the file and unmap it after the call.
+    // - Not supported with ImFontAtlasFlags_DynamicGlyphs.
+    IMGUI_API bool              LoadBuildCacheFromFile(const char* filename);
+    IMGUI_API bool              LoadBuildCacheFromMemory(const void* data, size_t data_size);
+    IMGUI_API bool              SaveBuildCacheToFile(const char* filename);
+    IMGUI_API bool              SaveBuildCacheToMemory(ImVector<unsigned char>* out_data);
+    IMGUI_API ImU32             CalcBuildCacheHash();       // Hash of the input data, stored in the cache to validate it.
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -2377,6 +2601,8 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
+    ImGuiParallelForFn          ParallelForFn;      // Optional: rasterize glyphs on your worker threads during Build() (see ImGuiIO::ParallelForFn). Output is identical to a single-threaded build. Jobs allocate memory: functions passed to SetAllocatorFunctions() need to be thread-safe (imgui_freetype rasterizes glyphs serially when ImGuiFreeType::SetAllocatorFunctions() was called).
+    void*                       ParallelForUserData;
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
@@ -2395,6 +2621,12 @@ struct ImFontAtlas
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
     int                         PackIdLines;        // Custom texture rectangle ID for baked anti-aliased lines
 
+    // [Internal] Texture updates, Dynamic glyphs
+    ImVector<ImFontAtlasRect>   TexDirtyRects;      // Texture regions modified since last call to ClearTexDirtyRects(). Cleared by Build().
+    void*                       DynamicGlyphsData;  // Builder state kept after Build() with ImFontAtlasFlags_DynamicGlyphs (opaque)
+    int                         DynamicGlyphsMissingCount; // Number of requested glyphs which didn't fit in the texture since Build(). If > 0, increase TexDesiredWidth and call Build() again.
+    int                         GlyphsVersion;      // Incremented every time glyphs are added or rebuilt (Build(), BuildDynamicGlyphs(), LoadBuildCacheFromMemory()), to invalidate data derived from glyphs metrics
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     typedef ImFontAtlasCustomRect    CustomRect;         // OBSOLETED in 1.72+
     typedef ImFontGlyphRangesBuilder GlyphRangesBuilder; // OBSOLETED in 1.67+
@@ -2430,7 +2662,7 @@ struct ImFont
     // Methods
     IMGUI_API ImFont();
     IMGUI_API ~ImFont();
-    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;
+    IMGUI_API const ImFontGlyph*FindGlyph(ImWchar c) const;   // With ImFontAtlasFlags_DynamicGlyphs, a missing glyph is queued into the atlas for rasterization (not thread-safe, don't call while building)
     IMGUI_API const ImFontGlyph*FindGlyphNoFallback(ImWchar c) const;
     float                       GetCharAdvance(ImWchar c) const     { return ((int)c < IndexAdvanceX.Size) ? IndexAdvanceX[(int)c] : FallbackAdvanceX; }
     bool                        IsLoaded() const                    { return ContainerAtlas != NULL; }
@@ -2452,6 +2684,7 @@ struct ImFont
     IMGUI_API void              SetGlyphVisible(ImWchar c, bool visible);
     IMGUI_API void              SetFallbackChar(ImWchar c);
     IMGUI_API bool              IsGlyphRangeUnused(unsigned int c_begin, unsigned int c_last);
+    IMGUI_API ImVec2            CalcTextSizeEx(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVector<int>* out_line_breaks) const; // Also output word-wrapping positions (offsets from text_begin)
 };
 
 #if defined(__clang__)
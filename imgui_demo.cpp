@@ -404,6 +404,10 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::Checkbox("io.ConfigWindowsResizeFromEdges", &io.ConfigWindowsResizeFromEdges);
             ImGui::SameLine(); HelpMarker("Enable resizing of windows from their edges and from the lower-left corner.\nThis requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback.");
             ImGui::Checkbox("io.ConfigWindowsMoveFromTitleBarOnly", &io.ConfigWindowsMoveFromTitleBarOnly);
+            ImGui::Checkbox("io.ConfigDrawListsDeferTessellation", &io.ConfigDrawListsDeferTessellation);
+            ImGui::SameLine(); HelpMarker("Generate vertices of lines and filled shapes in Render(), one job per draw list.\nSet io.ParallelForFn to run those jobs on your worker threads.");
+            ImGui::Checkbox("io.ConfigDrawDataMerge", &io.ConfigDrawDataMerge);
+            ImGui::SameLine(); HelpMarker("Copy all draw lists into as few draw lists as possible at the end of Render(), joining consecutive draw commands using the same texture and compatible clipping rectangles.\nSee draw command counts in Metrics.");
             ImGui::Checkbox("io.MouseDrawCursor", &io.MouseDrawCursor);
             ImGui::SameLine(); HelpMarker("Instruct Dear ImGui to render a mouse cursor itself. Note that a mouse cursor rendered via your application GPU rendering path will feel more laggy than hardware cursor, but will be more in sync with your other visuals.\n\nSome desktop applications may use both kinds of cursors (e.g. enable software cursor only when resizing/dragging something).");
             ImGui::Text("Also see Style->Rendering for rendering options.");
@@ -423,6 +427,7 @@ void ImGui::ShowDemoWindow(bool* p_open)
             ImGui::CheckboxFlags("io.BackendFlags: HasMouseCursors",      &backend_flags, ImGuiBackendFlags_HasMouseCursors);
             ImGui::CheckboxFlags("io.BackendFlags: HasSetMousePos",       &backend_flags, ImGuiBackendFlags_HasSetMousePos);
             ImGui::CheckboxFlags("io.BackendFlags: RendererHasVtxOffset", &backend_flags, ImGuiBackendFlags_RendererHasVtxOffset);
+            ImGui::CheckboxFlags("io.BackendFlags: RendererHasTexUpdates", &backend_flags, ImGuiBackendFlags_RendererHasTexUpdates);
             ImGui::TreePop();
             ImGui::Separator();
         }
@@ -1168,6 +1173,7 @@ static void ShowDemoWindowWidgets()
             ImGui::CheckboxFlags("ImGuiInputTextFlags_ReadOnly", &flags, ImGuiInputTextFlags_ReadOnly);
             ImGui::CheckboxFlags("ImGuiInputTextFlags_AllowTabInput", &flags, ImGuiInputTextFlags_AllowTabInput);
             ImGui::CheckboxFlags("ImGuiInputTextFlags_CtrlEnterForNewLine", &flags, ImGuiInputTextFlags_CtrlEnterForNewLine);
+            ImGui::CheckboxFlags("ImGuiInputTextFlags_LargeBuffer", &flags, ImGuiInputTextFlags_LargeBuffer); ImGui::SameLine(); HelpMarker("Edit through a gap buffer and a line index. Use for multi-megabyte text: the cost of typing and scrolling doesn't depend on the text size.");
             ImGui::InputTextMultiline("##source", text, IM_ARRAYSIZE(text), ImVec2(-FLT_MIN, ImGui::GetTextLineHeight() * 16), flags);
             ImGui::TreePop();
         }
@@ -3687,11 +3693,15 @@ void ImGui::ShowAboutWindow(bool* p_open)
         if (io.ConfigWindowsResizeFromEdges)                            ImGui::Text("io.ConfigWindowsResizeFromEdges");
         if (io.ConfigWindowsMoveFromTitleBarOnly)                       ImGui::Text("io.ConfigWindowsMoveFromTitleBarOnly");
         if (io.ConfigMemoryCompactTimer >= 0.0f)                        ImGui::Text("io.ConfigMemoryCompactTimer = %.1f", io.ConfigMemoryCompactTimer);
+        if (io.ConfigDrawListsDeferTessellation)                        ImGui::Text("io.ConfigDrawListsDeferTessellation");
+        if (io.ConfigDrawDataMerge)                                     ImGui::Text("io.ConfigDrawDataMerge");
+        if (io.ParallelForFn)                                           ImGui::Text("io.ParallelForFn");
         ImGui::Text("io.BackendFlags: 0x%08X", io.BackendFlags);
         if (io.BackendFlags & ImGuiBackendFlags_HasGamepad)             ImGui::Text(" HasGamepad");
         if (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors)        ImGui::Text(" HasMouseCursors");
         if (io.BackendFlags & ImGuiBackendFlags_HasSetMousePos)         ImGui::Text(" HasSetMousePos");
         if (io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)   ImGui::Text(" RendererHasVtxOffset");
+        if (io.BackendFlags & ImGuiBackendFlags_RendererHasTexUpdates)  ImGui::Text(" RendererHasTexUpdates");
         ImGui::Separator();
         ImGui::Text("io.Fonts: %d fonts, Flags: 0x%08X, TexSize: %d,%d", io.Fonts->Fonts.Size, io.Fonts->Flags, io.Fonts->TexWidth, io.Fonts->TexHeight);
         ImGui::Text("io.DisplaySize: %.2f,%.2f", io.DisplaySize.x, io.DisplaySize.y);
@@ -4574,9 +4584,8 @@ static void ShowExampleAppConsole(bool* p_open)
 //  my_log.Draw("title");
 struct ExampleAppLog
 {
-    ImGuiTextBuffer     Buf;
+    ImGuiTextLineBuffer Buf;         // Text stored in chunks and indexed by lines. Appending never copies existing text.
     ImGuiTextFilter     Filter;
-    ImVector<int>       LineOffsets; // Index to lines offset. We maintain this with AddLog() calls.
     bool                AutoScroll;  // Keep scrolling if already at the bottom.
 
     ExampleAppLog()
@@ -4588,20 +4597,15 @@ struct ExampleAppLog
     void    Clear()
     {
         Buf.clear();
-        LineOffsets.clear();
-        LineOffsets.push_back(0);
+        Filter.ClearCache();
     }
 
     void    AddLog(const char* fmt, ...) IM_FMTARGS(2)
     {
-        int old_size = Buf.size();
         va_list args;
         va_start(args, fmt);
         Buf.appendfv(fmt, args);
         va_end(args);
-        for (int new_size = Buf.size(); old_size < new_size; old_size++)
-            if (Buf[old_size] == '\n')
-                LineOffsets.push_back(old_size + 1);
     }
 
     void    Draw(const char* title, bool* p_open = NULL)
@@ -4638,26 +4642,29 @@ struct ExampleAppLog
             ImGui::LogToClipboard();
 
         ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
-        const char* buf = Buf.begin();
-        const char* buf_end = Buf.end();
         if (Filter.IsActive())
         {
-            // In this example we don't use the clipper when Filter is enabled.
-            // This is because we don't have a random access on the result on our filter.
-            // A real application processing logs with ten of thousands of entries may want to store the result of
-            // search/filter.. especially if the filtering function is not trivial (e.g. reg-exp).
-            for (int line_no = 0; line_no < LineOffsets.Size; line_no++)
+            // PassFilterLinesCached() returns the indices of the lines passing the filter, which gives us random access
+            // into the result and lets us use the clipper. Results are cached: when typing more characters into the
+            // filter (e.g. "err" -> "erro") only the lines which passed the previous filter are tested again, and on
+            // following frames only the newly added lines are tested.
+            const ImVector<int>& matches = Filter.PassFilterLinesCached(Buf.empty() ? NULL : &Buf[0].Begin, Buf.size(), (int)sizeof(ImGuiTextLineBuffer::Line), Buf.LinesDiscarded);
+            ImGuiListClipper clipper;
+            clipper.Begin(matches.Size);
+            while (clipper.Step())
             {
-                const char* line_start = buf + LineOffsets[line_no];
-                const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                if (Filter.PassFilter(line_start, line_end))
-                    ImGui::TextUnformatted(line_start, line_end);
+                for (int match_no = clipper.DisplayStart; match_no < clipper.DisplayEnd; match_no++)
+                {
+                    const ImGuiTextLineBuffer::Line& line = Buf[matches[match_no]];
+                    ImGui::TextUnformatted(line.Begin, line.End);
+                }
             }
+            clipper.End();
         }
         else
         {
-            // The simplest and easy way to display the entire buffer:
-            //   ImGui::TextUnformatted(buf_begin, buf_end);
+            // The simplest and easy way to display a whole ImGuiTextBuffer:
+            //   ImGui::TextUnformatted(buf.begin(), buf.end());
             // And it'll just work. TextUnformatted() has specialization for large blob of text and will fast-forward
             // to skip non-visible lines. Here we instead demonstrate using the clipper to only process lines that are
             // within the visible area.
@@ -4665,19 +4672,15 @@ struct ExampleAppLog
             // on your side is recommended. Using ImGuiListClipper requires
             // - A) random access into your data
             // - B) items all being the  same height,
-            // both of which we can handle since we an array pointing to the beginning of each line of text.
-            // When using the filter (in the block of code above) we don't have random access into the data to display
-            // anymore, which is why we don't use the clipper. Storing or skimming through the search result would make
-            // it possible (and would be recommended if you want to search through tens of thousands of entries).
+            // both of which we can handle since ImGuiTextLineBuffer gives access to each line of text.
             ImGuiListClipper clipper;
-            clipper.Begin(LineOffsets.Size);
+            clipper.Begin(Buf.size());
             while (clipper.Step())
             {
                 for (int line_no = clipper.DisplayStart; line_no < clipper.DisplayEnd; line_no++)
                 {
-                    const char* line_start = buf + LineOffsets[line_no];
-                    const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                    ImGui::TextUnformatted(line_start, line_end);
+                    const ImGuiTextLineBuffer::Line& line = Buf[line_no];
+                    ImGui::TextUnformatted(line.Begin, line.End);
                 }
             }
             clipper.End();
@@ -4885,7 +4888,8 @@ static void ShowExampleAppLongText(bool* p_open)
     ImGui::Combo("Test type", &test_type,
         "Single call to TextUnformatted()\0"
         "Multiple calls to Text(), clipped\0"
-        "Multiple calls to Text(), not clipped (slow)\0");
+        "Multiple calls to Text(), not clipped (slow)\0"
+        "Multiple calls to TextWrapped(), variable heights, clipped\0");
     ImGui::Text("Buffer contents: %d lines, %d bytes", lines, log.size());
     if (ImGui::Button("Clear")) { log.clear(); lines = 0; }
     ImGui::SameLine();
@@ -4921,6 +4925,21 @@ static void ShowExampleAppLongText(bool* p_open)
             ImGui::Text("%i The quick brown fox jumps over the lazy dog", i);
         ImGui::PopStyleVar();
         break;
+    case 3:
+        {
+            // Multiple calls to TextWrapped() with items of different heights - demonstrate how to use ImGuiListClipperHeights.
+            // Heights are measured by the clipper when items are displayed (e.g. they change when resizing the window),
+            // items which have never been displayed are assumed to be a single line.
+            static ImGuiListClipperHeights heights;
+            heights.Resize(lines);
+            ImGuiListClipper clipper;
+            clipper.BeginWithHeights(&heights);
+            while (clipper.Step())
+                for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+                    ImGui::TextWrapped("%i The quick brown fox jumps over the lazy dog%s", i,
+                        (i % 5 == 0) ? ". The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog." : "");
+            break;
+        }
     }
     ImGui::EndChild();
     ImGui::End();
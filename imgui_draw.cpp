@@ -133,8 +133,8 @@ namespace IMGUI_STB_NAMESPACE
 
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+#define STBTT_malloc(x,u)   ((u) ? ((ImFontAtlasBuildAllocator*)(u))->Alloc(x) : IM_ALLOC(x))   // 'u' is set by build jobs (see ImFontAtlasBuildAllocator)
+#define STBTT_free(x,u)     ((u) ? ((ImFontAtlasBuildAllocator*)(u))->Free(x) : IM_FREE(x))
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -368,6 +368,59 @@ void ImDrawListSharedData::SetCircleSegmentMaxError(float max_error)
     }
 }
 
+// Drawing commands hashing (ImDrawListFlags_HashCommands), used by windows with ImGuiWindowFlags_RetainDrawList.
+// Commands are hashed in functions which don't call other hashing functions and which are called the same way
+// whether the draw list is being built or only hashed (ImDrawListFlags_HashOnly), so both modes output the same hash.
+enum ImDrawListHashCmd
+{
+    ImDrawListHashCmd_ClipRect,
+    ImDrawListHashCmd_TextureId,
+    ImDrawListHashCmd_Callback,
+    ImDrawListHashCmd_Polyline,
+    ImDrawListHashCmd_ConvexPolyFilled,
+    ImDrawListHashCmd_PrimRect,
+    ImDrawListHashCmd_PrimRectUV,
+    ImDrawListHashCmd_PrimQuadUV,
+    ImDrawListHashCmd_RectFilledMultiColor,
+    ImDrawListHashCmd_Text,
+    ImDrawListHashCmd_ShadeVertsColorGradient,
+    ImDrawListHashCmd_ShadeVertsUV,
+    ImDrawListHashCmd_ChannelsSplit,
+    ImDrawListHashCmd_ChannelsSetCurrent,
+    ImDrawListHashCmd_ChannelsMerge
+};
+
+// MurmurHash3 (32-bit) body, much faster than the byte-wise CRC32 of ImHashData() on large arrays of points.
+static ImU32 ImDrawList_HashBytes(const void* data, size_t data_size, ImU32 seed)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    ImU32 h = seed;
+    for (; data_size >= 4; data_size -= 4, p += 4)
+    {
+        ImU32 k;
+        memcpy(&k, p, 4);
+        k *= 0xCC9E2D51;
+        k = (k << 15) | (k >> 17);
+        k *= 0x1B873593;
+        h ^= k;
+        h = (h << 13) | (h >> 19);
+        h = h * 5 + 0xE6546B64;
+    }
+    for (; data_size > 0; data_size--, p++)
+        h = (h ^ *p) * 0x01000193;
+    return h;
+}
+
+static void ImDrawList_HashCommand(ImDrawList* draw_list, ImDrawListHashCmd cmd, ImU32 col, const void* params, size_t params_size, const void* data = NULL, size_t data_size = 0)
+{
+    const ImU32 header[2] = { (ImU32)cmd, col };
+    ImU32 hash = ImDrawList_HashBytes(header, sizeof(header), draw_list->_CommandsHash);
+    hash = ImDrawList_HashBytes(params, params_size, hash);
+    if (data_size > 0)
+        hash = ImDrawList_HashBytes(data, data_size, hash);
+    draw_list->_CommandsHash = hash;
+}
+
 // Initialize before use in a new frame. We always have a command ready in the buffer.
 void ImDrawList::_ResetForNewFrame()
 {
@@ -389,9 +442,50 @@ void ImDrawList::_ResetForNewFrame()
     _TextureIdStack.resize(0);
     _Path.resize(0);
     _Splitter.Clear();
+    _DeferredPrims.resize(0);
+    _DeferredPoints.resize(0);
     CmdBuffer.push_back(ImDrawCmd());
 }
 
+// Initialize before use in a new frame, hashing all drawing commands.
+// With 'hash_only': CmdBuffer/IdxBuffer/VtxBuffer are left as they were at the end of the previous frame.
+// Nothing is output, the caller can compare _CommandsHash with the previous frame hash to decide if those buffers are still valid.
+void ImDrawList::_ResetForNewFrameHashed(bool hash_only)
+{
+    if (hash_only)
+    {
+        if (_DeferredPrims.Size > 0)
+            _TessellateDeferred();
+        Flags = _Data->InitialFlags | ImDrawListFlags_HashCommands | ImDrawListFlags_HashOnly;
+        memset(&_CmdHeader, 0, sizeof(_CmdHeader));
+        _HashOnlyVtxCurrentIdx = _VtxCurrentIdx;
+        _ClipRectStack.resize(0);
+        _TextureIdStack.resize(0);
+        _Path.resize(0);
+        _Splitter.Clear();
+    }
+    else
+    {
+        _ResetForNewFrame();
+        Flags |= ImDrawListFlags_HashCommands;
+    }
+
+    // Hash shared data affecting the output of drawing commands
+    const float params[] = { _Data->TexUvWhitePixel.x, _Data->TexUvWhitePixel.y, _Data->CurveTessellationTol, _Data->CircleSegmentMaxError };
+    _CommandsHash = 0;
+    ImDrawList_HashCommand(this, ImDrawListHashCmd_ClipRect, (ImU32)(Flags & ~ImDrawListFlags_HashOnly), params, sizeof(params));
+}
+
+void ImDrawList::_EndHashOnly()
+{
+    if (!(Flags & ImDrawListFlags_HashOnly))
+        return;
+    Flags &= ~ImDrawListFlags_HashOnly;
+    _VtxCurrentIdx = _HashOnlyVtxCurrentIdx;
+    _VtxWritePtr = VtxBuffer.Data + VtxBuffer.Size;
+    _IdxWritePtr = IdxBuffer.Data + IdxBuffer.Size;
+}
+
 void ImDrawList::_ClearFreeMemory()
 {
     CmdBuffer.clear();
@@ -405,10 +499,16 @@ void ImDrawList::_ClearFreeMemory()
     _TextureIdStack.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+    _DeferredPrims.clear();
+    _DeferredPoints.clear();
+    _HashOnlyVtxScratch.clear();
+    _HashOnlyIdxScratch.clear();
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
+    IM_ASSERT(_DeferredPrims.Size == 0 && "Call _TessellateDeferred() before cloning a draw list using ImDrawListFlags_DeferTessellation.");
     ImDrawList* dst = IM_NEW(ImDrawList(_Data));
     dst->CmdBuffer = CmdBuffer;
     dst->IdxBuffer = IdxBuffer;
@@ -419,6 +519,10 @@ ImDrawList* ImDrawList::CloneOutput() const
 
 void ImDrawList::AddDrawCmd()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
+    if (Flags & ImDrawListFlags_HashOnly)
+        return;
+
     ImDrawCmd draw_cmd;
     draw_cmd.ClipRect = _CmdHeader.ClipRect;    // Same as calling ImDrawCmd_HeaderCopy()
     draw_cmd.TextureId = _CmdHeader.TextureId;
@@ -442,6 +546,15 @@ void ImDrawList::_PopUnusedDrawCmd()
 
 void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        struct { ImDrawCallback Callback; void* CallbackData; } params = { callback, callback_data };
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_Callback, 0, &params, sizeof(params));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
+
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(curr_cmd->UserCallback == NULL);
     if (curr_cmd->ElemCount != 0)
@@ -524,6 +637,7 @@ void ImDrawList::_OnChangedVtxOffset()
 // Render-level scissoring. This is passed down to your render function but not used for CPU-side coarse clipping. Prefer using higher-level ImGui::PushClipRect() to affect logic (hit-testing and widget culling)
 void ImDrawList::PushClipRect(ImVec2 cr_min, ImVec2 cr_max, bool intersect_with_current_clip_rect)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     ImVec4 cr(cr_min.x, cr_min.y, cr_max.x, cr_max.y);
     if (intersect_with_current_clip_rect)
     {
@@ -538,6 +652,12 @@ void ImDrawList::PushClipRect(ImVec2 cr_min, ImVec2 cr_max, bool intersect_with_
 
     _ClipRectStack.push_back(cr);
     _CmdHeader.ClipRect = cr;
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_ClipRect, 0, &cr, sizeof(cr));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
     _OnChangedClipRect();
 }
 
@@ -550,13 +670,26 @@ void ImDrawList::PopClipRect()
 {
     _ClipRectStack.pop_back();
     _CmdHeader.ClipRect = (_ClipRectStack.Size == 0) ? _Data->ClipRectFullscreen : _ClipRectStack.Data[_ClipRectStack.Size - 1];
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_ClipRect, 1, &_CmdHeader.ClipRect, sizeof(_CmdHeader.ClipRect));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
     _OnChangedClipRect();
 }
 
 void ImDrawList::PushTextureID(ImTextureID texture_id)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     _TextureIdStack.push_back(texture_id);
     _CmdHeader.TextureId = texture_id;
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_TextureId, 0, &texture_id, sizeof(texture_id));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
     _OnChangedTextureID();
 }
 
@@ -564,6 +697,12 @@ void ImDrawList::PopTextureID()
 {
     _TextureIdStack.pop_back();
     _CmdHeader.TextureId = (_TextureIdStack.Size == 0) ? (ImTextureID)NULL : _TextureIdStack.Data[_TextureIdStack.Size - 1];
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_TextureId, 1, &_CmdHeader.TextureId, sizeof(_CmdHeader.TextureId));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
     _OnChangedTextureID();
 }
 
@@ -572,8 +711,19 @@ void ImDrawList::PopTextureID()
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
-    // Large mesh support (when enabled)
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
+    if (Flags & ImDrawListFlags_HashOnly)
+    {
+        // Buffers of the previous frame are left untouched: redirect writes to a scratch buffer
+        _HashOnlyVtxScratch.resize(vtx_count);
+        _HashOnlyIdxScratch.resize(idx_count);
+        _VtxWritePtr = _HashOnlyVtxScratch.Data;
+        _IdxWritePtr = _HashOnlyIdxScratch.Data;
+        return;
+    }
+
+    // Large mesh support (when enabled)
     if (sizeof(ImDrawIdx) == 2 && (_VtxCurrentIdx + vtx_count >= (1 << 16)) && (Flags & ImDrawListFlags_AllowVtxOffset))
     {
         // FIXME: In theory we should be testing that vtx_count <64k here.
@@ -599,6 +749,8 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
 {
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
+    if (Flags & ImDrawListFlags_HashOnly)
+        return;
 
     ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     draw_cmd->ElemCount -= idx_count;
@@ -609,6 +761,11 @@ void ImDrawList::PrimUnreserve(int idx_count, int vtx_count)
 // Fully unrolled with inline call to keep our debug builds decently fast.
 void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 {
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        const float params[] = { a.x, a.y, c.x, c.y };
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_PrimRect, col, params, sizeof(params));
+    }
     ImVec2 b(c.x, a.y), d(a.x, c.y), uv(_Data->TexUvWhitePixel);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
@@ -624,6 +781,11 @@ void ImDrawList::PrimRect(const ImVec2& a, const ImVec2& c, ImU32 col)
 
 void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a, const ImVec2& uv_c, ImU32 col)
 {
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        const float params[] = { a.x, a.y, c.x, c.y, uv_a.x, uv_a.y, uv_c.x, uv_c.y };
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_PrimRectUV, col, params, sizeof(params));
+    }
     ImVec2 b(c.x, a.y), d(a.x, c.y), uv_b(uv_c.x, uv_a.y), uv_d(uv_a.x, uv_c.y);
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
@@ -639,6 +801,11 @@ void ImDrawList::PrimRectUV(const ImVec2& a, const ImVec2& c, const ImVec2& uv_a
 
 void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d, const ImVec2& uv_a, const ImVec2& uv_b, const ImVec2& uv_c, const ImVec2& uv_d, ImU32 col)
 {
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        const float params[] = { a.x, a.y, b.x, b.y, c.x, c.y, d.x, d.y, uv_a.x, uv_a.y, uv_b.x, uv_b.y, uv_c.x, uv_c.y, uv_d.x, uv_d.y };
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_PrimQuadUV, col, params, sizeof(params));
+    }
     ImDrawIdx idx = (ImDrawIdx)_VtxCurrentIdx;
     _IdxWritePtr[0] = idx; _IdxWritePtr[1] = (ImDrawIdx)(idx+1); _IdxWritePtr[2] = (ImDrawIdx)(idx+2);
     _IdxWritePtr[3] = idx; _IdxWritePtr[4] = (ImDrawIdx)(idx+2); _IdxWritePtr[5] = (ImDrawIdx)(idx+3);
@@ -656,39 +823,246 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 #define IM_NORMALIZE2F_OVER_ZERO(VX,VY)     do { float d2 = VX*VX + VY*VY; if (d2 > 0.0f) { float inv_len = 1.0f / ImSqrt(d2); VX *= inv_len; VY *= inv_len; } } while (0)
 #define IM_FIXNORMAL2F(VX,VY)               do { float d2 = VX*VX + VY*VY; if (d2 < 0.5f) d2 = 0.5f; float inv_lensq = 1.0f / d2; VX *= inv_lensq; VY *= inv_lensq; } while (0)
 
-// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
-// We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
-void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
+// SIMD helpers for AddPolyline() and AddConvexPolyFilled(), processing 4 points at a time.
+// We only use IEEE exact operations (no reciprocal/rsqrt estimates) and keep the same evaluation order as the scalar code,
+// so the SIMD paths output exactly the same vertices as the scalar paths. See IMGUI_DISABLE_SIMD in imconfig.h.
+#if defined(IMGUI_ENABLE_SSE2)
+#define IMGUI_DRAW_SIMD
+typedef __m128 ImSimdF4;
+static inline ImSimdF4  ImSimdSet1(float v)                                     { return _mm_set1_ps(v); }
+static inline ImSimdF4  ImSimdAdd(ImSimdF4 a, ImSimdF4 b)                       { return _mm_add_ps(a, b); }
+static inline ImSimdF4  ImSimdSub(ImSimdF4 a, ImSimdF4 b)                       { return _mm_sub_ps(a, b); }
+static inline ImSimdF4  ImSimdMul(ImSimdF4 a, ImSimdF4 b)                       { return _mm_mul_ps(a, b); }
+static inline ImSimdF4  ImSimdDiv(ImSimdF4 a, ImSimdF4 b)                       { return _mm_div_ps(a, b); }
+static inline ImSimdF4  ImSimdSqrt(ImSimdF4 a)                                  { return _mm_sqrt_ps(a); }
+static inline ImSimdF4  ImSimdNeg(ImSimdF4 a)                                   { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+static inline ImSimdF4  ImSimdSelectGt(ImSimdF4 a, ImSimdF4 b, ImSimdF4 x, ImSimdF4 y) { __m128 m = _mm_cmpgt_ps(a, b); return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y)); } // (a > b) ? x : y
+static inline ImSimdF4  ImSimdSelectLt(ImSimdF4 a, ImSimdF4 b, ImSimdF4 x, ImSimdF4 y) { __m128 m = _mm_cmplt_ps(a, b); return _mm_or_ps(_mm_and_ps(m, x), _mm_andnot_ps(m, y)); } // (a < b) ? x : y
+static inline ImSimdF4  ImSimdZipLo(ImSimdF4 a, ImSimdF4 b)                     { return _mm_unpacklo_ps(a, b); }                           // a0 b0 a1 b1
+static inline ImSimdF4  ImSimdZipHi(ImSimdF4 a, ImSimdF4 b)                     { return _mm_unpackhi_ps(a, b); }                           // a2 b2 a3 b3
+static inline ImSimdF4  ImSimdCombineLo(ImSimdF4 a, ImSimdF4 b)                 { return _mm_movelh_ps(a, b); }                             // a0 a1 b0 b1
+static inline ImSimdF4  ImSimdCombineHi(ImSimdF4 a, ImSimdF4 b)                 { return _mm_movehl_ps(b, a); }                             // a2 a3 b2 b3
+static inline void      ImSimdStore(ImVec2* p, ImSimdF4 v)                      { _mm_storeu_ps(&p->x, v); }
+static inline void      ImSimdLoadVec2x4(const ImVec2* p, ImSimdF4* out_x, ImSimdF4* out_y)
+{
+    __m128 a = _mm_loadu_ps(&p[0].x);
+    __m128 b = _mm_loadu_ps(&p[2].x);
+    *out_x = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    *out_y = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+}
+#elif defined(IMGUI_ENABLE_NEON)
+#define IMGUI_DRAW_SIMD
+typedef float32x4_t ImSimdF4;
+static inline ImSimdF4  ImSimdSet1(float v)                                     { return vdupq_n_f32(v); }
+static inline ImSimdF4  ImSimdAdd(ImSimdF4 a, ImSimdF4 b)                       { return vaddq_f32(a, b); }
+static inline ImSimdF4  ImSimdSub(ImSimdF4 a, ImSimdF4 b)                       { return vsubq_f32(a, b); }
+static inline ImSimdF4  ImSimdMul(ImSimdF4 a, ImSimdF4 b)                       { return vmulq_f32(a, b); }
+static inline ImSimdF4  ImSimdDiv(ImSimdF4 a, ImSimdF4 b)                       { return vdivq_f32(a, b); }
+static inline ImSimdF4  ImSimdSqrt(ImSimdF4 a)                                  { return vsqrtq_f32(a); }
+static inline ImSimdF4  ImSimdNeg(ImSimdF4 a)                                   { return vnegq_f32(a); }
+static inline ImSimdF4  ImSimdSelectGt(ImSimdF4 a, ImSimdF4 b, ImSimdF4 x, ImSimdF4 y) { return vbslq_f32(vcgtq_f32(a, b), x, y); }       // (a > b) ? x : y
+static inline ImSimdF4  ImSimdSelectLt(ImSimdF4 a, ImSimdF4 b, ImSimdF4 x, ImSimdF4 y) { return vbslq_f32(vcltq_f32(a, b), x, y); }       // (a < b) ? x : y
+static inline ImSimdF4  ImSimdZipLo(ImSimdF4 a, ImSimdF4 b)                     { return vzip1q_f32(a, b); }                                // a0 b0 a1 b1
+static inline ImSimdF4  ImSimdZipHi(ImSimdF4 a, ImSimdF4 b)                     { return vzip2q_f32(a, b); }                                // a2 b2 a3 b3
+static inline ImSimdF4  ImSimdCombineLo(ImSimdF4 a, ImSimdF4 b)                 { return vcombine_f32(vget_low_f32(a), vget_low_f32(b)); }  // a0 a1 b0 b1
+static inline ImSimdF4  ImSimdCombineHi(ImSimdF4 a, ImSimdF4 b)                 { return vcombine_f32(vget_high_f32(a), vget_high_f32(b)); }// a2 a3 b2 b3
+static inline void      ImSimdStore(ImVec2* p, ImSimdF4 v)                      { vst1q_f32(&p->x, v); }
+static inline void      ImSimdLoadVec2x4(const ImVec2* p, ImSimdF4* out_x, ImSimdF4* out_y)
+{
+    float32x4x2_t v = vld2q_f32(&p->x);
+    *out_x = v.val[0];
+    *out_y = v.val[1];
+}
+#endif
+
+#ifdef IMGUI_DRAW_SIMD
+// Store 4 points given as separate x/y vectors: p[0..3]
+static inline void ImSimdStoreVec2x4(ImVec2* p, ImSimdF4 x, ImSimdF4 y)
 {
-    if (points_count < 2)
-        return;
+    ImSimdStore(p + 0, ImSimdZipLo(x, y));
+    ImSimdStore(p + 2, ImSimdZipHi(x, y));
+}
 
-    const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
-    const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
-    const bool thick_line = (thickness > 1.0f);
+// Store 2 streams of 4 points interleaved: p[] = { a0, b0, a1, b1, a2, b2, a3, b3 }
+static inline void ImSimdStoreVec2x4Interleave2(ImVec2* p, ImSimdF4 ax, ImSimdF4 ay, ImSimdF4 bx, ImSimdF4 by)
+{
+    ImSimdF4 a01 = ImSimdZipLo(ax, ay), a23 = ImSimdZipHi(ax, ay);
+    ImSimdF4 b01 = ImSimdZipLo(bx, by), b23 = ImSimdZipHi(bx, by);
+    ImSimdStore(p + 0, ImSimdCombineLo(a01, b01));
+    ImSimdStore(p + 2, ImSimdCombineHi(a01, b01));
+    ImSimdStore(p + 4, ImSimdCombineLo(a23, b23));
+    ImSimdStore(p + 6, ImSimdCombineHi(a23, b23));
+}
+#endif
 
-    if (Flags & ImDrawListFlags_AntiAliasedLines)
+// Calculate normals (tangents) for each line segment [points[i], points[i+1]], i < count. With count == points_count the last segment wraps to the first point.
+static void ImComputeSegmentNormals(ImVec2* out_normals, const ImVec2* points, const int points_count, const int count)
+{
+    int i1 = 0;
+#ifdef IMGUI_DRAW_SIMD
+    const ImSimdF4 zero = ImSimdSet1(0.0f);
+    const ImSimdF4 one = ImSimdSet1(1.0f);
+    for (; i1 + 4 < points_count; i1 += 4)
     {
-        // Anti-aliased stroke
-        const float AA_SIZE = 1.0f;
-        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+        ImSimdF4 p1_x, p1_y, p2_x, p2_y;
+        ImSimdLoadVec2x4(points + i1, &p1_x, &p1_y);
+        ImSimdLoadVec2x4(points + i1 + 1, &p2_x, &p2_y);
+        ImSimdF4 dx = ImSimdSub(p2_x, p1_x);
+        ImSimdF4 dy = ImSimdSub(p2_y, p1_y);
+        ImSimdF4 d2 = ImSimdAdd(ImSimdMul(dx, dx), ImSimdMul(dy, dy));
+        ImSimdF4 inv_len = ImSimdSelectGt(d2, zero, ImSimdDiv(one, ImSimdSqrt(d2)), one); // IM_NORMALIZE2F_OVER_ZERO()
+        dx = ImSimdMul(dx, inv_len);
+        dy = ImSimdMul(dy, inv_len);
+        ImSimdStoreVec2x4(out_normals + i1, dy, ImSimdNeg(dx));
+    }
+#endif
+    for (; i1 < count; i1++)
+    {
+        const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
+        float dx = points[i2].x - points[i1].x;
+        float dy = points[i2].y - points[i1].y;
+        IM_NORMALIZE2F_OVER_ZERO(dx, dy);
+        out_normals[i1].x = dy;
+        out_normals[i1].y = -dx;
+    }
+}
+
+#ifdef IMGUI_DRAW_SIMD
+// Average normals n0[] and n1[] of 4 consecutive points, same as the IM_FIXNORMAL2F() sequence used by scalar paths.
+static inline void ImSimdAverageNormals(const ImVec2* n0, const ImVec2* n1, ImSimdF4* out_dm_x, ImSimdF4* out_dm_y)
+{
+    const ImSimdF4 half = ImSimdSet1(0.5f);
+    ImSimdF4 n0_x, n0_y, n1_x, n1_y;
+    ImSimdLoadVec2x4(n0, &n0_x, &n0_y);
+    ImSimdLoadVec2x4(n1, &n1_x, &n1_y);
+    ImSimdF4 dm_x = ImSimdMul(ImSimdAdd(n0_x, n1_x), half);
+    ImSimdF4 dm_y = ImSimdMul(ImSimdAdd(n0_y, n1_y), half);
+    ImSimdF4 d2 = ImSimdAdd(ImSimdMul(dm_x, dm_x), ImSimdMul(dm_y, dm_y));
+    d2 = ImSimdSelectLt(d2, half, half, d2);
+    ImSimdF4 inv_lensq = ImSimdDiv(ImSimdSet1(1.0f), d2);
+    *out_dm_x = ImSimdMul(dm_x, inv_lensq);
+    *out_dm_y = ImSimdMul(dm_y, inv_lensq);
+}
+#endif
 
+// Polylines and convex polygons tessellation is split into writing indices and writing vertices.
+// With ImDrawListFlags_DeferTessellation, indices are written immediately while vertices are generated later by _TessellateDeferred(),
+// possibly on a worker thread. Both code paths are sharing the functions below, which only write into already reserved buffers.
+struct ImPolylineLayout
+{
+    bool        AntiAliased;
+    bool        UseTexture;
+    bool        ThickLine;
+    float       Thickness;
+    int         IntegerThickness;
+    float       FractionalThickness;
+    int         IdxCount;
+    int         VtxCount;
+};
+
+static void ImPolylineCalcLayout(ImPolylineLayout* layout, const ImDrawListSharedData* data, ImDrawListFlags flags, int points_count, bool closed, float thickness)
+{
+    IM_UNUSED(data);
+    const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
+    layout->AntiAliased = (flags & ImDrawListFlags_AntiAliasedLines) != 0;
+    layout->ThickLine = (thickness > 1.0f);
+    if (layout->AntiAliased)
+    {
         // Thicknesses <1.0 should behave like thickness 1.0
         thickness = ImMax(thickness, 1.0f);
-        const int integer_thickness = (int)thickness;
-        const float fractional_thickness = thickness - integer_thickness;
+        layout->IntegerThickness = (int)thickness;
+        layout->FractionalThickness = thickness - layout->IntegerThickness;
 
         // Do we want to draw this line using a texture?
         // - For now, only draw integer-width lines using textures to avoid issues with the way scaling occurs, could be improved.
         // - If AA_SIZE is not 1.0f we cannot use the texture path.
-        const bool use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f);
+        layout->UseTexture = (flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (layout->IntegerThickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (layout->FractionalThickness <= 0.00001f);
 
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
-        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+        IM_ASSERT_PARANOID(!layout->UseTexture || !(data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+
+        layout->IdxCount = layout->UseTexture ? (count * 6) : (layout->ThickLine ? count * 18 : count * 12);
+        layout->VtxCount = layout->UseTexture ? (points_count * 2) : (layout->ThickLine ? points_count * 4 : points_count * 3);
+    }
+    else
+    {
+        layout->UseTexture = false;
+        layout->IntegerThickness = 0;
+        layout->FractionalThickness = 0.0f;
+        layout->IdxCount = count * 6;
+        layout->VtxCount = count * 4;    // FIXME-OPT: Not sharing edges
+    }
+    layout->Thickness = thickness;
+}
+
+static void ImPolylineWriteIndices(const ImPolylineLayout& layout, ImDrawIdx* idx_write, unsigned int vtx_current_idx, const int points_count, bool closed)
+{
+    const int count = closed ? points_count : points_count - 1;
+    if (!layout.AntiAliased)
+    {
+        // [PATH 4] Non texture-based, Non anti-aliased lines
+        for (int i1 = 0; i1 < count; i1++, vtx_current_idx += 4)
+        {
+            idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx + 1); idx_write[2] = (ImDrawIdx)(vtx_current_idx + 2);
+            idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx + 2); idx_write[5] = (ImDrawIdx)(vtx_current_idx + 3);
+            idx_write += 6;
+        }
+        return;
+    }
+
+    // Generate the indices to form a number of triangles for each line segment
+    // This takes points n and n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
+    const unsigned int vtx_stride = layout.UseTexture ? 2 : (layout.ThickLine ? 4 : 3);
+    unsigned int idx1 = vtx_current_idx; // Vertex index for start of line segment
+    for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+    {
+        const unsigned int idx2 = ((i1 + 1) == points_count) ? vtx_current_idx : (idx1 + vtx_stride); // Vertex index for end of segment
+        if (layout.UseTexture)
+        {
+            // [PATH 1] Texture-based lines (thick or non-thick): add indices for two triangles
+            idx_write[0] = (ImDrawIdx)(idx2 + 0); idx_write[1] = (ImDrawIdx)(idx1 + 0); idx_write[2] = (ImDrawIdx)(idx1 + 1); // Right tri
+            idx_write[3] = (ImDrawIdx)(idx2 + 1); idx_write[4] = (ImDrawIdx)(idx1 + 1); idx_write[5] = (ImDrawIdx)(idx2 + 0); // Left tri
+            idx_write += 6;
+        }
+        else if (!layout.ThickLine)
+        {
+            // [PATH 2] Non texture-based lines (non-thick): add indexes for four triangles
+            idx_write[0] = (ImDrawIdx)(idx2 + 0); idx_write[1] = (ImDrawIdx)(idx1 + 0); idx_write[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
+            idx_write[3] = (ImDrawIdx)(idx1 + 2); idx_write[4] = (ImDrawIdx)(idx2 + 2); idx_write[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
+            idx_write[6] = (ImDrawIdx)(idx2 + 1); idx_write[7] = (ImDrawIdx)(idx1 + 1); idx_write[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
+            idx_write[9] = (ImDrawIdx)(idx1 + 0); idx_write[10] = (ImDrawIdx)(idx2 + 0); idx_write[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
+            idx_write += 12;
+        }
+        else
+        {
+            // [PATH 3] Non texture-based lines (thick)
+            idx_write[0]  = (ImDrawIdx)(idx2 + 1); idx_write[1]  = (ImDrawIdx)(idx1 + 1); idx_write[2]  = (ImDrawIdx)(idx1 + 2);
+            idx_write[3]  = (ImDrawIdx)(idx1 + 2); idx_write[4]  = (ImDrawIdx)(idx2 + 2); idx_write[5]  = (ImDrawIdx)(idx2 + 1);
+            idx_write[6]  = (ImDrawIdx)(idx2 + 1); idx_write[7]  = (ImDrawIdx)(idx1 + 1); idx_write[8]  = (ImDrawIdx)(idx1 + 0);
+            idx_write[9]  = (ImDrawIdx)(idx1 + 0); idx_write[10] = (ImDrawIdx)(idx2 + 0); idx_write[11] = (ImDrawIdx)(idx2 + 1);
+            idx_write[12] = (ImDrawIdx)(idx2 + 2); idx_write[13] = (ImDrawIdx)(idx1 + 2); idx_write[14] = (ImDrawIdx)(idx1 + 3);
+            idx_write[15] = (ImDrawIdx)(idx1 + 3); idx_write[16] = (ImDrawIdx)(idx2 + 3); idx_write[17] = (ImDrawIdx)(idx2 + 2);
+            idx_write += 18;
+        }
+        idx1 = idx2;
+    }
+}
+
+// TODO: Thickness anti-aliased lines cap are missing their AA fringe.
+// We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
+static void ImPolylineWriteVertices(const ImPolylineLayout& layout, const ImDrawListSharedData* data, ImDrawVert* vtx_write, const ImVec2* points, const int points_count, ImU32 col, bool closed)
+{
+    const ImVec2 opaque_uv = data->TexUvWhitePixel;
+    const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
+    const float thickness = layout.Thickness;
 
-        const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
-        const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
-        PrimReserve(idx_count, vtx_count);
+    if (layout.AntiAliased)
+    {
+        // Anti-aliased stroke
+        const float AA_SIZE = 1.0f;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+        const bool use_texture = layout.UseTexture;
+        const bool thick_line = layout.ThickLine;
 
         // Temporary buffer
         // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
@@ -696,15 +1070,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
-        {
-            const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
-            float dx = points[i2].x - points[i1].x;
-            float dy = points[i2].y - points[i1].y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i1].x = dy;
-            temp_normals[i1].y = -dx;
-        }
+        ImComputeSegmentNormals(temp_normals, points, points_count, count);
         if (!closed)
             temp_normals[points_count - 1] = temp_normals[points_count - 2];
 
@@ -730,14 +1096,25 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            int i1 = 0;
+#ifdef IMGUI_DRAW_SIMD
+            const ImSimdF4 half_draw_size_4 = ImSimdSet1(half_draw_size);
+            for (; i1 + 4 < points_count; i1 += 4) // Process i2 = i1+1 .. i1+4, never wrapping
+            {
+                ImSimdF4 dm_x, dm_y, p_x, p_y;
+                ImSimdAverageNormals(temp_normals + i1, temp_normals + i1 + 1, &dm_x, &dm_y);
+                dm_x = ImSimdMul(dm_x, half_draw_size_4);
+                dm_y = ImSimdMul(dm_y, half_draw_size_4);
+                ImSimdLoadVec2x4(points + i1 + 1, &p_x, &p_y);
+                ImSimdStoreVec2x4Interleave2(&temp_points[(i1 + 1) * 2], ImSimdAdd(p_x, dm_x), ImSimdAdd(p_y, dm_y), ImSimdSub(p_x, dm_x), ImSimdSub(p_y, dm_y));
+            }
+#endif
+            for (; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -752,47 +1129,28 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[0].y = points[i2].y + dm_y;
                 out_vtx[1].x = points[i2].x - dm_x;
                 out_vtx[1].y = points[i2].y - dm_y;
-
-                if (use_texture)
-                {
-                    // Add indices for two triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 1); // Right tri
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[4] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Left tri
-                    _IdxWritePtr += 6;
-                }
-                else
-                {
-                    // Add indexes for four triangles
-                    _IdxWritePtr[0] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[1] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[2] = (ImDrawIdx)(idx1 + 2); // Right tri 1
-                    _IdxWritePtr[3] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5] = (ImDrawIdx)(idx2 + 0); // Right tri 2
-                    _IdxWritePtr[6] = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7] = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8] = (ImDrawIdx)(idx1 + 0); // Left tri 1
-                    _IdxWritePtr[9] = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1); // Left tri 2
-                    _IdxWritePtr += 12;
-                }
-
-                idx1 = idx2;
             }
 
             // Add vertexes for each point on the line
             if (use_texture)
             {
                 // If we're using textures we only need to emit the left/right edge vertices
-                ImVec4 tex_uvs = _Data->TexUvLines[integer_thickness];
-                if (fractional_thickness != 0.0f)
+                ImVec4 tex_uvs = data->TexUvLines[layout.IntegerThickness];
+                if (layout.FractionalThickness != 0.0f)
                 {
-                    const ImVec4 tex_uvs_1 = _Data->TexUvLines[integer_thickness + 1];
-                    tex_uvs.x = tex_uvs.x + (tex_uvs_1.x - tex_uvs.x) * fractional_thickness; // inlined ImLerp()
-                    tex_uvs.y = tex_uvs.y + (tex_uvs_1.y - tex_uvs.y) * fractional_thickness;
-                    tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * fractional_thickness;
-                    tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * fractional_thickness;
+                    const ImVec4 tex_uvs_1 = data->TexUvLines[layout.IntegerThickness + 1];
+                    tex_uvs.x = tex_uvs.x + (tex_uvs_1.x - tex_uvs.x) * layout.FractionalThickness; // inlined ImLerp()
+                    tex_uvs.y = tex_uvs.y + (tex_uvs_1.y - tex_uvs.y) * layout.FractionalThickness;
+                    tex_uvs.z = tex_uvs.z + (tex_uvs_1.z - tex_uvs.z) * layout.FractionalThickness;
+                    tex_uvs.w = tex_uvs.w + (tex_uvs_1.w - tex_uvs.w) * layout.FractionalThickness;
                 }
                 ImVec2 tex_uv0(tex_uvs.x, tex_uvs.y);
                 ImVec2 tex_uv1(tex_uvs.z, tex_uvs.w);
                 for (int i = 0; i < points_count; i++)
                 {
-                    _VtxWritePtr[0].pos = temp_points[i * 2 + 0]; _VtxWritePtr[0].uv = tex_uv0; _VtxWritePtr[0].col = col; // Left-side outer edge
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 1]; _VtxWritePtr[1].uv = tex_uv1; _VtxWritePtr[1].col = col; // Right-side outer edge
-                    _VtxWritePtr += 2;
+                    vtx_write[0].pos = temp_points[i * 2 + 0]; vtx_write[0].uv = tex_uv0; vtx_write[0].col = col; // Left-side outer edge
+                    vtx_write[1].pos = temp_points[i * 2 + 1]; vtx_write[1].uv = tex_uv1; vtx_write[1].col = col; // Right-side outer edge
+                    vtx_write += 2;
                 }
             }
             else
@@ -800,16 +1158,16 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 // If we're not using a texture, we need the center vertex as well
                 for (int i = 0; i < points_count; i++)
                 {
-                    _VtxWritePtr[0].pos = points[i];              _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;       // Center of line
-                    _VtxWritePtr[1].pos = temp_points[i * 2 + 0]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col_trans; // Left-side outer edge
-                    _VtxWritePtr[2].pos = temp_points[i * 2 + 1]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col_trans; // Right-side outer edge
-                    _VtxWritePtr += 3;
+                    vtx_write[0].pos = points[i];              vtx_write[0].uv = opaque_uv; vtx_write[0].col = col;       // Center of line
+                    vtx_write[1].pos = temp_points[i * 2 + 0]; vtx_write[1].uv = opaque_uv; vtx_write[1].col = col_trans; // Left-side outer edge
+                    vtx_write[2].pos = temp_points[i * 2 + 1]; vtx_write[2].uv = opaque_uv; vtx_write[2].col = col_trans; // Right-side outer edge
+                    vtx_write += 3;
                 }
             }
         }
         else
         {
-            // [PATH 2] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
+            // [PATH 3] Non texture-based lines (thick): we need to draw the solid line core and thus require four vertices per point
             const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
 
             // If line is not closed, the first and last points need to be generated differently as there are no normals to blend
@@ -826,14 +1184,42 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
             // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            int i1 = 0;
+#ifdef IMGUI_DRAW_SIMD
+            const ImSimdF4 half_outer_thickness_4 = ImSimdSet1(half_inner_thickness + AA_SIZE);
+            const ImSimdF4 half_inner_thickness_4 = ImSimdSet1(half_inner_thickness);
+            for (; i1 + 4 < points_count; i1 += 4) // Process i2 = i1+1 .. i1+4, never wrapping
+            {
+                ImSimdF4 dm_x, dm_y, p_x, p_y;
+                ImSimdAverageNormals(temp_normals + i1, temp_normals + i1 + 1, &dm_x, &dm_y);
+                ImSimdF4 dm_out_x = ImSimdMul(dm_x, half_outer_thickness_4);
+                ImSimdF4 dm_out_y = ImSimdMul(dm_y, half_outer_thickness_4);
+                ImSimdF4 dm_in_x = ImSimdMul(dm_x, half_inner_thickness_4);
+                ImSimdF4 dm_in_y = ImSimdMul(dm_y, half_inner_thickness_4);
+                ImSimdLoadVec2x4(points + i1 + 1, &p_x, &p_y);
+
+                // Write 4 points (out+, in+, in-, out-) for each of the 4 line points
+                ImSimdF4 o0x = ImSimdAdd(p_x, dm_out_x), o0y = ImSimdAdd(p_y, dm_out_y);
+                ImSimdF4 o1x = ImSimdAdd(p_x, dm_in_x),  o1y = ImSimdAdd(p_y, dm_in_y);
+                ImSimdF4 o2x = ImSimdSub(p_x, dm_in_x),  o2y = ImSimdSub(p_y, dm_in_y);
+                ImSimdF4 o3x = ImSimdSub(p_x, dm_out_x), o3y = ImSimdSub(p_y, dm_out_y);
+                ImSimdF4 o0_01 = ImSimdZipLo(o0x, o0y), o0_23 = ImSimdZipHi(o0x, o0y);
+                ImSimdF4 o1_01 = ImSimdZipLo(o1x, o1y), o1_23 = ImSimdZipHi(o1x, o1y);
+                ImSimdF4 o2_01 = ImSimdZipLo(o2x, o2y), o2_23 = ImSimdZipHi(o2x, o2y);
+                ImSimdF4 o3_01 = ImSimdZipLo(o3x, o3y), o3_23 = ImSimdZipHi(o3x, o3y);
+                ImVec2* out_vtx = &temp_points[(i1 + 1) * 4];
+                ImSimdStore(out_vtx + 0,  ImSimdCombineLo(o0_01, o1_01)); ImSimdStore(out_vtx + 2,  ImSimdCombineLo(o2_01, o3_01));
+                ImSimdStore(out_vtx + 4,  ImSimdCombineHi(o0_01, o1_01)); ImSimdStore(out_vtx + 6,  ImSimdCombineHi(o2_01, o3_01));
+                ImSimdStore(out_vtx + 8,  ImSimdCombineLo(o0_23, o1_23)); ImSimdStore(out_vtx + 10, ImSimdCombineLo(o2_23, o3_23));
+                ImSimdStore(out_vtx + 12, ImSimdCombineHi(o0_23, o1_23)); ImSimdStore(out_vtx + 14, ImSimdCombineHi(o2_23, o3_23));
+            }
+#endif
+            for (; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -854,38 +1240,22 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[2].y = points[i2].y - dm_in_y;
                 out_vtx[3].x = points[i2].x - dm_out_x;
                 out_vtx[3].y = points[i2].y - dm_out_y;
-
-                // Add indexes
-                _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
-                _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
-                _IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
-                _IdxWritePtr[9]  = (ImDrawIdx)(idx1 + 0); _IdxWritePtr[10] = (ImDrawIdx)(idx2 + 0); _IdxWritePtr[11] = (ImDrawIdx)(idx2 + 1);
-                _IdxWritePtr[12] = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[13] = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[14] = (ImDrawIdx)(idx1 + 3);
-                _IdxWritePtr[15] = (ImDrawIdx)(idx1 + 3); _IdxWritePtr[16] = (ImDrawIdx)(idx2 + 3); _IdxWritePtr[17] = (ImDrawIdx)(idx2 + 2);
-                _IdxWritePtr += 18;
-
-                idx1 = idx2;
             }
 
             // Add vertices
             for (int i = 0; i < points_count; i++)
             {
-                _VtxWritePtr[0].pos = temp_points[i * 4 + 0]; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col_trans;
-                _VtxWritePtr[1].pos = temp_points[i * 4 + 1]; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-                _VtxWritePtr[2].pos = temp_points[i * 4 + 2]; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-                _VtxWritePtr[3].pos = temp_points[i * 4 + 3]; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col_trans;
-                _VtxWritePtr += 4;
+                vtx_write[0].pos = temp_points[i * 4 + 0]; vtx_write[0].uv = opaque_uv; vtx_write[0].col = col_trans;
+                vtx_write[1].pos = temp_points[i * 4 + 1]; vtx_write[1].uv = opaque_uv; vtx_write[1].col = col;
+                vtx_write[2].pos = temp_points[i * 4 + 2]; vtx_write[2].uv = opaque_uv; vtx_write[2].col = col;
+                vtx_write[3].pos = temp_points[i * 4 + 3]; vtx_write[3].uv = opaque_uv; vtx_write[3].col = col_trans;
+                vtx_write += 4;
             }
         }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
     else
     {
         // [PATH 4] Non texture-based, Non anti-aliased lines
-        const int idx_count = count * 6;
-        const int vtx_count = count * 4;    // FIXME-OPT: Not sharing edges
-        PrimReserve(idx_count, vtx_count);
-
         for (int i1 = 0; i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
@@ -898,61 +1268,91 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             dx *= (thickness * 0.5f);
             dy *= (thickness * 0.5f);
 
-            _VtxWritePtr[0].pos.x = p1.x + dy; _VtxWritePtr[0].pos.y = p1.y - dx; _VtxWritePtr[0].uv = opaque_uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr[1].pos.x = p2.x + dy; _VtxWritePtr[1].pos.y = p2.y - dx; _VtxWritePtr[1].uv = opaque_uv; _VtxWritePtr[1].col = col;
-            _VtxWritePtr[2].pos.x = p2.x - dy; _VtxWritePtr[2].pos.y = p2.y + dx; _VtxWritePtr[2].uv = opaque_uv; _VtxWritePtr[2].col = col;
-            _VtxWritePtr[3].pos.x = p1.x - dy; _VtxWritePtr[3].pos.y = p1.y + dx; _VtxWritePtr[3].uv = opaque_uv; _VtxWritePtr[3].col = col;
-            _VtxWritePtr += 4;
-
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + 2);
-            _IdxWritePtr[3] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[4] = (ImDrawIdx)(_VtxCurrentIdx + 2); _IdxWritePtr[5] = (ImDrawIdx)(_VtxCurrentIdx + 3);
-            _IdxWritePtr += 6;
-            _VtxCurrentIdx += 4;
+            vtx_write[0].pos.x = p1.x + dy; vtx_write[0].pos.y = p1.y - dx; vtx_write[0].uv = opaque_uv; vtx_write[0].col = col;
+            vtx_write[1].pos.x = p2.x + dy; vtx_write[1].pos.y = p2.y - dx; vtx_write[1].uv = opaque_uv; vtx_write[1].col = col;
+            vtx_write[2].pos.x = p2.x - dy; vtx_write[2].pos.y = p2.y + dx; vtx_write[2].uv = opaque_uv; vtx_write[2].col = col;
+            vtx_write[3].pos.x = p1.x - dy; vtx_write[3].pos.y = p1.y + dx; vtx_write[3].uv = opaque_uv; vtx_write[3].col = col;
+            vtx_write += 4;
         }
     }
 }
 
-// We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
-void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+static void ImConvexPolyCalcCounts(ImDrawListFlags flags, int points_count, int* out_idx_count, int* out_vtx_count)
 {
-    if (points_count < 3)
-        return;
-
-    const ImVec2 uv = _Data->TexUvWhitePixel;
+    const bool anti_aliased = (flags & ImDrawListFlags_AntiAliasedFill) != 0;
+    *out_idx_count = anti_aliased ? (points_count - 2)*3 + points_count * 6 : (points_count - 2)*3;
+    *out_vtx_count = anti_aliased ? (points_count * 2) : points_count;
+}
 
-    if (Flags & ImDrawListFlags_AntiAliasedFill)
+static void ImConvexPolyWriteIndices(ImDrawListFlags flags, ImDrawIdx* idx_write, unsigned int vtx_current_idx, const int points_count)
+{
+    if (flags & ImDrawListFlags_AntiAliasedFill)
     {
-        // Anti-aliased Fill
-        const float AA_SIZE = 1.0f;
-        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
-        const int idx_count = (points_count - 2)*3 + points_count * 6;
-        const int vtx_count = (points_count * 2);
-        PrimReserve(idx_count, vtx_count);
-
         // Add indexes for fill
-        unsigned int vtx_inner_idx = _VtxCurrentIdx;
-        unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
+        unsigned int vtx_inner_idx = vtx_current_idx;
+        unsigned int vtx_outer_idx = vtx_current_idx + 1;
         for (int i = 2; i < points_count; i++)
         {
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
-            _IdxWritePtr += 3;
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); idx_write[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+            idx_write += 3;
         }
 
-        // Compute normals
-        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
+        // Add indexes for fringes
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
-            const ImVec2& p0 = points[i0];
-            const ImVec2& p1 = points[i1];
-            float dx = p1.x - p0.x;
-            float dy = p1.y - p0.y;
-            IM_NORMALIZE2F_OVER_ZERO(dx, dy);
-            temp_normals[i0].x = dy;
-            temp_normals[i0].y = -dx;
+            idx_write[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
+            idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); idx_write[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
+            idx_write += 6;
+        }
+    }
+    else
+    {
+        for (int i = 2; i < points_count; i++)
+        {
+            idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx + i - 1); idx_write[2] = (ImDrawIdx)(vtx_current_idx + i);
+            idx_write += 3;
         }
+    }
+}
+
+// We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
+static void ImConvexPolyWriteVertices(ImDrawListFlags flags, const ImDrawListSharedData* data, ImDrawVert* vtx_write, const ImVec2* points, const int points_count, ImU32 col)
+{
+    const ImVec2 uv = data->TexUvWhitePixel;
+
+    if (flags & ImDrawListFlags_AntiAliasedFill)
+    {
+        // Anti-aliased Fill
+        const float AA_SIZE = 1.0f;
+        const ImU32 col_trans = col & ~IM_COL32_A_MASK;
+
+        // Compute normals
+        ImVec2* temp_normals = (ImVec2*)alloca(points_count * sizeof(ImVec2)); //-V630
+        ImComputeSegmentNormals(temp_normals, points, points_count, points_count);
 
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
+#ifdef IMGUI_DRAW_SIMD
+            // Process 4 points at a time, except the first one which averages with the wrapping normal
+            if (i1 > 0 && i1 + 4 <= points_count)
+            {
+                ImSimdF4 dm_x, dm_y, p_x, p_y;
+                ImSimdAverageNormals(temp_normals + i0, temp_normals + i1, &dm_x, &dm_y);
+                dm_x = ImSimdMul(dm_x, ImSimdSet1(AA_SIZE * 0.5f));
+                dm_y = ImSimdMul(dm_y, ImSimdSet1(AA_SIZE * 0.5f));
+                ImSimdLoadVec2x4(points + i1, &p_x, &p_y);
+                ImVec2 pos[8];
+                ImSimdStoreVec2x4Interleave2(pos, ImSimdSub(p_x, dm_x), ImSimdSub(p_y, dm_y), ImSimdAdd(p_x, dm_x), ImSimdAdd(p_y, dm_y));
+                for (int n = 0; n < 8; n += 2)
+                {
+                    vtx_write[n + 0].pos = pos[n + 0]; vtx_write[n + 0].uv = uv; vtx_write[n + 0].col = col;        // Inner
+                    vtx_write[n + 1].pos = pos[n + 1]; vtx_write[n + 1].uv = uv; vtx_write[n + 1].col = col_trans;  // Outer
+                }
+                vtx_write += 8;
+                i1 += 3;
+                continue;
+            }
+#endif
             // Average normals
             const ImVec2& n0 = temp_normals[i0];
             const ImVec2& n1 = temp_normals[i1];
@@ -963,35 +1363,113 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
             dm_y *= AA_SIZE * 0.5f;
 
             // Add vertices
-            _VtxWritePtr[0].pos.x = (points[i1].x - dm_x); _VtxWritePtr[0].pos.y = (points[i1].y - dm_y); _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;        // Inner
-            _VtxWritePtr[1].pos.x = (points[i1].x + dm_x); _VtxWritePtr[1].pos.y = (points[i1].y + dm_y); _VtxWritePtr[1].uv = uv; _VtxWritePtr[1].col = col_trans;  // Outer
-            _VtxWritePtr += 2;
-
-            // Add indexes for fringes
-            _IdxWritePtr[0] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1)); _IdxWritePtr[1] = (ImDrawIdx)(vtx_inner_idx + (i0 << 1)); _IdxWritePtr[2] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1));
-            _IdxWritePtr[3] = (ImDrawIdx)(vtx_outer_idx + (i0 << 1)); _IdxWritePtr[4] = (ImDrawIdx)(vtx_outer_idx + (i1 << 1)); _IdxWritePtr[5] = (ImDrawIdx)(vtx_inner_idx + (i1 << 1));
-            _IdxWritePtr += 6;
+            vtx_write[0].pos.x = (points[i1].x - dm_x); vtx_write[0].pos.y = (points[i1].y - dm_y); vtx_write[0].uv = uv; vtx_write[0].col = col;        // Inner
+            vtx_write[1].pos.x = (points[i1].x + dm_x); vtx_write[1].pos.y = (points[i1].y + dm_y); vtx_write[1].uv = uv; vtx_write[1].col = col_trans;  // Outer
+            vtx_write += 2;
         }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
     else
     {
         // Non Anti-aliased Fill
-        const int idx_count = (points_count - 2)*3;
-        const int vtx_count = points_count;
-        PrimReserve(idx_count, vtx_count);
-        for (int i = 0; i < vtx_count; i++)
+        for (int i = 0; i < points_count; i++)
         {
-            _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
-            _VtxWritePtr++;
+            vtx_write[0].pos = points[i]; vtx_write[0].uv = uv; vtx_write[0].col = col;
+            vtx_write++;
         }
-        for (int i = 2; i < points_count; i++)
+    }
+}
+
+// Record a primitive whose vertices will be generated by _TessellateDeferred(). Indices have already been written by the caller.
+static void ImDrawList_AddDeferredPrim(ImDrawList* draw_list, const ImVec2* points, int points_count, ImU32 col, bool closed, float thickness, bool filled)
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
+    ImDrawDeferredPrim prim;
+    prim.VtxOffset = (int)(draw_list->_VtxWritePtr - draw_list->VtxBuffer.Data);
+    prim.PointsOffset = draw_list->_DeferredPoints.Size;
+    prim.PointsCount = points_count;
+    prim.Col = col;
+    prim.Thickness = thickness;
+    prim.Flags = draw_list->Flags;
+    prim.Closed = closed;
+    prim.Filled = filled;
+    draw_list->_DeferredPrims.push_back(prim);
+    draw_list->_DeferredPoints.resize(prim.PointsOffset + points_count);
+    memcpy(draw_list->_DeferredPoints.Data + prim.PointsOffset, points, points_count * sizeof(ImVec2));
+}
+
+void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
+{
+    if (points_count < 2)
+        return;
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        const float params[] = { closed ? 1.0f : 0.0f, thickness };
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_Polyline, col, params, sizeof(params), points, points_count * sizeof(ImVec2));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
+
+    ImPolylineLayout layout;
+    ImPolylineCalcLayout(&layout, _Data, Flags, points_count, closed, thickness);
+    PrimReserve(layout.IdxCount, layout.VtxCount);
+    ImPolylineWriteIndices(layout, _IdxWritePtr, _VtxCurrentIdx, points_count, closed);
+    if (Flags & ImDrawListFlags_DeferTessellation)
+        ImDrawList_AddDeferredPrim(this, points, points_count, col, closed, thickness, false);
+    else
+        ImPolylineWriteVertices(layout, _Data, _VtxWritePtr, points, points_count, col, closed);
+    _IdxWritePtr += layout.IdxCount;
+    _VtxWritePtr += layout.VtxCount;
+    _VtxCurrentIdx += (unsigned int)layout.VtxCount;
+}
+
+// Note: Anti-aliased filling requires points to be in clockwise order.
+void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_count, ImU32 col)
+{
+    if (points_count < 3)
+        return;
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_ConvexPolyFilled, col, NULL, 0, points, points_count * sizeof(ImVec2));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
+
+    int idx_count, vtx_count;
+    ImConvexPolyCalcCounts(Flags, points_count, &idx_count, &vtx_count);
+    PrimReserve(idx_count, vtx_count);
+    ImConvexPolyWriteIndices(Flags, _IdxWritePtr, _VtxCurrentIdx, points_count);
+    if (Flags & ImDrawListFlags_DeferTessellation)
+        ImDrawList_AddDeferredPrim(this, points, points_count, col, true, 0.0f, true);
+    else
+        ImConvexPolyWriteVertices(Flags, _Data, _VtxWritePtr, points, points_count, col);
+    _IdxWritePtr += idx_count;
+    _VtxWritePtr += vtx_count;
+    _VtxCurrentIdx += (unsigned int)vtx_count;
+}
+
+// Generate vertices for all primitives recorded while ImDrawListFlags_DeferTessellation was set.
+// This is called by ImGui::Render() for every draw list submitted to ImDrawData, possibly on worker threads (see io.ParallelForFn).
+// This only writes into already allocated VtxBuffer storage: it is safe to process different draw lists on different threads.
+void ImDrawList::_TessellateDeferred()
+{
+    for (int prim_n = 0; prim_n < _DeferredPrims.Size; prim_n++)
+    {
+        const ImDrawDeferredPrim& prim = _DeferredPrims.Data[prim_n];
+        ImDrawVert* vtx_write = VtxBuffer.Data + prim.VtxOffset;
+        const ImVec2* points = _DeferredPoints.Data + prim.PointsOffset;
+        if (prim.Filled)
+        {
+            ImConvexPolyWriteVertices(prim.Flags, _Data, vtx_write, points, prim.PointsCount, prim.Col);
+        }
+        else
         {
-            _IdxWritePtr[0] = (ImDrawIdx)(_VtxCurrentIdx); _IdxWritePtr[1] = (ImDrawIdx)(_VtxCurrentIdx + i - 1); _IdxWritePtr[2] = (ImDrawIdx)(_VtxCurrentIdx + i);
-            _IdxWritePtr += 3;
+            ImPolylineLayout layout;
+            ImPolylineCalcLayout(&layout, _Data, prim.Flags, prim.PointsCount, prim.Closed, prim.Thickness);
+            ImPolylineWriteVertices(layout, _Data, vtx_write, points, prim.PointsCount, prim.Col, prim.Closed);
         }
-        _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
+    _DeferredPrims.resize(0);
+    _DeferredPoints.resize(0);
 }
 
 void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12)
@@ -1154,6 +1632,14 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
 {
     if (((col_upr_left | col_upr_right | col_bot_right | col_bot_left) & IM_COL32_A_MASK) == 0)
         return;
+    if (Flags & ImDrawListFlags_HashCommands)
+    {
+        const ImU32 params[] = { col_upr_right, col_bot_right, col_bot_left };
+        const ImVec4 rect(p_min.x, p_min.y, p_max.x, p_max.y);
+        ImDrawList_HashCommand(this, ImDrawListHashCmd_RectFilledMultiColor, col_upr_left, params, sizeof(params), &rect, sizeof(rect));
+        if (Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
 
     const ImVec2 uv = _Data->TexUvWhitePixel;
     PrimReserve(6, 4);
@@ -1420,7 +1906,9 @@ void ImDrawListSplitter::ClearFreeMemory()
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
-    IM_UNUSED(draw_list);
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
+    if (draw_list->Flags & ImDrawListFlags_HashCommands)
+        ImDrawList_HashCommand(draw_list, ImDrawListHashCmd_ChannelsSplit, (ImU32)channels_count, NULL, 0);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -1450,9 +1938,20 @@ void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 
 void ImDrawListSplitter::Merge(ImDrawList* draw_list)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_DrawLists);
     // Note that we never use or rely on _Channels.Size because it is merely a buffer that we never shrink back to 0 to keep all sub-buffers ready for use.
     if (_Count <= 1)
         return;
+    if (draw_list->Flags & ImDrawListFlags_HashCommands)
+    {
+        ImDrawList_HashCommand(draw_list, ImDrawListHashCmd_ChannelsMerge, 0, &draw_list->_CmdHeader.ClipRect, sizeof(draw_list->_CmdHeader.ClipRect));
+        if (draw_list->Flags & ImDrawListFlags_HashOnly)
+        {
+            SetCurrentChannel(draw_list, 0);
+            _Count = 1;
+            return;
+        }
+    }
 
     SetCurrentChannel(draw_list, 0);
     draw_list->_PopUnusedDrawCmd();
@@ -1524,6 +2023,15 @@ void ImDrawListSplitter::SetCurrentChannel(ImDrawList* draw_list, int idx)
     IM_ASSERT(idx >= 0 && idx < _Count);
     if (_Current == idx)
         return;
+    if (draw_list->Flags & ImDrawListFlags_HashCommands)
+    {
+        ImDrawList_HashCommand(draw_list, ImDrawListHashCmd_ChannelsSetCurrent, (ImU32)idx, &draw_list->_CmdHeader.ClipRect, sizeof(draw_list->_CmdHeader.ClipRect));
+        if (draw_list->Flags & ImDrawListFlags_HashOnly)
+        {
+            _Current = idx;
+            return;
+        }
+    }
 
     // Overwrite ImVector (12/16 bytes), four times. This is merely a silly optimization instead of doing .swap()
     memcpy(&_Channels.Data[_Current]._CmdBuffer, &draw_list->CmdBuffer, sizeof(draw_list->CmdBuffer));
@@ -1589,6 +2097,13 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
 {
+    if (draw_list->Flags & ImDrawListFlags_HashCommands)
+    {
+        // Vertices indices are not hashed: they are not the same when ImDrawListFlags_HashOnly is set
+        const float params[] = { gradient_p0.x, gradient_p0.y, gradient_p1.x, gradient_p1.y };
+        ImDrawList_HashCommand(draw_list, ImDrawListHashCmd_ShadeVertsColorGradient, col0, params, sizeof(params), &col1, sizeof(col1));
+    }
+    draw_list->_TessellateDeferred(); // We are reading back vertices
     ImVec2 gradient_extent = gradient_p1 - gradient_p0;
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
@@ -1613,6 +2128,12 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
 // Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
+    if (draw_list->Flags & ImDrawListFlags_HashCommands)
+    {
+        const float params[] = { a.x, a.y, b.x, b.y, uv_a.x, uv_a.y, uv_b.x, uv_b.y };
+        ImDrawList_HashCommand(draw_list, ImDrawListHashCmd_ShadeVertsUV, clamp ? 1 : 0, params, sizeof(params));
+    }
+    draw_list->_TessellateDeferred(); // We are reading back vertices
     const ImVec2 size = b - a;
     const ImVec2 uv_size = uv_b - uv_a;
     const ImVec2 scale = ImVec2(
@@ -1714,6 +2235,8 @@ static const ImVec2 FONT_ATLAS_DEFAULT_TEX_CURSOR_DATA[ImGuiMouseCursor_COUNT][3
     { ImVec2(91,0), ImVec2(17,22), ImVec2( 5, 0) }, // ImGuiMouseCursor_Hand
 };
 
+static void ImFontAtlasBuildClearDynamicGlyphs(ImFontAtlas* atlas);
+
 ImFontAtlas::ImFontAtlas()
 {
     Locked = false;
@@ -1721,6 +2244,8 @@ ImFontAtlas::ImFontAtlas()
     TexID = (ImTextureID)NULL;
     TexDesiredWidth = 0;
     TexGlyphPadding = 1;
+    ParallelForFn = NULL;
+    ParallelForUserData = NULL;
 
     TexPixelsAlpha8 = NULL;
     TexPixelsRGBA32 = NULL;
@@ -1728,6 +2253,9 @@ ImFontAtlas::ImFontAtlas()
     TexUvScale = ImVec2(0.0f, 0.0f);
     TexUvWhitePixel = ImVec2(0.0f, 0.0f);
     PackIdMouseCursors = PackIdLines = -1;
+    DynamicGlyphsData = NULL;
+    DynamicGlyphsMissingCount = 0;
+    GlyphsVersion = 0;
 }
 
 ImFontAtlas::~ImFontAtlas()
@@ -1739,6 +2267,7 @@ ImFontAtlas::~ImFontAtlas()
 void    ImFontAtlas::ClearInputData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasBuildClearDynamicGlyphs(this);
     for (int i = 0; i < ConfigData.Size; i++)
         if (ConfigData[i].FontData && ConfigData[i].FontDataOwnedByAtlas)
         {
@@ -1772,6 +2301,7 @@ void    ImFontAtlas::ClearTexData()
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasBuildClearDynamicGlyphs(this);
     for (int i = 0; i < Fonts.Size; i++)
         IM_DELETE(Fonts[i]);
     Fonts.clear();
@@ -1786,6 +2316,7 @@ void    ImFontAtlas::Clear()
 
 void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     // Build atlas on demand
     if (TexPixelsAlpha8 == NULL)
     {
@@ -1802,6 +2333,7 @@ void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_wid
 
 void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     // Convert to RGBA32 format on demand
     // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
     if (!TexPixelsRGBA32)
@@ -1826,6 +2358,7 @@ void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_wid
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
@@ -1895,6 +2428,7 @@ ImFont* ImFontAtlas::AddFontDefault(const ImFontConfig* font_cfg_template)
 
 ImFont* ImFontAtlas::AddFontFromFileTTF(const char* filename, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     size_t data_size = 0;
     void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
@@ -1930,6 +2464,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float si
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     const unsigned int buf_decompressed_size = stb_decompress_length((const unsigned char*)compressed_ttf_data);
     unsigned char* buf_decompressed_data = (unsigned char*)IM_ALLOC(buf_decompressed_size);
     stb_decompress(buf_decompressed_data, (const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
@@ -1942,6 +2477,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_d
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed_ttf_data_base85, float size_pixels, const ImFontConfig* font_cfg, const ImWchar* glyph_ranges)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     int compressed_ttf_size = (((int)strlen(compressed_ttf_data_base85) + 4) / 5) * 4;
     void* compressed_ttf = IM_ALLOC((size_t)compressed_ttf_size);
     Decode85((const unsigned char*)compressed_ttf_data_base85, (unsigned char*)compressed_ttf);
@@ -1952,6 +2488,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryCompressedBase85TTF(const char* compressed
 
 int ImFontAtlas::AddCustomRectRegular(int width, int height)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(width > 0 && width <= 0xFFFF);
     IM_ASSERT(height > 0 && height <= 0xFFFF);
     ImFontAtlasCustomRect r;
@@ -1963,6 +2500,7 @@ int ImFontAtlas::AddCustomRectRegular(int width, int height)
 
 int ImFontAtlas::AddCustomRectFontGlyph(ImFont* font, ImWchar id, int width, int height, float advance_x, const ImVec2& offset)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
 #ifdef IMGUI_USE_WCHAR32
     IM_ASSERT(id <= IM_UNICODE_CODEPOINT_MAX);
 #endif
@@ -2011,6 +2549,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     return ImFontAtlasBuildWithStbTruetype(this);
 }
@@ -2046,6 +2585,7 @@ struct ImFontBuildSrcData
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<int>       GlyphsList;         // Glyph codepoints list (flattened version of GlyphsMap)
+    ImBitVector         GlyphsDeferredSet;  // With ImFontAtlasFlags_DynamicGlyphs: glyphs available in the font but not rasterized by Build()
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -2057,6 +2597,71 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Data kept after building with ImFontAtlasFlags_DynamicGlyphs, for each source font
+struct ImFontDynamicSrcData
+{
+    stbtt_fontinfo      FontInfo;
+    ImBitVector         GlyphsSet;          // Glyphs available in the font which haven't been requested yet
+    ImBitVector         GlyphsMissingSet;   // Glyphs which didn't fit in the texture (counted once in ImFontAtlas::DynamicGlyphsMissingCount)
+};
+
+struct ImFontDynamicGlyphRequest
+{
+    int                 SrcIndex;           // Index into atlas->ConfigData[] and Sources[]
+    int                 Codepoint;
+};
+
+struct ImFontAtlasDynamicData
+{
+    stbtt_pack_context  PackContext;        // Packing state of the texture, kept between calls to BuildDynamicGlyphs()
+    ImVector<ImFontDynamicSrcData>      Sources;
+    ImVector<ImFontDynamicGlyphRequest> Requests;   // Glyphs to rasterize on the next call to BuildDynamicGlyphs()
+};
+
+static void ImFontAtlasBuildClearDynamicGlyphs(ImFontAtlas* atlas)
+{
+    ImFontAtlasDynamicData* dyn = (ImFontAtlasDynamicData*)atlas->DynamicGlyphsData;
+    if (dyn == NULL)
+        return;
+    stbtt_PackEnd(&dyn->PackContext);
+    for (int src_i = 0; src_i < dyn->Sources.Size; src_i++)
+        dyn->Sources[src_i].~ImFontDynamicSrcData();
+    IM_DELETE(dyn);
+    atlas->DynamicGlyphsData = NULL;
+    atlas->DynamicGlyphsMissingCount = 0;
+}
+
+// Queue a glyph missing from 'font' if one of its source fonts can provide it. Called by ImFont::FindGlyph(), which is why this mutates atlas state from a const function.
+static void ImFontAtlasBuildRequestDynamicGlyph(ImFontAtlas* atlas, const ImFont* font, unsigned int codepoint)
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
+    ImFontAtlasDynamicData* dyn = (ImFontAtlasDynamicData*)atlas->DynamicGlyphsData;
+    for (int src_i = 0; src_i < dyn->Sources.Size; src_i++)
+    {
+        ImFontDynamicSrcData& src = dyn->Sources[src_i];
+        if (atlas->ConfigData[src_i].DstFont != font || codepoint >= (unsigned int)src.GlyphsSet.Storage.Size * 32 || !src.GlyphsSet.TestBit((int)codepoint))
+            continue;
+        src.GlyphsSet.ClearBit((int)codepoint); // Request only once per frame (set again by BuildDynamicGlyphs() if the glyph doesn't fit)
+        ImFontDynamicGlyphRequest req = { src_i, (int)codepoint };
+        dyn->Requests.push_back(req);
+        return;
+    }
+}
+
+// Convert modified pixels to RGBA32 if needed, and record the region for backends to upload it
+static void ImFontAtlasBuildUpdateTexRect(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    if (atlas->TexPixelsRGBA32 != NULL)
+        for (int off_y = 0; off_y < h; off_y++)
+        {
+            const unsigned char* src = atlas->TexPixelsAlpha8 + x + (y + off_y) * atlas->TexWidth;
+            unsigned int* dst = atlas->TexPixelsRGBA32 + x + (y + off_y) * atlas->TexWidth;
+            for (int off_x = 0; off_x < w; off_x++)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+    atlas->AddTexDirtyRect(x, y, w, h);
+}
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2069,11 +2674,96 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+void    ImFontAtlasBuildParallelFor(ImFontAtlas* atlas, ImGuiJobFn job_fn, void* job_user_data, int jobs_count)
+{
+    if (atlas->ParallelForFn != NULL && jobs_count > 1)
+        atlas->ParallelForFn(atlas->ParallelForUserData, job_fn, job_user_data, jobs_count);
+    else
+        for (int job_n = 0; job_n < jobs_count; job_n++)
+            job_fn(job_user_data, job_n);
+}
+
+// A range of glyphs of one source font, measured then rendered by one job.
+// Large fonts are split in multiple jobs. Jobs write to separate rectangles of the texture, so the output doesn't depend on their scheduling.
+struct ImFontBuildGlyphsJob
+{
+    int                 SrcIndex;
+    int                 GlyphsStart;
+    int                 GlyphsCount;
+};
+
+struct ImFontBuildJobsData
+{
+    ImFontAtlas*                    Atlas;
+    ImFontBuildSrcData*             SrcTmpArray;
+    ImVector<ImFontBuildGlyphsJob>  Jobs;
+    stbtt_pack_context*             PackContext;
+    ImFontAtlasBuildAllocator       Allocator;
+};
+
+// Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
+static void ImFontAtlasBuildGatherRectsJob(void* job_user_data, int job_index)
+{
+    ImFontBuildJobsData* data = (ImFontBuildJobsData*)job_user_data;
+    const ImFontBuildGlyphsJob& job = data->Jobs[job_index];
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[job.SrcIndex];
+    const ImFontConfig& cfg = data->Atlas->ConfigData[job.SrcIndex];
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    font_info.userdata = &data->Allocator;
+
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&font_info, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&font_info, -cfg.SizePixels);
+    const int padding = data->Atlas->TexGlyphPadding;
+    for (int glyph_i = job.GlyphsStart; glyph_i < job.GlyphsStart + job.GlyphsCount; glyph_i++)
+    {
+        int x0, y0, x1, y1;
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&font_info, src_tmp.GlyphsList[glyph_i]);
+        IM_ASSERT(glyph_index_in_font != 0);
+        stbtt_GetGlyphBitmapBoxSubpixel(&font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+    }
+}
+
+// Render/rasterize font characters into their packed rectangle of the texture
+static void ImFontAtlasBuildRenderGlyphsJob(void* job_user_data, int job_index)
+{
+    ImFontBuildJobsData* data = (ImFontBuildJobsData*)job_user_data;
+    const ImFontBuildGlyphsJob& job = data->Jobs[job_index];
+    ImFontAtlas* atlas = data->Atlas;
+    ImFontBuildSrcData& src_tmp = data->SrcTmpArray[job.SrcIndex];
+    const ImFontConfig& cfg = atlas->ConfigData[job.SrcIndex];
+    stbtt_fontinfo font_info = src_tmp.FontInfo;
+    font_info.userdata = &data->Allocator;
+
+    // stbtt_PackFontRangesRenderIntoRects() temporarily modifies the pack context, so each job uses a copy of it.
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints += job.GlyphsStart;
+    pack_range.chardata_for_range += job.GlyphsStart;
+    pack_range.num_chars = job.GlyphsCount;
+    stbrp_rect* rects = src_tmp.Rects + job.GlyphsStart;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &font_info, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < job.GlyphsCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
 bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
 
     ImFontAtlasBuildInit(atlas);
+    ImFontAtlasBuildClearDynamicGlyphs(atlas);
+    atlas->ClearTexDirtyRects();
+    const bool dynamic_glyphs = (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) != 0;
 
     // Clear atlas
     atlas->TexID = (ImTextureID)NULL;
@@ -2130,6 +2820,8 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.GlyphsSet.Create(src_tmp.GlyphsHighest + 1);
         if (dst_tmp.GlyphsSet.Storage.empty())
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
+        if (dynamic_glyphs)
+            src_tmp.GlyphsDeferredSet.Create(src_tmp.GlyphsHighest + 1);
 
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
             for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
@@ -2138,6 +2830,12 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                     continue;
                 if (!stbtt_FindGlyphIndex(&src_tmp.FontInfo, codepoint))    // It is actually in the font?
                     continue;
+                if (dynamic_glyphs && codepoint > 0xFF)                     // Rasterized on demand by BuildDynamicGlyphs()
+                {
+                    src_tmp.GlyphsDeferredSet.SetBit(codepoint);
+                    dst_tmp.GlyphsSet.SetBit(codepoint);
+                    continue;
+                }
 
                 // Add to avail set/counters
                 src_tmp.GlyphsCount++;
@@ -2171,7 +2869,12 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
-    int total_surface = 0;
+    // Each source font is split into jobs of up to GLYPHS_PER_JOB glyphs, which may run on worker threads (see ImFontAtlas::ParallelForFn).
+    const int GLYPHS_PER_JOB = 256;
+    ImFontBuildJobsData jobs_data;
+    jobs_data.Atlas = atlas;
+    jobs_data.SrcTmpArray = src_tmp_array.Data;
+    jobs_data.PackContext = NULL;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
@@ -2195,34 +2898,33 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         src_tmp.PackRange.h_oversample = (unsigned char)cfg.OversampleH;
         src_tmp.PackRange.v_oversample = (unsigned char)cfg.OversampleV;
 
-        // Gather the sizes of all rectangles we will need to pack (this loop is based on stbtt_PackFontRangesGatherRects)
-        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp.FontInfo, -cfg.SizePixels);
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i += GLYPHS_PER_JOB)
         {
-            int x0, y0, x1, y1;
-            const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
-            IM_ASSERT(glyph_index_in_font != 0);
-            stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+            ImFontBuildGlyphsJob job = { src_i, glyph_i, ImMin(GLYPHS_PER_JOB, src_tmp.GlyphsCount - glyph_i) };
+            jobs_data.Jobs.push_back(job);
         }
     }
+    ImFontAtlasBuildParallelFor(atlas, ImFontAtlasBuildGatherRectsJob, &jobs_data, jobs_data.Jobs.Size);
+    int total_surface = 0;
+    for (int rect_i = 0; rect_i < buf_rects.Size; rect_i++)
+        total_surface += buf_rects[rect_i].w * buf_rects[rect_i].h;
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
     // User can override TexDesiredWidth and TexGlyphPadding if they wish, otherwise we use a simple heuristic to select the width based on expected surface.
+    // With ImFontAtlasFlags_DynamicGlyphs the texture is square and its size doesn't change after building, as glyphs are packed on demand.
     const int surface_sqrt = (int)ImSqrt((float)total_surface) + 1;
     atlas->TexHeight = 0;
     if (atlas->TexDesiredWidth > 0)
         atlas->TexWidth = atlas->TexDesiredWidth;
+    else if (dynamic_glyphs)
+        atlas->TexWidth = 1024;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
-    const int TEX_HEIGHT_MAX = 1024 * 32;
+    const int TEX_HEIGHT_MAX = dynamic_glyphs ? atlas->TexWidth : 1024 * 32;
     stbtt_pack_context spc = {};
     stbtt_PackBegin(&spc, NULL, atlas->TexWidth, TEX_HEIGHT_MAX, 0, atlas->TexGlyphPadding, NULL);
     ImFontAtlasBuildPackCustomRects(atlas, spc.pack_info);
@@ -2244,7 +2946,10 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 7. Allocate texture
-    atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
+    if (dynamic_glyphs)
+        atlas->TexHeight = TEX_HEIGHT_MAX;
+    else
+        atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
     memset(atlas->TexPixelsAlpha8, 0, atlas->TexWidth * atlas->TexHeight);
@@ -2252,30 +2957,29 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    jobs_data.PackContext = &spc;
+    ImFontAtlasBuildParallelFor(atlas, ImFontAtlasBuildRenderGlyphsJob, &jobs_data, jobs_data.Jobs.Size);
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
-    {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
-        ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
+        src_tmp_array[src_i].Rects = NULL;
 
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+    // End packing (with ImFontAtlasFlags_DynamicGlyphs, the packing context is kept for BuildDynamicGlyphs())
+    if (dynamic_glyphs)
+    {
+        ImFontAtlasDynamicData* dyn = IM_NEW(ImFontAtlasDynamicData)();
+        dyn->PackContext = spc;
+        dyn->Sources.resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            IM_PLACEMENT_NEW(&dyn->Sources[src_i]) ImFontDynamicSrcData();
+            dyn->Sources[src_i].FontInfo = src_tmp_array[src_i].FontInfo;
+            dyn->Sources[src_i].GlyphsSet.Storage.swap(src_tmp_array[src_i].GlyphsDeferredSet.Storage);
         }
-        src_tmp.Rects = NULL;
+        atlas->DynamicGlyphsData = dyn;
+    }
+    else
+    {
+        stbtt_PackEnd(&spc);
     }
-
-    // End packing
-    stbtt_PackEnd(&spc);
     buf_rects.clear();
 
     // 9. Setup ImFont and glyphs for runtime
@@ -2321,6 +3025,420 @@ bool    ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     return true;
 }
 
+bool    ImFontAtlas::BuildDynamicGlyphs()
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasDynamicData* dyn = (ImFontAtlasDynamicData*)DynamicGlyphsData;
+    if (dyn == NULL || dyn->Requests.Size == 0)
+        return false;
+    IM_ASSERT(TexPixelsAlpha8 != NULL && "Don't call ClearTexData() when using ImFontAtlasFlags_DynamicGlyphs!");
+    if (TexPixelsAlpha8 == NULL)
+        return false;
+
+    stbtt_pack_context& spc = dyn->PackContext;
+    spc.pixels = TexPixelsAlpha8;
+    int added_glyphs_count = 0;
+    for (int req_i = 0; req_i < dyn->Requests.Size; req_i++)
+    {
+        const ImFontDynamicGlyphRequest& req = dyn->Requests[req_i];
+        ImFontDynamicSrcData& src = dyn->Sources[req.SrcIndex];
+        ImFontConfig& cfg = ConfigData[req.SrcIndex];
+        ImFont* dst_font = cfg.DstFont;
+
+        // Measure and pack the glyph (same as ImFontAtlasBuildWithStbTruetype)
+        int codepoint = req.Codepoint;
+        stbtt_packedchar packed_char;
+        stbtt_pack_range pack_range = {};
+        pack_range.font_size = cfg.SizePixels;
+        pack_range.array_of_unicode_codepoints = &codepoint;
+        pack_range.num_chars = 1;
+        pack_range.chardata_for_range = &packed_char;
+        pack_range.h_oversample = (unsigned char)cfg.OversampleH;
+        pack_range.v_oversample = (unsigned char)cfg.OversampleV;
+
+        const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src.FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src.FontInfo, -cfg.SizePixels);
+        int x0, y0, x1, y1;
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&src.FontInfo, codepoint);
+        stbtt_GetGlyphBitmapBoxSubpixel(&src.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+        stbrp_rect rect = {};
+        rect.w = (stbrp_coord)(x1 - x0 + TexGlyphPadding + cfg.OversampleH - 1);
+        rect.h = (stbrp_coord)(y1 - y0 + TexGlyphPadding + cfg.OversampleV - 1);
+        stbrp_pack_rects((stbrp_context*)spc.pack_info, &rect, 1);
+        if (!rect.was_packed)
+        {
+            // Texture is full: glyph uses the fallback character. Keep it requestable so it is retried the next time it is used,
+            // and report it in DynamicGlyphsMissingCount (call Build() again with a larger TexDesiredWidth to make room).
+            src.GlyphsSet.SetBit(codepoint);
+            if (src.GlyphsMissingSet.Storage.Size == 0)
+                src.GlyphsMissingSet.Create(src.GlyphsSet.Storage.Size * 32);
+            if (!src.GlyphsMissingSet.TestBit(codepoint))
+            {
+                src.GlyphsMissingSet.SetBit(codepoint);
+                DynamicGlyphsMissingCount++;
+            }
+            continue;
+        }
+
+        // Render
+        stbtt_PackFontRangesRenderIntoRects(&spc, &src.FontInfo, &pack_range, 1, &rect);
+        if (cfg.RasterizerMultiply != 1.0f)
+        {
+            unsigned char multiply_table[256];
+            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+            ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, TexPixelsAlpha8, rect.x, rect.y, rect.w, rect.h, TexWidth * 1);
+        }
+        ImFontAtlasBuildUpdateTexRect(this, rect.x, rect.y, rect.w, rect.h);
+
+        // Register glyph. The TAB glyph is added last by BuildLookupTable(), remove it so it doesn't get duplicated.
+        if (dst_font->Glyphs.Size > 0 && dst_font->Glyphs.back().Codepoint == '\t')
+            dst_font->Glyphs.pop_back();
+        const float font_off_x = cfg.GlyphOffset.x;
+        const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(dst_font->Ascent);
+        stbtt_aligned_quad q;
+        float unused_x = 0.0f, unused_y = 0.0f;
+        stbtt_GetPackedQuad(&packed_char, TexWidth, TexHeight, 0, &unused_x, &unused_y, &q, 0);
+        dst_font->AddGlyph(&cfg, (ImWchar)codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, packed_char.xadvance);
+        added_glyphs_count++;
+    }
+    dyn->Requests.resize(0);
+    if (added_glyphs_count == 0)
+        return false;
+
+    for (int i = 0; i < Fonts.Size; i++)
+        if (Fonts[i]->DirtyLookupTables)
+            Fonts[i]->BuildLookupTable();
+    GlyphsVersion++;
+    return true;
+}
+
+void    ImFontAtlas::AddTexDirtyRect(int x, int y, int w, int h)
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
+    IM_ASSERT(x >= 0 && y >= 0 && x + w <= TexWidth && y + h <= TexHeight);
+    if (w <= 0 || h <= 0)
+        return;
+
+    // Merge with an existing rectangle if their bounding box doesn't waste more than half of their area
+    // (uploading a few extra pixels is cheaper than issuing many small uploads)
+    for (int n = 0; n < TexDirtyRects.Size; n++)
+    {
+        ImFontAtlasRect& r = TexDirtyRects[n];
+        const int min_x = ImMin((int)r.X, x), min_y = ImMin((int)r.Y, y);
+        const int max_x = ImMax((int)r.X + r.Width, x + w), max_y = ImMax((int)r.Y + r.Height, y + h);
+        if ((max_x - min_x) * (max_y - min_y) * 2 > (r.Width * r.Height + w * h) * 3)
+            continue;
+        r.X = (unsigned short)min_x;
+        r.Y = (unsigned short)min_y;
+        r.Width = (unsigned short)(max_x - min_x);
+        r.Height = (unsigned short)(max_y - min_y);
+        return;
+    }
+
+    // Collapse into a single bounding box when there are too many rectangles
+    ImFontAtlasRect new_r = { (unsigned short)x, (unsigned short)y, (unsigned short)w, (unsigned short)h };
+    if (TexDirtyRects.Size >= 32)
+    {
+        int min_x = x, min_y = y, max_x = x + w, max_y = y + h;
+        for (int n = 0; n < TexDirtyRects.Size; n++)
+        {
+            const ImFontAtlasRect& r = TexDirtyRects[n];
+            min_x = ImMin(min_x, (int)r.X);
+            min_y = ImMin(min_y, (int)r.Y);
+            max_x = ImMax(max_x, (int)r.X + r.Width);
+            max_y = ImMax(max_y, (int)r.Y + r.Height);
+        }
+        new_r.X = (unsigned short)min_x;
+        new_r.Y = (unsigned short)min_y;
+        new_r.Width = (unsigned short)(max_x - min_x);
+        new_r.Height = (unsigned short)(max_y - min_y);
+        TexDirtyRects.resize(0);
+    }
+    TexDirtyRects.push_back(new_r);
+}
+
+// Pre-built atlas cache (see LoadBuildCacheFromMemory())
+// Layout, in native endianness, each section padded to 4 bytes:
+// - ImFontAtlasCacheHeader
+// - For each font: ImFontAtlasCacheFont, Glyphs[], IndexAdvanceX[], IndexLookup[]
+// - For each custom rectangle: X, Y
+// - TexPixelsAlpha8[]
+#define IM_FONT_ATLAS_CACHE_MAGIC       0x41464D49  // "IMFA"
+#define IM_FONT_ATLAS_CACHE_VERSION     2
+
+struct ImFontAtlasCacheHeader
+{
+    ImU32       Magic;
+    ImU32       Version;
+    ImU32       BuildHash;          // CalcBuildCacheHash() of the atlas when saving
+    int         TexWidth, TexHeight;
+    int         FontsCount;
+    int         CustomRectsCount;
+    ImVec2      TexUvWhitePixel;
+    ImVec4      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];
+};
+
+struct ImFontAtlasCacheFont
+{
+    float       Ascent, Descent;
+    float       FallbackAdvanceX;
+    int         MetricsTotalSurface;
+    int         FallbackGlyphIndex; // Index into Glyphs[], -1 if none
+    int         GlyphsCount;
+    int         IndexSize;          // IndexAdvanceX.Size == IndexLookup.Size
+    ImWchar     FallbackChar;
+    ImWchar     EllipsisChar;
+    ImU8        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8];
+};
+
+static void ImFontAtlasCacheWrite(ImVector<unsigned char>* buf, const void* data, size_t data_size)
+{
+    const int pos = buf->Size;
+    buf->resize(pos + (int)((data_size + 3) & ~(size_t)3));
+    memcpy(buf->Data + pos, data, data_size);
+    memset(buf->Data + pos + data_size, 0, buf->Size - pos - data_size);
+}
+
+struct ImFontAtlasCacheReader
+{
+    const unsigned char*    Data;
+    size_t                  DataSize;
+    size_t                  Pos;
+
+    ImFontAtlasCacheReader(const void* data, size_t data_size) { Data = (const unsigned char*)data; DataSize = data_size; Pos = 0; }
+    bool Read(void* dst, size_t size)
+    {
+        if (size > DataSize - Pos)
+            return false;
+        memcpy(dst, Data + Pos, size);
+        Pos = ImMin(Pos + ((size + 3) & ~(size_t)3), DataSize);
+        return true;
+    }
+    template<typename T>
+    bool ReadVector(ImVector<T>* dst, int count)
+    {
+        if (count < 0 || (size_t)count > (DataSize - Pos) / sizeof(T))
+            return false;
+        dst->resize(count);
+        return count == 0 || Read(dst->Data, (size_t)count * sizeof(T));
+    }
+};
+
+ImU32   ImFontAtlas::CalcBuildCacheHash()
+{
+    // Register default custom rectangles like Build() does, so the hash is the same before and after building
+    ImFontAtlasBuildInit(this);
+
+    // Serialized layout
+    ImU32 hash = IM_FONT_ATLAS_CACHE_VERSION;
+    const int layout[] = { (int)sizeof(ImWchar), (int)sizeof(ImFontGlyph), (int)sizeof(ImFontAtlasCacheHeader), (int)sizeof(ImFontAtlasCacheFont) };
+    hash = ImHashData(layout, sizeof(layout), hash);
+
+    // Atlas settings
+    hash = ImHashData(&Flags, sizeof(Flags), hash);
+    hash = ImHashData(&TexDesiredWidth, sizeof(TexDesiredWidth), hash);
+    hash = ImHashData(&TexGlyphPadding, sizeof(TexGlyphPadding), hash);
+    hash = ImHashData(&Fonts.Size, sizeof(Fonts.Size), hash);
+
+    // Source fonts. Hash fields one by one (ImFontConfig has padding and pointers)
+    for (int i = 0; i < ConfigData.Size; i++)
+    {
+        const ImFontConfig& cfg = ConfigData[i];
+        const int dst_index = Fonts.index_from_ptr(Fonts.find(cfg.DstFont));
+        hash = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, hash);
+        hash = ImHashData(&cfg.FontDataSize, sizeof(cfg.FontDataSize), hash);
+        hash = ImHashData(&cfg.FontNo, sizeof(cfg.FontNo), hash);
+        hash = ImHashData(&cfg.SizePixels, sizeof(cfg.SizePixels), hash);
+        hash = ImHashData(&cfg.OversampleH, sizeof(cfg.OversampleH), hash);
+        hash = ImHashData(&cfg.OversampleV, sizeof(cfg.OversampleV), hash);
+        hash = ImHashData(&cfg.PixelSnapH, sizeof(cfg.PixelSnapH), hash);
+        hash = ImHashData(&cfg.GlyphExtraSpacing, sizeof(cfg.GlyphExtraSpacing), hash);
+        hash = ImHashData(&cfg.GlyphOffset, sizeof(cfg.GlyphOffset), hash);
+        hash = ImHashData(&cfg.GlyphMinAdvanceX, sizeof(cfg.GlyphMinAdvanceX), hash);
+        hash = ImHashData(&cfg.GlyphMaxAdvanceX, sizeof(cfg.GlyphMaxAdvanceX), hash);
+        hash = ImHashData(&cfg.MergeMode, sizeof(cfg.MergeMode), hash);
+        hash = ImHashData(&cfg.RasterizerFlags, sizeof(cfg.RasterizerFlags), hash);
+        hash = ImHashData(&cfg.RasterizerMultiply, sizeof(cfg.RasterizerMultiply), hash);
+        hash = ImHashData(&cfg.EllipsisChar, sizeof(cfg.EllipsisChar), hash);
+        hash = ImHashData(&dst_index, sizeof(dst_index), hash);
+        if (const ImWchar* ranges = cfg.GlyphRanges)
+        {
+            int ranges_count = 0;
+            while (ranges[ranges_count])
+                ranges_count += 2;
+            hash = ImHashData(ranges, (size_t)ranges_count * sizeof(ImWchar), hash);
+        }
+    }
+
+    // Custom rectangles
+    for (int i = 0; i < CustomRects.Size; i++)
+    {
+        const ImFontAtlasCustomRect& r = CustomRects[i];
+        const int dst_index = r.Font ? Fonts.index_from_ptr(Fonts.find(r.Font)) : -1;
+        hash = ImHashData(&r.Width, sizeof(r.Width), hash);
+        hash = ImHashData(&r.Height, sizeof(r.Height), hash);
+        hash = ImHashData(&r.GlyphID, sizeof(r.GlyphID), hash);
+        hash = ImHashData(&r.GlyphAdvanceX, sizeof(r.GlyphAdvanceX), hash);
+        hash = ImHashData(&r.GlyphOffset, sizeof(r.GlyphOffset), hash);
+        hash = ImHashData(&dst_index, sizeof(dst_index), hash);
+    }
+    return hash;
+}
+
+bool    ImFontAtlas::SaveBuildCacheToMemory(ImVector<unsigned char>* out_data)
+{
+    IM_ASSERT(out_data != NULL);
+    if (TexPixelsAlpha8 == NULL || Fonts.Size == 0 || (Flags & ImFontAtlasFlags_DynamicGlyphs))
+        return false;
+
+    ImFontAtlasCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    header.Magic = IM_FONT_ATLAS_CACHE_MAGIC;
+    header.Version = IM_FONT_ATLAS_CACHE_VERSION;
+    header.BuildHash = CalcBuildCacheHash();
+    header.TexWidth = TexWidth;
+    header.TexHeight = TexHeight;
+    header.FontsCount = Fonts.Size;
+    header.CustomRectsCount = CustomRects.Size;
+    header.TexUvWhitePixel = TexUvWhitePixel;
+    memcpy(header.TexUvLines, TexUvLines, sizeof(TexUvLines));
+
+    out_data->resize(0);
+    ImFontAtlasCacheWrite(out_data, &header, sizeof(header));
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+    {
+        const ImFont* font = Fonts[font_n];
+        IM_ASSERT(!font->DirtyLookupTables && font->IndexAdvanceX.Size == font->IndexLookup.Size);
+        ImFontAtlasCacheFont font_header;
+        memset(&font_header, 0, sizeof(font_header));
+        font_header.Ascent = font->Ascent;
+        font_header.Descent = font->Descent;
+        font_header.FallbackAdvanceX = font->FallbackAdvanceX;
+        font_header.MetricsTotalSurface = font->MetricsTotalSurface;
+        font_header.FallbackGlyphIndex = font->FallbackGlyph ? font->Glyphs.index_from_ptr(font->FallbackGlyph) : -1;
+        font_header.GlyphsCount = font->Glyphs.Size;
+        font_header.IndexSize = font->IndexLookup.Size;
+        font_header.FallbackChar = font->FallbackChar;
+        font_header.EllipsisChar = font->EllipsisChar;
+        memcpy(font_header.Used4kPagesMap, font->Used4kPagesMap, sizeof(font->Used4kPagesMap));
+        ImFontAtlasCacheWrite(out_data, &font_header, sizeof(font_header));
+        ImFontAtlasCacheWrite(out_data, font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+        ImFontAtlasCacheWrite(out_data, font->IndexAdvanceX.Data, (size_t)font->IndexAdvanceX.size_in_bytes());
+        ImFontAtlasCacheWrite(out_data, font->IndexLookup.Data, (size_t)font->IndexLookup.size_in_bytes());
+    }
+    for (int i = 0; i < CustomRects.Size; i++)
+    {
+        const unsigned short pos[2] = { CustomRects[i].X, CustomRects[i].Y };
+        ImFontAtlasCacheWrite(out_data, pos, sizeof(pos));
+    }
+    ImFontAtlasCacheWrite(out_data, TexPixelsAlpha8, (size_t)TexWidth * TexHeight);
+    return true;
+}
+
+bool    ImFontAtlas::LoadBuildCacheFromMemory(const void* data, size_t data_size)
+{
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    IM_ASSERT(ConfigData.Size > 0);
+    if (Flags & ImFontAtlasFlags_DynamicGlyphs)
+        return false;
+
+    ImFontAtlasCacheReader reader(data, data_size);
+    ImFontAtlasCacheHeader header;
+    if (!reader.Read(&header, sizeof(header)) || header.Magic != IM_FONT_ATLAS_CACHE_MAGIC || header.Version != IM_FONT_ATLAS_CACHE_VERSION)
+        return false;
+    if (header.BuildHash != CalcBuildCacheHash() || header.FontsCount != Fonts.Size || header.CustomRectsCount != CustomRects.Size)
+        return false;
+    if (header.TexWidth <= 0 || header.TexHeight <= 0 || (size_t)header.TexWidth * header.TexHeight > data_size)
+        return false;
+
+    // Clear atlas, same as Build()
+    TexID = (ImTextureID)NULL;
+    ClearTexData();
+    ClearTexDirtyRects();
+    TexWidth = header.TexWidth;
+    TexHeight = header.TexHeight;
+    TexUvScale = ImVec2(1.0f / TexWidth, 1.0f / TexHeight);
+    TexUvWhitePixel = header.TexUvWhitePixel;
+    memcpy(TexUvLines, header.TexUvLines, sizeof(TexUvLines));
+
+    // Setup fonts, same as Build() (this also sets ConfigData/ConfigDataCount, which are not taken from the cache)
+    for (int i = 0; i < ConfigData.Size; i++)
+        ImFontAtlasBuildSetupFont(this, ConfigData[i].DstFont, &ConfigData[i], 0.0f, 0.0f);
+
+    bool ret = true;
+    for (int font_n = 0; font_n < Fonts.Size && ret; font_n++)
+    {
+        ImFont* font = Fonts[font_n];
+        ImFontAtlasCacheFont font_header;
+        ret = reader.Read(&font_header, sizeof(font_header));
+        ret = ret && reader.ReadVector(&font->Glyphs, font_header.GlyphsCount);
+        ret = ret && reader.ReadVector(&font->IndexAdvanceX, font_header.IndexSize);
+        ret = ret && reader.ReadVector(&font->IndexLookup, font_header.IndexSize);
+        ret = ret && font_header.FallbackGlyphIndex < font_header.GlyphsCount;
+        for (int i = 0; i < font->IndexLookup.Size && ret; i++) // FindGlyph() indexes Glyphs[] without checking
+            ret = (font->IndexLookup.Data[i] == (ImWchar)-1 || (int)font->IndexLookup.Data[i] < font_header.GlyphsCount);
+        if (!ret)
+            break;
+        font->Ascent = font_header.Ascent;
+        font->Descent = font_header.Descent;
+        font->FallbackAdvanceX = font_header.FallbackAdvanceX;
+        font->MetricsTotalSurface = font_header.MetricsTotalSurface;
+        font->FallbackGlyph = (font_header.FallbackGlyphIndex >= 0) ? &font->Glyphs[font_header.FallbackGlyphIndex] : NULL;
+        font->FallbackChar = font_header.FallbackChar;
+        font->EllipsisChar = font_header.EllipsisChar;
+        memcpy(font->Used4kPagesMap, font_header.Used4kPagesMap, sizeof(font->Used4kPagesMap));
+        font->DirtyLookupTables = false;
+    }
+    GlyphsVersion++;
+    for (int i = 0; i < CustomRects.Size && ret; i++)
+    {
+        unsigned short pos[2] = { 0, 0 };
+        ret = reader.Read(pos, sizeof(pos));
+        ret = ret && (pos[0] == 0xFFFF || pos[0] + CustomRects[i].Width <= TexWidth) && (pos[1] == 0xFFFF || pos[1] + CustomRects[i].Height <= TexHeight);
+        CustomRects[i].X = pos[0];
+        CustomRects[i].Y = pos[1];
+    }
+    if (ret)
+    {
+        TexPixelsAlpha8 = (unsigned char*)IM_ALLOC((size_t)TexWidth * TexHeight);
+        ret = reader.Read(TexPixelsAlpha8, (size_t)TexWidth * TexHeight);
+    }
+    if (!ret)
+    {
+        // Truncated or corrupted data: leave the atlas unbuilt
+        ClearTexData();
+        for (int font_n = 0; font_n < Fonts.Size; font_n++)
+            Fonts[font_n]->ClearOutputData();
+        TexWidth = TexHeight = 0;
+    }
+    return ret;
+}
+
+bool    ImFontAtlas::LoadBuildCacheFromFile(const char* filename)
+{
+    size_t data_size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &data_size, 0);
+    if (!data)
+        return false;
+    bool ret = LoadBuildCacheFromMemory(data, data_size);
+    IM_FREE(data);
+    return ret;
+}
+
+bool    ImFontAtlas::SaveBuildCacheToFile(const char* filename)
+{
+    ImVector<unsigned char> data;
+    if (!SaveBuildCacheToMemory(&data))
+        return false;
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    bool ret = ImFileWrite(data.Data, 1, (ImU64)data.Size, f) == (ImU64)data.Size;
+    ImFileClose(f);
+    return ret;
+}
+
 void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent)
 {
     if (!font_config->MergeMode)
@@ -2453,6 +3571,8 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
 // This is called/shared by both the stb_truetype and the FreeType builder.
 void ImFontAtlasBuildFinish(ImFontAtlas* atlas)
 {
+    atlas->GlyphsVersion++;
+
     // Render into our custom data blocks
     IM_ASSERT(atlas->TexPixelsAlpha8 != NULL);
     ImFontAtlasBuildRenderDefaultTexData(atlas);
@@ -2824,6 +3944,7 @@ void    ImFont::ClearOutputData()
 
 void ImFont::BuildLookupTable()
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     int max_codepoint = 0;
     for (int i = 0; i != Glyphs.Size; i++)
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
@@ -2899,6 +4020,7 @@ void ImFont::SetFallbackChar(ImWchar c)
 
 void ImFont::GrowIndex(int new_size)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
     if (new_size <= IndexLookup.Size)
         return;
@@ -2911,6 +4033,7 @@ void ImFont::GrowIndex(int new_size)
 // 'cfg' is not necessarily == 'this->ConfigData' because multiple source fonts+configs can be used to build one target font.
 void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     if (cfg != NULL)
     {
         // Clamp & recenter if needed
@@ -2954,6 +4077,7 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
 
 void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     IM_ASSERT(IndexLookup.Size > 0);    // Currently this can only be called AFTER the font has been built, aka after calling ImFontAtlas::GetTexDataAs*() function.
     unsigned int index_size = (unsigned int)IndexLookup.Size;
 
@@ -2969,11 +4093,13 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
 {
-    if (c >= (size_t)IndexLookup.Size)
-        return FallbackGlyph;
-    const ImWchar i = IndexLookup.Data[c];
+    const ImWchar i = (c < (size_t)IndexLookup.Size) ? IndexLookup.Data[c] : (ImWchar)-1;
     if (i == (ImWchar)-1)
+    {
+        if (ContainerAtlas && ContainerAtlas->DynamicGlyphsData)
+            ImFontAtlasBuildRequestDynamicGlyph(ContainerAtlas, this, (unsigned int)c);
         return FallbackGlyph;
+    }
     return &Glyphs.Data[i];
 }
 
@@ -3021,7 +4147,7 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
         if (c < 0x80)
             next_s = s + 1;
         else
-            next_s = s + ImTextCharFromUtf8(&c, s, text_end);
+            next_s = s + ImTextCharFromUtf8Inline(&c, s, text_end);
         if (c == 0)
             break;
 
@@ -3087,6 +4213,12 @@ const char* ImFont::CalcWordWrapPositionA(float scale, const char* text, const c
 }
 
 ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining) const
+{
+    return CalcTextSizeEx(size, max_width, wrap_width, text_begin, text_end, remaining, NULL);
+}
+
+// Also output the successive word-wrapping positions, as offsets from text_begin (see ImGuiTextLayoutCache).
+ImVec2 ImFont::CalcTextSizeEx(float size, float max_width, float wrap_width, const char* text_begin, const char* text_end, const char** remaining, ImVector<int>* out_line_breaks) const
 {
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // FIXME-OPT: Need to avoid this.
@@ -3111,6 +4243,8 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - line_width);
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
                     word_wrap_eol++;    // +1 may not be a character start point in UTF-8 but it's ok because we use s >= word_wrap_eol below
+                if (out_line_breaks)
+                    out_line_breaks->push_back((int)(word_wrap_eol - text_begin));
             }
 
             if (s >= word_wrap_eol)
@@ -3131,6 +4265,24 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
             }
         }
 
+        // Fast path for runs of printable ASCII characters, which need no decoding nor control characters handling
+        if ((signed char)*s > 0x1F)
+        {
+            const char* run_end = ImTextSkipPrintableAscii(s, (word_wrap_enabled && word_wrap_eol < text_end) ? word_wrap_eol : text_end);
+            const int index_size = IndexAdvanceX.Size;
+            for (; s < run_end; s++)
+            {
+                const int c = (unsigned char)*s;
+                const float char_width = (c < index_size ? IndexAdvanceX.Data[c] : FallbackAdvanceX) * scale;
+                if (line_width + char_width >= max_width)
+                    break;
+                line_width += char_width;
+            }
+            if (s < run_end)
+                break;
+            continue;
+        }
+
         // Decode and advance source
         const char* prev_s = s;
         unsigned int c = (unsigned int)*s;
@@ -3140,7 +4292,7 @@ ImVec2 ImFont::CalcTextSizeA(float size, float max_width, float wrap_width, cons
         }
         else
         {
-            s += ImTextCharFromUtf8(&c, s, text_end);
+            s += ImTextCharFromUtf8Inline(&c, s, text_end);
             if (c == 0) // Malformed UTF-8?
                 break;
         }
@@ -3197,6 +4349,16 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     if (!text_end)
         text_end = text_begin + strlen(text_begin); // ImGui:: functions generally already provides a valid text_end, so this is merely to handle direct calls.
 
+    if (draw_list->Flags & ImDrawListFlags_HashCommands)
+    {
+        const float params[] = { size, pos.x, pos.y, clip_rect.x, clip_rect.y, clip_rect.z, clip_rect.w, wrap_width, cpu_fine_clip ? 1.0f : 0.0f };
+        const ImFont* font = this;
+        ImDrawList_HashCommand(draw_list, ImDrawListHashCmd_Text, col, &font, sizeof(font), params, sizeof(params));
+        ImDrawList_HashCommand(draw_list, ImDrawListHashCmd_Text, ContainerAtlas ? (ImU32)ContainerAtlas->GlyphsVersion : 0, text_begin, (size_t)(text_end - text_begin));
+        if (draw_list->Flags & ImDrawListFlags_HashOnly)
+            return;
+    }
+
     // Align to be pixel perfect
     pos.x = IM_FLOOR(pos.x);
     pos.y = IM_FLOOR(pos.y);
@@ -3210,6 +4372,16 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     const bool word_wrap_enabled = (wrap_width > 0.0f);
     const char* word_wrap_eol = NULL;
 
+    // Reuse word-wrapping positions computed by a previous call to ImGui::CalcTextSize() on the same text, if any
+    const int* line_breaks = NULL;
+    int line_breaks_count = 0, line_breaks_n = 0;
+    if (word_wrap_enabled && draw_list->_Data->TextLayoutCache)
+        if (const ImGuiTextLayout* layout = draw_list->_Data->TextLayoutCache->Find(ImGuiTextLayoutCache::CalcKey(this, size, wrap_width, text_begin, text_end), (int)(text_end - text_begin)))
+        {
+            line_breaks = layout->LineBreaks.Data;
+            line_breaks_count = layout->LineBreaks.Size;
+        }
+
     // Fast-forward to first visible line
     const char* s = text_begin;
     if (y + line_height < clip_rect.y && !word_wrap_enabled)
@@ -3252,7 +4424,11 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         if (word_wrap_enabled)
         {
             // Calculate how far we can render. Requires two passes on the string data but keeps the code simple and not intrusive for what's essentially an uncommon feature.
-            if (!word_wrap_eol)
+            if (!word_wrap_eol && line_breaks_n < line_breaks_count)
+            {
+                word_wrap_eol = text_begin + line_breaks[line_breaks_n++];
+            }
+            else if (!word_wrap_eol)
             {
                 word_wrap_eol = CalcWordWrapPositionA(scale, s, text_end, wrap_width - (x - pos.x));
                 if (word_wrap_eol == s) // Wrap_width is too small to fit anything. Force displaying 1 character to minimize the height discontinuity.
@@ -3283,7 +4459,7 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
         }
         else
         {
-            s += ImTextCharFromUtf8(&c, s, text_end);
+            s += ImTextCharFromUtf8Inline(&c, s, text_end);
             if (c == 0) // Malformed UTF-8?
                 break;
         }
@@ -50,6 +50,28 @@ Index of this file:
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
 
+// Enable SSE2/NEON intrinsics if available (define IMGUI_DISABLE_SIMD in imconfig.h to use the scalar code paths only)
+#if !defined(IMGUI_DISABLE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define IMGUI_ENABLE_SSE2
+#include <emmintrin.h>  // SSE2 intrinsics
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>   // NEON intrinsics (AArch64 only: we need vdivq_f32/vsqrtq_f32)
+#endif
+#endif
+
+// Enable hardware CRC32C instructions for ImHashData()/ImHashStr() with IMGUI_USE_CRC32C_HASH
+#if defined(IMGUI_USE_CRC32C_HASH) && !defined(IMGUI_DISABLE_SIMD)
+#if defined(__SSE4_2__) || defined(__AVX__)
+#define IMGUI_ENABLE_SSE4_2_CRC
+#include <nmmintrin.h>  // SSE4.2 intrinsics
+#elif defined(__ARM_FEATURE_CRC32)
+#define IMGUI_ENABLE_ARM_CRC
+#include <arm_acle.h>   // ARMv8 CRC32 intrinsics
+#endif
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (push)
@@ -111,6 +133,9 @@ struct ImGuiStackSizes;             // Storage of stack sizes for debugging/asse
 struct ImGuiStyleMod;               // Stacked style modifier, backup of modified data so we can restore it
 struct ImGuiTabBar;                 // Storage for a tab bar
 struct ImGuiTabItem;                // Storage for a tab item (within a tab bar)
+struct ImGuiTextLayoutCache;        // Cache of word-wrapped text layouts, reused by CalcTextSize() and RenderText()
+struct ImGuiTextLineIndex;          // Line offsets of a long text submitted to TextEx(), extended when the text grows
+struct ImGuiFrameArena;             // Linear allocator for transient allocations, rewound every frame
 struct ImGuiWindow;                 // Storage for one window
 struct ImGuiWindowTempData;         // Temporary storage for one window (that's the data which in theory we could ditch at the end of the frame)
 struct ImGuiWindowSettings;         // Storage for a window .ini settings (we keep one of those even if the actual window wasn't instanced during this session)
@@ -194,6 +219,15 @@ namespace ImStb
 #define IM_ASSERT_USER_ERROR(_EXP,_MSG) IM_ASSERT((_EXP) && _MSG)   // Recoverable User Error
 #endif
 
+// Memory Tags
+// Account allocations made until the end of the current scope to a category (see IMGUI_ENABLE_MEMORY_TAGS and ImGui::SetMemTag()). Compiles to nothing by default.
+#ifdef IMGUI_ENABLE_MEMORY_TAGS
+struct ImGuiMemTagScope { ImGuiMemTag BackupTag; ImGuiMemTagScope(ImGuiMemTag tag) { BackupTag = ImGui::SetMemTag(tag); } ~ImGuiMemTagScope() { ImGui::SetMemTag(BackupTag); } };
+#define IM_MEM_TAG_SCOPE(_TAG)          ImGuiMemTagScope im_mem_tag_scope(_TAG)
+#else
+#define IM_MEM_TAG_SCOPE(_TAG)          ((void)0)
+#endif
+
 // Misc Macros
 #define IM_PI                           3.14159265358979323846f
 #ifdef _WIN32
@@ -275,7 +309,7 @@ IMGUI_API const char*   ImStrchrRange(const char* str_begin, const char* str_end
 IMGUI_API int           ImStrlenW(const ImWchar* str);
 IMGUI_API const char*   ImStreolRange(const char* str, const char* str_end);                // End end-of-line
 IMGUI_API const ImWchar*ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin);   // Find beginning-of-line
-IMGUI_API const char*   ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end);
+IMGUI_API const char*   ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end); // Case-insensitive for ASCII letters only. Uses SSE2/NEON if available.
 IMGUI_API void          ImStrTrimBlanks(char* str);
 IMGUI_API const char*   ImStrSkipBlank(const char* str);
 IMGUI_API int           ImFormatString(char* buf, size_t buf_size, const char* fmt, ...) IM_FMTARGS(3);
@@ -284,6 +318,7 @@ IMGUI_API const char*   ImParseFormatFindStart(const char* format);
 IMGUI_API const char*   ImParseFormatFindEnd(const char* format);
 IMGUI_API const char*   ImParseFormatTrimDecorations(const char* format, char* buf, size_t buf_size);
 IMGUI_API int           ImParseFormatPrecision(const char* format, int default_value);
+static inline char      ImToUpper(char c)               { return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c; }
 static inline bool      ImCharIsBlankA(char c)          { return c == ' ' || c == '\t'; }
 static inline bool      ImCharIsBlankW(unsigned int c)  { return c == ' ' || c == '\t' || c == 0x3000; }
 
@@ -294,6 +329,20 @@ IMGUI_API int           ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char
 IMGUI_API int           ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end);                            // return number of UTF-8 code-points (NOT bytes count)
 IMGUI_API int           ImTextCountUtf8BytesFromChar(const char* in_text, const char* in_text_end);                        // return number of bytes to express one char in UTF-8
 IMGUI_API int           ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end);                   // return number of bytes to express string in UTF-8
+IMGUI_API const char*   ImTextSkipPrintableAscii(const char* in_text, const char* in_text_end);                            // return end of the run of characters 0x20..0x7F starting at in_text (no decoding nor control characters). SSE2/NEON accelerated.
+
+// Same as ImTextCharFromUtf8(), with the common cases inlined: ASCII and well-formed 2/3 bytes sequences (e.g. Latin, Cyrillic, CJK).
+static inline int       ImTextCharFromUtf8Inline(unsigned int* out_char, const char* in_text, const char* in_text_end)
+{
+    const unsigned int c0 = (unsigned char)in_text[0];
+    if (c0 < 0x80) { *out_char = c0; return 1; }
+    const unsigned int c1 = (in_text_end == NULL || in_text + 1 < in_text_end) ? (unsigned char)in_text[1] : 0;
+    if (c0 >= 0xC2 && c0 < 0xE0 && (c1 & 0xC0) == 0x80) { *out_char = ((c0 & 0x1F) << 6) | (c1 & 0x3F); return 2; }
+    const unsigned int c2 = ((c1 & 0xC0) == 0x80 && (in_text_end == NULL || in_text + 2 < in_text_end)) ? (unsigned char)in_text[2] : 0;
+    const unsigned int c = ((c0 & 0x0F) << 12) | ((c1 & 0x3F) << 6) | (c2 & 0x3F);
+    if (c0 >= 0xE0 && c0 < 0xF0 && (c2 & 0xC0) == 0x80 && c >= 0x800 && (c >> 11) != 0x1B) { *out_char = c; return 3; }
+    return ImTextCharFromUtf8(out_char, in_text, in_text_end); // Invalid, incomplete or 4 bytes sequences
+}
 
 // Helpers: ImVec2/ImVec4 operators
 // We are keeping those disabled by default so they don't leak in user space, to allow user enabling implicit cast operators between ImVec2 and their own types (using IM_VEC2_CLASS_EXTRA etc.)
@@ -555,6 +604,7 @@ struct IMGUI_API ImDrawListSharedData
     float           CircleSegmentMaxError;      // Number of circle segments to use per pixel of radius for AddCircle() etc
     ImVec4          ClipRectFullscreen;         // Value for PushClipRectFullscreen()
     ImDrawListFlags InitialFlags;               // Initial flags at the beginning of the frame (it is possible to alter flags on a per-drawlist basis afterwards)
+    ImGuiTextLayoutCache* TextLayoutCache;      // Optional: word-wrapping positions computed by ImGui::CalcTextSize(), reused by ImFont::RenderText()
 
     // [Internal] Lookup tables
     ImVec2          ArcFastVtx[12 * IM_DRAWLIST_ARCFAST_TESSELLATION_MULTIPLIER];  // FIXME: Bake rounded corners fill/borders in atlas
@@ -574,6 +624,87 @@ struct ImDrawDataBuilder
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
+// Layout of a word-wrapped text (see ImGuiTextLayoutCache)
+struct ImGuiTextLayout
+{
+    ImGuiID                 Key;                // Hash of text, font, font size and wrap width (see ImGuiTextLayoutCache::CalcKey)
+    int                     TextLength;         // Checked on lookup, to reduce the odds of a hash collision going unnoticed
+    ImVec2                  Size;               // Output of ImFont::CalcTextSizeA() with max_width = FLT_MAX
+    ImVector<int>           LineBreaks;         // Successive word-wrapping positions, as offsets from the beginning of the text
+    int                     LruPrev, LruNext;   // Index into ImGuiTextLayoutCache::Layouts[] of the previous (more recently used) and next layout
+};
+
+// Least recently used cache of word-wrapped text layouts, so that text wrapped at the same width every frame (e.g. TextWrapped()) is measured once.
+// Layouts are added by ImGui::CalcTextSize() and looked up by ImFont::RenderText() via ImDrawListSharedData::TextLayoutCache.
+// Least recently used layouts are evicted to stay within io.ConfigMemoryTextLayoutCacheSize.
+struct IMGUI_API ImGuiTextLayoutCache
+{
+    ImVector<ImGuiTextLayout> Layouts;
+    ImGuiStorage            Map;                // Key -> Index into Layouts[] + 1 (0 for evicted layouts)
+    int                     LayoutsCount;       // Layouts in use (Layouts.Size minus free ones)
+    int                     StaleKeysCount;     // Keys of evicted layouts still in Map
+    int                     LruHead, LruTail;   // Most and least recently used layouts
+    int                     FreeHead;           // Unused layouts (linked through LruNext)
+    int                     MemoryUsed;         // Approximate memory used by layouts, in bytes
+    int                     MemoryBudget;       // = io.ConfigMemoryTextLayoutCacheSize, applied by NewFrame()
+    int                     HitsCount, MissesCount;     // Lookups during the current frame
+    int                     HitsCountLastFrame, MissesCountLastFrame;
+    ImVector<int>           TempLineBreaks;     // Scratch buffer filled by ImGui::CalcTextSize() then swapped into a new layout
+
+    ImGuiTextLayoutCache()  { LayoutsCount = StaleKeysCount = 0; LruHead = LruTail = FreeHead = -1; MemoryUsed = MemoryBudget = 0; HitsCount = MissesCount = HitsCountLastFrame = MissesCountLastFrame = 0; }
+    ~ImGuiTextLayoutCache() { Clear(); }
+    void                    Clear();
+    static ImGuiID          CalcKey(const ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end);
+    const ImGuiTextLayout*  Find(ImGuiID key, int text_length);     // Return NULL if not cached. Mark layout as most recently used.
+    void                    Add(ImGuiID key, int text_length, const ImVec2& size, ImVector<int>* line_breaks); // Take ownership of line_breaks contents (swapped)
+    void                    Trim(int memory_budget);    // Evict least recently used layouts until memory used is within budget (the most recently used layout is kept)
+};
+
+// Line offsets of a long text (> 2000 bytes) submitted to TextEx() without word-wrapping, so that visible lines can be found without scanning the text.
+// Identified by the text pointer and the window. When the same text is submitted again with a larger size, only the new bytes are scanned
+// (e.g. ImGuiTextBuffer being appended to, whose pointer only changes when its buffer grows). Indices not used during a frame are discarded.
+// Edits which don't change the text size are only detected when they move the line breaks of the visible lines or of the last indexed line.
+struct ImGuiTextLineIndex
+{
+    ImGuiID                 ID;                 // Hash of text pointer, within window ID
+    const char*             Text;
+    int                     TextLength;         // Bytes indexed so far
+    ImVector<int>           LineOffsets;        // Offset of the first character of each line (LineOffsets[0] == 0). The last one may be == TextLength when the text ends with '\n'.
+    float                   MaxWidth;           // Width of the longest line, only maintained once requested (WidthFont != NULL)
+    int                     WidthLinesCount;    // Lines measured into MaxWidth. The last line is measured again when the text grows.
+    ImFont*                 WidthFont;          // Font, font size and atlas glyphs version MaxWidth was measured with
+    float                   WidthFontSize;
+    int                     WidthGlyphsVersion;
+    int                     LastFrameUsed;
+
+    ImGuiTextLineIndex()    { ID = 0; Text = NULL; TextLength = 0; MaxWidth = 0.0f; WidthLinesCount = 0; WidthFont = NULL; WidthFontSize = 0.0f; WidthGlyphsVersion = 0; LastFrameUsed = -1; }
+    void                    ClearLines()    { TextLength = 0; LineOffsets.resize(1); WidthFont = NULL; }
+    int                     GetLinesCount() const { return (LineOffsets.Size > 1 && LineOffsets.back() == TextLength) ? LineOffsets.Size - 1 : LineOffsets.Size; }
+};
+
+// Linear allocator for transient allocations (e.g. InputText() clipboard buffers), rewound by NewFrame().
+// Allocations which don't fit in the buffer (or all of them when io.ConfigMemoryFrameArenaSize == 0) fall back to the heap.
+// Use via ImGui::MemAllocFrame()/MemFreeFrame(): freeing is optional for memory from the buffer, and releases heap fallbacks early.
+struct IMGUI_API ImGuiFrameArena
+{
+    char*                   Data;               // Buffer of Capacity bytes
+    int                     Capacity;           // = io.ConfigMemoryFrameArenaSize, applied by NewFrame()
+    int                     Used;               // Bytes allocated from the buffer during the current frame
+    int                     UsedLastFrame;
+    int                     UsedHighWaterMark;  // Largest value of Used since the buffer was created
+    ImVector<void*>         HeapAllocs;         // Heap fallbacks not freed yet, freed by Reset()
+    int                     AllocsCount;        // Allocations served from the buffer (heap allocations avoided), since creation
+    int                     HeapAllocsCount;    // Allocations which fell back to the heap, since creation
+
+    ImGuiFrameArena()       { Data = NULL; Capacity = Used = UsedLastFrame = UsedHighWaterMark = 0; AllocsCount = HeapAllocsCount = 0; }
+    ~ImGuiFrameArena()      { Clear(); }
+    void                    Clear();
+    void                    Reset(int capacity);
+    void*                   Alloc(size_t size);
+    void                    Free(void* ptr);
+    bool                    Contains(const void* ptr) const { return ptr >= Data && ptr < Data + Capacity; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Widgets support: flags, enums, data structures
 //-----------------------------------------------------------------------------
@@ -874,9 +1005,16 @@ struct IMGUI_API ImGuiInputTextState
     ImGuiInputTextCallback  UserCallback;           // "
     void*                   UserCallbackData;       // "
 
+    // Multi-line: we maintain a line index. Large buffer mode (ImGuiInputTextFlags_LargeBuffer): TextW is also a gap buffer.
+    bool                    LargeBuffer;            // TextW[GapBegin..GapEnd) is unused space, the last element of TextW is always 0. Otherwise GapBegin == GapEnd == 0.
+    int                     GapBegin, GapEnd;       // gap position in TextW (physical indices)
+    ImVector<int>           LineStarts;             // wchar index of the first character of each line (LineStarts[0] == 0). Only maintained for multi-line.
+    int                     LineHint;               // last line returned by a lookup, so sequential row walks from stb_textedit.h are O(1) per row
+
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
+    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; GapBegin = 0; GapEnd = LargeBuffer ? TextW.Size - 1 : 0; LineStarts.resize(Stb.single_line ? 0 : 1, 0); CursorClamp(); }
+    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); LineStarts.clear(); }
+    ImWchar     GetCharW(int idx) const     { return idx < GapBegin ? TextW.Data[idx] : TextW.Data[idx + GapEnd - GapBegin]; }
     int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
     int         GetRedoAvailCount() const   { return STB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
@@ -1163,6 +1301,9 @@ struct ImGuiContext
     float                   FontSize;                           // (Shortcut) == FontBaseSize * g.CurrentWindow->FontWindowScale == window->FontSize(). Text height for current window.
     float                   FontBaseSize;                       // (Shortcut) == IO.FontGlobalScale * Font->Scale * Font->FontSize. Base text height.
     ImDrawListSharedData    DrawListSharedData;
+    ImGuiTextLayoutCache    TextLayoutCache;                    // Word-wrapped text layouts (see io.ConfigMemoryTextLayoutCacheSize)
+    ImVector<ImGuiTextLineIndex> TextLineIndices;               // Line offsets of long texts submitted to TextEx() during the last frame
+    ImGuiFrameArena         FrameArena;                         // Transient allocations (see io.ConfigMemoryFrameArenaSize)
     double                  Time;
     int                     FrameCount;
     int                     FrameCountEnded;
@@ -1294,6 +1435,11 @@ struct ImGuiContext
     // Render
     ImDrawData              DrawData;                           // Main ImDrawData instance to pass render information to the user
     ImDrawDataBuilder       DrawDataBuilder;
+    ImVector<ImDrawList*>   DrawListsToTessellate;              // Temporary array of draw lists with ImDrawListFlags_DeferTessellation primitives, passed to io.ParallelForFn
+    ImVector<ImDrawList*>   DrawListsMerged;                    // Draw lists owned by the context, output of io.ConfigDrawDataMerge
+    ImVector<ImDrawList*>   DrawListsMergeOutput;               // Temporary array of draw lists to render, output of io.ConfigDrawDataMerge
+    int                     DrawDataMergeCmdsBefore;            // Number of draw commands before/after the last io.ConfigDrawDataMerge pass (for Metrics)
+    int                     DrawDataMergeCmdsAfter;
     float                   DimBgRatio;                         // 0.0..1.0 animation when fading in a dimming background (for modal window and CTRL+TAB list)
     ImDrawList              BackgroundDrawList;                 // First draw list to be rendered.
     ImDrawList              ForegroundDrawList;                 // Last draw list to be rendered. This is where we the render software mouse cursor (if io.MouseDrawCursor is set) and most debug overlays.
@@ -1468,6 +1614,7 @@ struct ImGuiContext
         FocusRequestNextCounterRegular = FocusRequestNextCounterTabStop = INT_MAX;
         FocusTabPressed = false;
 
+        DrawDataMergeCmdsBefore = DrawDataMergeCmdsAfter = 0;
         DimBgRatio = 0.0f;
         BackgroundDrawList._OwnerName = "##Background"; // Give it a name for debugging
         ForegroundDrawList._OwnerName = "##Foreground"; // Give it a name for debugging
@@ -1661,6 +1808,8 @@ struct IMGUI_API ImGuiWindow
 
     ImDrawList*             DrawList;                           // == &DrawListInst (for backward compatibility reason with code using imgui_internal.h we keep this a pointer)
     ImDrawList              DrawListInst;
+    ImU32                   DrawListRetainedHash;               // With ImGuiWindowFlags_RetainDrawList: hash of the drawing commands which built the current DrawList buffers
+    int                     DrawListRetainedStableCount;        // With ImGuiWindowFlags_RetainDrawList: number of consecutive full builds which produced DrawListRetainedHash (DrawList buffers are reused once it reaches WINDOWS_RETAIN_DRAW_LIST_STABLE_BUILDS, 0 after a mismatch)
     ImGuiWindow*            ParentWindow;                       // If we are a child _or_ popup window, this is pointing to our parent. Otherwise NULL.
     ImGuiWindow*            RootWindow;                         // Point to ourself or first ancestor that is not a child window == Top-level window.
     ImGuiWindow*            RootWindowForTitleBarHighlight;     // Point to ourself or first ancestor which will display TitleBgActive color when this window is active.
@@ -2067,6 +2216,10 @@ namespace ImGui
     IMGUI_API void          ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1);
     IMGUI_API void          ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
 
+    // Transient allocations, valid until the next call to NewFrame() (see ImGuiFrameArena)
+    IMGUI_API void*         MemAllocFrame(size_t size);
+    IMGUI_API void          MemFreeFrame(void* ptr);
+
     // Garbage collection
     IMGUI_API void          GcCompactTransientMiscBuffers();
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
@@ -2096,6 +2249,20 @@ IMGUI_API void              ImFontAtlasBuildFinish(ImFontAtlas* atlas);
 IMGUI_API void              ImFontAtlasBuildRender1bppRectFromString(ImFontAtlas* atlas, int atlas_x, int atlas_y, int w, int h, const char* in_str, char in_marker_char, unsigned char in_marker_pixel_value);
 IMGUI_API void              ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void              ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
+IMGUI_API void              ImFontAtlasBuildParallelFor(ImFontAtlas* atlas, ImGuiJobFn job_fn, void* job_user_data, int jobs_count);  // Run jobs with atlas->ParallelForFn, or sequentially
+
+// Memory allocator for font atlas build jobs, which may run on worker threads (see ImFontAtlas::ParallelForFn).
+// Calls the functions set by ImGui::SetAllocatorFunctions() directly, bypassing ImGui::MemAlloc() which updates the context's allocation counter.
+struct ImFontAtlasBuildAllocator
+{
+    ImGuiMemAllocFunc   AllocFunc;
+    ImGuiMemFreeFunc    FreeFunc;
+    void*               UserData;
+
+    ImFontAtlasBuildAllocator()                 { ImGui::GetAllocatorFunctions(&AllocFunc, &FreeFunc, &UserData); }
+    void*               Alloc(size_t size)      { return AllocFunc(size, UserData); }
+    void                Free(void* ptr)         { FreeFunc(ptr, UserData); }
+};
 
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
@@ -116,6 +116,7 @@ static const ImU64          IM_U64_MAX = (2ULL * 9223372036854775807LL + 1);
 static bool             InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data);
 static int              InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end);
 static ImVec2           InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining = NULL, ImVec2* out_offset = NULL, bool stop_on_new_line = false);
+static ImGuiTextLineIndex* TextGetLineIndex(ImGuiWindow* window, const char* text, const char* text_end, bool need_width, int verify_line_n);
 
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Text, etc.
@@ -136,6 +137,71 @@ static ImVec2           InputTextCalcTextSizeW(const ImWchar* text_begin, const
 // - BulletTextV()
 //-------------------------------------------------------------------------
 
+// Find the line index of a long text and extend it with bytes added since it was last used (see ImGuiTextLineIndex).
+// The index is rebuilt when the text got shorter, or when the line breaks before the last indexed line or before 'verify_line_n' moved.
+static ImGuiTextLineIndex* TextGetLineIndex(ImGuiWindow* window, const char* text, const char* text_end, bool need_width, int verify_line_n)
+{
+    ImGuiContext& g = *GImGui;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_TextLayout);
+    const ImGuiID id = ImHashData(&text, sizeof(text), window->ID);
+    const int text_length = (int)(text_end - text);
+    ImGuiTextLineIndex* index = NULL;
+    for (int n = 0; n < g.TextLineIndices.Size && index == NULL; n++)
+        if (g.TextLineIndices[n].ID == id && g.TextLineIndices[n].Text == text)
+            index = &g.TextLineIndices[n];
+    if (index == NULL)
+    {
+        g.TextLineIndices.push_back(ImGuiTextLineIndex());
+        index = &g.TextLineIndices.back();
+        index->ID = id;
+        index->Text = text;
+        index->LineOffsets.push_back(0);
+    }
+    else
+    {
+        const int last_offset = index->LineOffsets.back();
+        const int verify_offset = (verify_line_n > 0 && verify_line_n < index->LineOffsets.Size) ? index->LineOffsets[verify_line_n] : 0;
+        if (text_length < index->TextLength || (last_offset > 0 && text[last_offset - 1] != '\n') || (verify_offset > 0 && text[verify_offset - 1] != '\n'))
+            index->ClearLines();
+    }
+    index->LastFrameUsed = g.FrameCount;
+
+    // Index new lines
+    for (const char* line = text + index->TextLength; line < text_end; )
+    {
+        const char* line_end = (const char*)memchr(line, '\n', text_end - line);
+        if (!line_end)
+            break;
+        line = line_end + 1;
+        index->LineOffsets.push_back((int)(line - text));
+    }
+    index->TextLength = text_length;
+
+    // Measure new lines
+    if (need_width)
+    {
+        ImFont* font = g.Font;
+        const int glyphs_version = font->ContainerAtlas ? font->ContainerAtlas->GlyphsVersion : 0;
+        if (index->WidthFont != font || index->WidthFontSize != g.FontSize || index->WidthGlyphsVersion != glyphs_version)
+        {
+            index->WidthFont = font;
+            index->WidthFontSize = g.FontSize;
+            index->WidthGlyphsVersion = glyphs_version;
+            index->WidthLinesCount = 0;
+            index->MaxWidth = 0.0f;
+        }
+        const int lines_count = index->GetLinesCount();
+        for (int line_n = index->WidthLinesCount; line_n < lines_count; line_n++)
+        {
+            const char* line = text + index->LineOffsets[line_n];
+            const char* line_end = (line_n + 1 < index->LineOffsets.Size) ? text + index->LineOffsets[line_n + 1] - 1 : text_end;
+            index->MaxWidth = ImMax(index->MaxWidth, ImGui::CalcTextSize(line, line_end).x);
+        }
+        index->WidthLinesCount = lines_count - 1;
+    }
+    return index;
+}
+
 void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -157,6 +223,7 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
         // Perform manual coarse clipping to optimize for long multi-line text
         // - From this point we will only compute the width of lines that are visible. Optimization only available when word-wrapping is disabled.
         // - We also don't vertically center the text within the line full height, which is unlikely to matter because we are likely the biggest and only item on the line.
+        // - Line offsets and the width of the longest line persist across frames (see ImGuiTextLineIndex), so clipped lines are only scanned once.
         // - We use memchr(), pay attention that well optimized versions of those str/mem functions are much faster than a casually written loop.
         const char* line = text;
         const float line_height = GetTextLineHeight();
@@ -164,23 +231,19 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
 
         // Lines to skip (can't skip when logging text)
         ImVec2 pos = text_pos;
+        ImGuiTextLineIndex* line_index = NULL;
+        int line_n = 0;
         if (!g.LogEnabled)
         {
             int lines_skippable = (int)((window->ClipRect.Min.y - text_pos.y) / line_height);
+            line_index = TextGetLineIndex(window, text, text_end, (flags & ImGuiTextFlags_NoWidthForLargeClippedText) == 0, lines_skippable);
+            if (line_index->WidthFont != NULL)
+                text_size.x = line_index->MaxWidth;
             if (lines_skippable > 0)
             {
-                int lines_skipped = 0;
-                while (line < text_end && lines_skipped < lines_skippable)
-                {
-                    const char* line_end = (const char*)memchr(line, '\n', text_end - line);
-                    if (!line_end)
-                        line_end = text_end;
-                    if ((flags & ImGuiTextFlags_NoWidthForLargeClippedText) == 0)
-                        text_size.x = ImMax(text_size.x, CalcTextSize(line, line_end).x);
-                    line = line_end + 1;
-                    lines_skipped++;
-                }
-                pos.y += lines_skipped * line_height;
+                line_n = ImMin(lines_skippable, line_index->GetLinesCount());
+                line = (line_n < line_index->LineOffsets.Size) ? text + line_index->LineOffsets[line_n] : text_end;
+                pos.y += line_n * line_height;
             }
         }
 
@@ -193,6 +256,13 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
                 if (IsClippedEx(line_rect, 0, false))
                     break;
 
+                // Text modified without growing: discard the line index and count remaining lines from the text
+                if (line_index != NULL && (line_n >= line_index->LineOffsets.Size || line_index->LineOffsets[line_n] != (int)(line - text)))
+                {
+                    line_index->ClearLines();
+                    line_index = NULL;
+                }
+
                 const char* line_end = (const char*)memchr(line, '\n', text_end - line);
                 if (!line_end)
                     line_end = text_end;
@@ -202,10 +272,16 @@ void ImGui::TextEx(const char* text, const char* text_end, ImGuiTextFlags flags)
                 line_rect.Min.y += line_height;
                 line_rect.Max.y += line_height;
                 pos.y += line_height;
+                line_n++;
             }
 
             // Count remaining lines
             int lines_skipped = 0;
+            if (line_index != NULL && line < text_end)
+            {
+                lines_skipped = ImMax(line_index->GetLinesCount() - line_n, 0);
+                line = text_end;
+            }
             while (line < text_end)
             {
                 const char* line_end = (const char*)memchr(line, '\n', text_end - line);
@@ -3490,17 +3566,194 @@ static ImVec2 InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* t
     return text_size;
 }
 
+// Multi-line line index and large buffer mode (ImGuiInputTextFlags_LargeBuffer)
+// - LineStarts[] holds the wchar index of each line start of a multi-line edit buffer. It is patched on every edit and lets us
+//   measure, render and hit-test only the lines we need (the cursor line, the visible lines) instead of scanning the whole text every frame.
+// - In large buffer mode TextW is a gap buffer: the text is TextW[0..GapBegin) followed by TextW[GapEnd..TextW.Size-1). Edits happen at the gap,
+//   so their cost is proportional to the distance the gap moves (typically the distance between two edits) rather than to the text size.
+// Build the line index from a flat TextW[0..CurLenW)
+static void InputTextLineIndexBuild(ImGuiInputTextState* state)
+{
+    state->LineStarts.resize(0);
+    state->LineStarts.push_back(0);
+    const ImWchar* text = state->TextW.Data;
+    for (int n = 0; n < state->CurLenW; n++)
+        if (text[n] == '\n')
+            state->LineStarts.push_back(n + 1);
+    state->LineHint = 0;
+}
+
+static void InputTextLargeBufferInit(ImGuiInputTextState* state)
+{
+    InputTextLineIndexBuild(state);
+    state->GapBegin = state->CurLenW;
+    state->GapEnd = state->TextW.Size - 1;
+    state->TextW.Data[state->GapEnd] = 0;
+}
+
+static void InputTextGapMoveTo(ImGuiInputTextState* state, int pos)
+{
+    ImWchar* text = state->TextW.Data;
+    if (pos < state->GapBegin)
+    {
+        const int n = state->GapBegin - pos;
+        memmove(text + state->GapEnd - n, text + pos, (size_t)n * sizeof(ImWchar));
+        state->GapBegin -= n;
+        state->GapEnd -= n;
+    }
+    else if (pos > state->GapBegin)
+    {
+        const int n = pos - state->GapBegin;
+        memmove(text + state->GapBegin, text + state->GapEnd, (size_t)n * sizeof(ImWchar));
+        state->GapBegin += n;
+        state->GapEnd += n;
+    }
+}
+
+// Move the gap to the end of the text so TextW.Data can be read as a regular zero-terminated string.
+static void InputTextGapFlatten(ImGuiInputTextState* state)
+{
+    InputTextGapMoveTo(state, state->CurLenW);
+    state->TextW.Data[state->GapBegin] = 0;
+}
+
+// Make room for at least 'count' characters in the gap. Growing is geometric so a long typing session doesn't keep reallocating.
+static void InputTextGapReserve(ImGuiInputTextState* state, int count)
+{
+    const int gap_size = state->GapEnd - state->GapBegin;
+    if (gap_size >= count)
+        return;
+    const int old_size = state->TextW.Size;
+    const int tail_len = old_size - state->GapEnd; // Includes the zero-terminator
+    const int grow = count - gap_size + ImMax(256, state->CurLenW / 8);
+    state->TextW.resize(old_size + grow);
+    memmove(state->TextW.Data + state->GapEnd + grow, state->TextW.Data + state->GapEnd, (size_t)tail_len * sizeof(ImWchar));
+    state->GapEnd += grow;
+}
+
+// Convert wchar range [begin, end) to UTF-8, reading around the gap. Returns the number of bytes written.
+static int InputTextGapToUtf8(const ImGuiInputTextState* state, char* buf, int buf_size, int begin, int end)
+{
+    const ImWchar* text = state->TextW.Data;
+    const int gap_size = state->GapEnd - state->GapBegin;
+    int len = 0;
+    buf[0] = 0;
+    if (begin < state->GapBegin)
+        len += ImTextStrToUtf8(buf, buf_size, text + begin, text + ImMin(end, state->GapBegin));
+    if (end > state->GapBegin)
+        len += ImTextStrToUtf8(buf + len, buf_size - len, text + ImMax(begin, state->GapBegin) + gap_size, text + end + gap_size);
+    return len;
+}
+
+// Return the line containing wchar index 'pos'. Checks the last returned line and its successor first.
+static int InputTextLineIndexFind(ImGuiInputTextState* state, int pos)
+{
+    const int* starts = state->LineStarts.Data;
+    const int count = state->LineStarts.Size;
+    const int hint = state->LineHint;
+    if (hint < count && starts[hint] <= pos)
+    {
+        if (hint + 1 == count || pos < starts[hint + 1])
+            return hint;
+        if (hint + 2 == count || pos < starts[hint + 2])
+            return state->LineHint = hint + 1;
+    }
+    int lo = 0, hi = count - 1;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi + 1) >> 1;
+        if (starts[mid] <= pos)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    return state->LineHint = lo;
+}
+
+// Return the end of 'line', not including its '\n'.
+static int InputTextLineIndexGetLineEnd(const ImGuiInputTextState* state, int line)
+{
+    return (line + 1 < state->LineStarts.Size) ? state->LineStarts[line + 1] - 1 : state->CurLenW;
+}
+
+// Measure wchar range [begin, end) of a single line.
+static float InputTextCalcLineWidthW(const ImGuiInputTextState* state, int begin, int end)
+{
+    ImGuiContext& g = *GImGui;
+    ImFont* font = g.Font;
+    const float scale = g.FontSize / font->FontSize;
+    float width = 0.0f;
+    for (int n = begin; n < end; n++)
+    {
+        const ImWchar c = state->GetCharW(n);
+        if (c != '\r')
+            width += font->GetCharAdvance(c) * scale;
+    }
+    return width;
+}
+
+// Patch the line index after inserting 'text[0..len)' at 'pos'.
+static void InputTextLineIndexOnInsert(ImGuiInputTextState* state, int pos, const ImWchar* text, int len)
+{
+    ImVector<int>& starts = state->LineStarts;
+    const int first = InputTextLineIndexFind(state, pos) + 1;
+    int new_lines = 0;
+    for (int n = 0; n < len; n++)
+        if (text[n] == '\n')
+            new_lines++;
+    if (new_lines > 0)
+    {
+        const int old_count = starts.Size;
+        starts.resize(old_count + new_lines);
+        memmove(starts.Data + first + new_lines, starts.Data + first, (size_t)(old_count - first) * sizeof(int));
+        for (int n = 0, line = first; n < len; n++)
+            if (text[n] == '\n')
+                starts[line++] = pos + n + 1;
+    }
+    for (int line = first + new_lines; line < starts.Size; line++)
+        starts[line] += len;
+}
+
+// Patch the line index after deleting wchar range [pos, pos + len).
+static void InputTextLineIndexOnDelete(ImGuiInputTextState* state, int pos, int len)
+{
+    ImVector<int>& starts = state->LineStarts;
+    const int first = InputTextLineIndexFind(state, pos) + 1;
+    int last = first;
+    while (last < starts.Size && starts[last] <= pos + len)
+        last++;
+    if (last > first)
+        starts.erase(starts.Data + first, starts.Data + last);
+    for (int line = first; line < starts.Size; line++)
+        starts[line] -= len;
+}
+
 // Wrapper for stb_textedit.h to edit text (our wrapper is for: statically sized buffer, single-line, wchar characters. InputText converts between UTF-8 and wchar)
 namespace ImStb
 {
 
 static int     STB_TEXTEDIT_STRINGLEN(const STB_TEXTEDIT_STRING* obj)                             { return obj->CurLenW; }
-static ImWchar STB_TEXTEDIT_GETCHAR(const STB_TEXTEDIT_STRING* obj, int idx)                      { return obj->TextW[idx]; }
-static float   STB_TEXTEDIT_GETWIDTH(STB_TEXTEDIT_STRING* obj, int line_start_idx, int char_idx)  { ImWchar c = obj->TextW[line_start_idx + char_idx]; if (c == '\n') return STB_TEXTEDIT_GETWIDTH_NEWLINE; ImGuiContext& g = *GImGui; return g.Font->GetCharAdvance(c) * (g.FontSize / g.Font->FontSize); }
+static ImWchar STB_TEXTEDIT_GETCHAR(const STB_TEXTEDIT_STRING* obj, int idx)                      { return obj->GetCharW(idx); }
+static float   STB_TEXTEDIT_GETWIDTH(STB_TEXTEDIT_STRING* obj, int line_start_idx, int char_idx)  { ImWchar c = obj->GetCharW(line_start_idx + char_idx); if (c == '\n') return STB_TEXTEDIT_GETWIDTH_NEWLINE; ImGuiContext& g = *GImGui; return g.Font->GetCharAdvance(c) * (g.FontSize / g.Font->FontSize); }
 static int     STB_TEXTEDIT_KEYTOTEXT(int key)                                                    { return key >= 0x200000 ? 0 : key; }
 static ImWchar STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, STB_TEXTEDIT_STRING* obj, int line_start_idx)
 {
+    if (!obj->Stb.single_line)
+    {
+        // stb_textedit.h walks rows from the top of the text to locate a position, so don't measure anything here:
+        // rows are only used for their character count, and an unbounded x1 makes stb_text_locate_coord() scan the row characters itself.
+        ImGuiContext& g = *GImGui;
+        const int line = InputTextLineIndexFind(obj, line_start_idx);
+        const int line_end = (line + 1 < obj->LineStarts.Size) ? obj->LineStarts[line + 1] : obj->CurLenW;
+        r->x0 = 0.0f;
+        r->x1 = FLT_MAX;
+        r->baseline_y_delta = g.FontSize;
+        r->ymin = 0.0f;
+        r->ymax = g.FontSize;
+        r->num_chars = line_end - line_start_idx;
+        return;
+    }
     const ImWchar* text = obj->TextW.Data;
     const ImWchar* text_remaining = NULL;
     const ImVec2 size = InputTextCalcTextSizeW(text + line_start_idx, text + obj->CurLenW, &text_remaining, NULL, true);
@@ -3513,10 +3766,10 @@ static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, STB_TEXTEDIT_STRING* ob
 }
 
 static bool is_separator(unsigned int c)                                        { return ImCharIsBlankW(c) || c==',' || c==';' || c=='(' || c==')' || c=='{' || c=='}' || c=='[' || c==']' || c=='|'; }
-static int  is_word_boundary_from_right(STB_TEXTEDIT_STRING* obj, int idx)      { return idx > 0 ? (is_separator(obj->TextW[idx - 1]) && !is_separator(obj->TextW[idx]) ) : 1; }
+static int  is_word_boundary_from_right(STB_TEXTEDIT_STRING* obj, int idx)      { return idx > 0 ? (is_separator(obj->GetCharW(idx - 1)) && !is_separator(obj->GetCharW(idx)) ) : 1; }
 static int  STB_TEXTEDIT_MOVEWORDLEFT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)   { idx--; while (idx >= 0 && !is_word_boundary_from_right(obj, idx)) idx--; return idx < 0 ? 0 : idx; }
 #ifdef __APPLE__    // FIXME: Move setting to IO structure
-static int  is_word_boundary_from_left(STB_TEXTEDIT_STRING* obj, int idx)       { return idx > 0 ? (!is_separator(obj->TextW[idx - 1]) && is_separator(obj->TextW[idx]) ) : 1; }
+static int  is_word_boundary_from_left(STB_TEXTEDIT_STRING* obj, int idx)       { return idx > 0 ? (!is_separator(obj->GetCharW(idx - 1)) && is_separator(obj->GetCharW(idx)) ) : 1; }
 static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)  { idx++; int len = obj->CurLenW; while (idx < len && !is_word_boundary_from_left(obj, idx)) idx++; return idx > len ? len : idx; }
 #else
 static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)  { idx++; int len = obj->CurLenW; while (idx < len && !is_word_boundary_from_right(obj, idx)) idx++; return idx > len ? len : idx; }
@@ -3526,6 +3779,18 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)
 
 static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
 {
+    if (obj->LargeBuffer)
+    {
+        InputTextGapMoveTo(obj, pos);
+        const ImWchar* deleted = obj->TextW.Data + obj->GapEnd;
+        obj->Edited = true;
+        obj->CurLenA -= ImTextCountUtf8BytesFromStr(deleted, deleted + n);
+        obj->CurLenW -= n;
+        obj->GapEnd += n;
+        InputTextLineIndexOnDelete(obj, pos, n);
+        return;
+    }
+
     ImWchar* dst = obj->TextW.Data + pos;
 
     // We maintain our buffer length in both UTF-8 and wchar formats
@@ -3538,6 +3803,9 @@ static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
     while (ImWchar c = *src++)
         *dst++ = c;
     *dst = '\0';
+
+    if (!obj->Stb.single_line)
+        InputTextLineIndexOnDelete(obj, pos, n);
 }
 
 static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
@@ -3550,6 +3818,24 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
     if (!is_resizable && (new_text_len_utf8 + obj->CurLenA + 1 > obj->BufCapacityA))
         return false;
 
+    if (obj->LargeBuffer)
+    {
+        if (new_text_len > obj->GapEnd - obj->GapBegin)
+        {
+            if (!is_resizable)
+                return false;
+            InputTextGapReserve(obj, new_text_len);
+        }
+        InputTextGapMoveTo(obj, pos);
+        memcpy(obj->TextW.Data + obj->GapBegin, new_text, (size_t)new_text_len * sizeof(ImWchar));
+        obj->GapBegin += new_text_len;
+        obj->Edited = true;
+        obj->CurLenW += new_text_len;
+        obj->CurLenA += new_text_len_utf8;
+        InputTextLineIndexOnInsert(obj, pos, new_text, new_text_len);
+        return true;
+    }
+
     // Grow internal buffer if needed
     if (new_text_len + text_len + 1 > obj->TextW.Size)
     {
@@ -3568,6 +3854,8 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
     obj->TextW[obj->CurLenW] = '\0';
+    if (!obj->Stb.single_line)
+        InputTextLineIndexOnInsert(obj, pos, new_text, new_text_len);
 
     return true;
 }
@@ -3781,6 +4069,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     ImGuiContext& g = *GImGui;
     ImGuiIO& io = g.IO;
     const ImGuiStyle& style = g.Style;
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_InputText);
 
     const bool RENDER_SELECTION_WHEN_INACTIVE = false;
     const bool is_multiline = (flags & ImGuiInputTextFlags_Multiline) != 0;
@@ -3788,6 +4077,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     const bool is_password = (flags & ImGuiInputTextFlags_Password) != 0;
     const bool is_undoable = (flags & ImGuiInputTextFlags_NoUndoRedo) == 0;
     const bool is_resizable = (flags & ImGuiInputTextFlags_CallbackResize) != 0;
+    const bool is_large = (flags & ImGuiInputTextFlags_LargeBuffer) != 0 && is_multiline && !is_password;
     if (is_resizable)
         IM_ASSERT(callback != NULL); // Must provide a callback if you set the ImGuiInputTextFlags_CallbackResize flag!
 
@@ -3878,6 +4168,12 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        state->LargeBuffer = is_large;
+        state->GapBegin = state->GapEnd = 0;
+        if (is_large)
+            InputTextLargeBufferInit(state);        // Build the line index and place the gap after the text
+        else if (is_multiline)
+            InputTextLineIndexBuild(state);
 
         // Preserve cursor position and undo/redo stack if we come back to same widget
         // FIXME: For non-readonly widgets we might be able to require that TextAIsValid && TextA == buf ? (untested) and discard undo stack if user buffer has changed.
@@ -3938,12 +4234,15 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
 
     // When read-only we always use the live data passed to the function
     // FIXME-OPT: Because our selection/cursor code currently needs the wide text we need to convert it when active, which is not ideal :(
-    if (is_readonly && state != NULL && (render_cursor || render_selection))
+    // In large buffer mode we keep the copy made on activation instead.
+    if (is_readonly && state != NULL && (render_cursor || render_selection) && !state->LargeBuffer)
     {
         const char* buf_end = NULL;
         state->TextW.resize(buf_size + 1);
         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
         state->CurLenA = (int)(buf_end - buf);
+        if (is_multiline)
+            InputTextLineIndexBuild(state);
         state->CursorClamp();
         render_selection &= state->HasSelection();
     }
@@ -4129,11 +4428,13 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
+                if (state->LargeBuffer)
+                    InputTextGapMoveTo(state, ie); // Make [ib, ie) contiguous
                 const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
-                char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
+                char* clipboard_data = (char*)MemAllocFrame(clipboard_data_len * sizeof(char));
                 ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
                 SetClipboardText(clipboard_data);
-                MemFree(clipboard_data);
+                MemFreeFrame(clipboard_data);
             }
             if (is_cut)
             {
@@ -4149,7 +4450,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
-                ImWchar* clipboard_filtered = (ImWchar*)IM_ALLOC((clipboard_len + 1) * sizeof(ImWchar));
+                ImWchar* clipboard_filtered = (ImWchar*)MemAllocFrame((clipboard_len + 1) * sizeof(ImWchar));
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s; )
                 {
@@ -4167,7 +4468,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     stb_textedit_paste(state, &state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
-                MemFree(clipboard_filtered);
+                MemFreeFrame(clipboard_filtered);
             }
         }
 
@@ -4181,6 +4482,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         IM_ASSERT(state != NULL);
         const char* apply_new_text = NULL;
         int apply_new_text_length = 0;
+        bool apply_new_text_from_gap_buffer = false;
         if (cancel_edit)
         {
             // Restore initial value. Only return true if restoring to the initial value changes the current buffer contents.
@@ -4189,13 +4491,16 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 // Push records into the undo stack so we can CTRL+Z the revert operation itself
                 apply_new_text = state->InitialTextA.Data;
                 apply_new_text_length = state->InitialTextA.Size - 1;
-                ImVector<ImWchar> w_text;
+                ImWchar* w_text = NULL;
+                int w_text_len = 0;
                 if (apply_new_text_length > 0)
                 {
-                    w_text.resize(ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length) + 1);
-                    ImTextStrFromUtf8(w_text.Data, w_text.Size, apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text_len = ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length);
+                    w_text = (ImWchar*)MemAllocFrame((w_text_len + 1) * sizeof(ImWchar));
+                    ImTextStrFromUtf8(w_text, w_text_len + 1, apply_new_text, apply_new_text + apply_new_text_length);
                 }
-                stb_textedit_replace(state, &state->Stb, w_text.Data, (apply_new_text_length > 0) ? (w_text.Size - 1) : 0);
+                stb_textedit_replace(state, &state->Stb, w_text, w_text_len);
+                MemFreeFrame(w_text);
             }
         }
 
@@ -4209,11 +4514,14 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
             // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
             // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
-            if (!is_readonly)
+            // In large buffer mode we skip TextA and only copy the gap buffer straight to 'buf' on frames where the text changed (see below).
+            bool text_a_updated = false;
+            if (!is_readonly && !state->LargeBuffer)
             {
                 state->TextAIsValid = true;
                 state->TextA.resize(state->TextW.Size * 4 + 1);
                 ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
+                text_a_updated = true;
             }
 
             // User callback
@@ -4248,6 +4556,19 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     event_flag = ImGuiInputTextFlags_CallbackAlways;
                 }
 
+                if (event_flag && state->LargeBuffer)
+                {
+                    // Callbacks operate on flat buffers
+                    InputTextGapFlatten(state);
+                    if (!text_a_updated)
+                    {
+                        state->TextAIsValid = true;
+                        state->TextA.resize(state->TextW.Size * 4 + 1);
+                        ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
+                        text_a_updated = true;
+                    }
+                }
+
                 if (event_flag)
                 {
                     ImGuiInputTextCallbackData callback_data;
@@ -4287,20 +4608,30 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                         state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
                         state->CursorAnimReset();
+                        if (state->LargeBuffer)
+                            InputTextLargeBufferInit(state);
+                        else if (is_multiline)
+                            InputTextLineIndexBuild(state);
                     }
                 }
             }
 
             // Will copy result string if modified
-            if (!is_readonly && strcmp(state->TextA.Data, buf) != 0)
+            if (!is_readonly && text_a_updated && strcmp(state->TextA.Data, buf) != 0)
             {
                 apply_new_text = state->TextA.Data;
                 apply_new_text_length = state->CurLenA;
             }
+            else if (!is_readonly && !text_a_updated && state->Edited)
+            {
+                apply_new_text_from_gap_buffer = true;
+                apply_new_text_length = state->CurLenA;
+                state->TextAIsValid = false;
+            }
         }
 
         // Copy result to user buffer
-        if (apply_new_text)
+        if (apply_new_text || apply_new_text_from_gap_buffer)
         {
             // We cannot test for 'backup_current_text_length != apply_new_text_length' here because we have no guarantee that the size
             // of our owned buffer matches the size of the string object held by the user, and by design we allow InputText() to be used
@@ -4324,7 +4655,10 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             //IMGUI_DEBUG_LOG("InputText(\"%s\"): apply_new_text length %d\n", label, apply_new_text_length);
 
             // If the underlying buffer resize was denied or not carried to the next frame, apply_new_text_length+1 may be >= buf_size.
-            ImStrncpy(buf, apply_new_text, ImMin(apply_new_text_length + 1, buf_size));
+            if (apply_new_text_from_gap_buffer)
+                InputTextGapToUtf8(state, buf, ImMin(apply_new_text_length + 1, buf_size), 0, state->CurLenW);
+            else
+                ImStrncpy(buf, apply_new_text, ImMin(apply_new_text_length + 1, buf_size));
             value_changed = true;
         }
 
@@ -4375,10 +4709,28 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // - Handle scrolling, highlight selection, display cursor (those all requires some form of 1d->2d cursor position calculation)
         // - Measure text height (for scrollbar)
         // We are attempting to do most of that in **one main pass** to minimize the computation cost (non-negligible for large amount of text) + 2nd pass for selection rendering (we could merge them by an extra refactoring effort)
+        // In multi-line mode we use the line index instead, so only the cursor line and the visible lines are visited.
         // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
         const ImWchar* text_begin = state->TextW.Data;
         ImVec2 cursor_offset, select_start_offset;
 
+        if (is_multiline)
+        {
+            // Look up line numbers in the line index and only measure the lines holding 'cursor' and 'select_start'.
+            // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
+            const int cursor_line = InputTextLineIndexFind(state, state->Stb.cursor);
+            cursor_offset.x = InputTextCalcLineWidthW(state, state->LineStarts[cursor_line], state->Stb.cursor);
+            cursor_offset.y = (cursor_line + 1) * g.FontSize;
+            if (render_selection)
+            {
+                const int select_start = ImMin(state->Stb.select_start, state->Stb.select_end);
+                const int select_start_line = InputTextLineIndexFind(state, select_start);
+                select_start_offset.x = InputTextCalcLineWidthW(state, state->LineStarts[select_start_line], select_start);
+                select_start_offset.y = (select_start_line + 1) * g.FontSize;
+            }
+            text_size = ImVec2(inner_size.x, state->LineStarts.Size * g.FontSize);
+        }
+        else
         {
             // Find lines numbers straddling 'cursor' (slot 0) and 'select_start' (slot 1) positions.
             const ImWchar* searches_input_ptr[2] = { NULL, NULL };
@@ -4398,8 +4750,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             }
 
             // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
             int line_count = 0;
             //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
             for (const ImWchar* s = text_begin; *s != 0; s++)
@@ -4424,9 +4774,6 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 select_start_offset.y = searches_result_line_no[1] * g.FontSize;
             }
 
-            // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
-            if (is_multiline)
-                text_size = ImVec2(inner_size.x, line_count * g.FontSize);
         }
 
         // Scroll
@@ -4474,34 +4821,79 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
-            for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+            if (is_multiline)
             {
-                if (rect_pos.y > clip_rect.w + g.FontSize)
-                    break;
-                if (rect_pos.y < clip_rect.y)
+                // Only visit the selected lines which are visible.
+                const int select_begin = ImMin(state->Stb.select_start, state->Stb.select_end);
+                const int select_end = ImMax(state->Stb.select_start, state->Stb.select_end);
+                const int select_line_begin = InputTextLineIndexFind(state, select_begin);
+                const int select_line_end = (select_end > select_begin) ? InputTextLineIndexFind(state, select_end - 1) : select_line_begin - 1; // Selection may have been emptied this frame
+                const int visible_line_begin = ImMax(select_line_begin, (int)((clip_rect.y - draw_pos.y) / g.FontSize) - 1);
+                for (int line = visible_line_begin; line <= select_line_end; line++)
                 {
-                    //p = (const ImWchar*)wmemchr((const wchar_t*)p, '\n', text_selected_end - p);  // FIXME-OPT: Could use this when wchar_t are 16-bit
-                    //p = p ? p + 1 : text_selected_end;
-                    while (p < text_selected_end)
-                        if (*p++ == '\n')
-                            break;
-                }
-                else
-                {
-                    ImVec2 rect_size = InputTextCalcTextSizeW(p, text_selected_end, &p, NULL, true);
-                    if (rect_size.x <= 0.0f) rect_size.x = IM_FLOOR(g.Font->GetCharAdvance((ImWchar)' ') * 0.50f); // So we can see selected empty lines
-                    ImRect rect(rect_pos + ImVec2(0.0f, bg_offy_up - g.FontSize), rect_pos + ImVec2(rect_size.x, bg_offy_dn));
+                    if (line != select_line_begin)
+                        rect_pos.x = draw_pos.x - draw_scroll.x;
+                    rect_pos.y = draw_pos.y + (line + 1) * g.FontSize;
+                    if (rect_pos.y > clip_rect.w + g.FontSize)
+                        break;
+                    if (rect_pos.y < clip_rect.y)
+                        continue;
+                    const int segment_begin = ImMax(select_begin, state->LineStarts[line]);
+                    const int segment_end = ImMin(select_end, InputTextLineIndexGetLineEnd(state, line));
+                    float rect_width = InputTextCalcLineWidthW(state, segment_begin, segment_end);
+                    if (rect_width <= 0.0f) rect_width = IM_FLOOR(g.Font->GetCharAdvance((ImWchar)' ') * 0.50f); // So we can see selected empty lines
+                    ImRect rect(rect_pos + ImVec2(0.0f, bg_offy_up - g.FontSize), rect_pos + ImVec2(rect_width, bg_offy_dn));
                     rect.ClipWith(clip_rect);
                     if (rect.Overlaps(clip_rect))
                         draw_window->DrawList->AddRectFilled(rect.Min, rect.Max, bg_color);
                 }
-                rect_pos.x = draw_pos.x - draw_scroll.x;
-                rect_pos.y += g.FontSize;
+            }
+            else
+            {
+                for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
+                {
+                    if (rect_pos.y > clip_rect.w + g.FontSize)
+                        break;
+                    if (rect_pos.y < clip_rect.y)
+                    {
+                        //p = (const ImWchar*)wmemchr((const wchar_t*)p, '\n', text_selected_end - p);  // FIXME-OPT: Could use this when wchar_t are 16-bit
+                        //p = p ? p + 1 : text_selected_end;
+                        while (p < text_selected_end)
+                            if (*p++ == '\n')
+                                break;
+                    }
+                    else
+                    {
+                        ImVec2 rect_size = InputTextCalcTextSizeW(p, text_selected_end, &p, NULL, true);
+                        if (rect_size.x <= 0.0f) rect_size.x = IM_FLOOR(g.Font->GetCharAdvance((ImWchar)' ') * 0.50f); // So we can see selected empty lines
+                        ImRect rect(rect_pos + ImVec2(0.0f, bg_offy_up - g.FontSize), rect_pos + ImVec2(rect_size.x, bg_offy_dn));
+                        rect.ClipWith(clip_rect);
+                        if (rect.Overlaps(clip_rect))
+                            draw_window->DrawList->AddRectFilled(rect.Min, rect.Max, bg_color);
+                    }
+                    rect_pos.x = draw_pos.x - draw_scroll.x;
+                    rect_pos.y += g.FontSize;
+                }
             }
         }
 
+        if (is_multiline && !is_displaying_hint)
+        {
+            // Only convert and submit the visible lines.
+            const int line_count = state->LineStarts.Size;
+            const int line_min = ImClamp((int)((draw_window->ClipRect.Min.y - draw_pos.y) / g.FontSize), 0, line_count - 1);
+            const int line_max = ImClamp((int)((draw_window->ClipRect.Max.y - draw_pos.y) / g.FontSize), line_min, line_count - 1);
+            const int visible_begin = state->LineStarts[line_min];
+            const int visible_end = InputTextLineIndexGetLineEnd(state, line_max);
+            const int visible_buf_size = (visible_end - visible_begin) * 4 + 1;
+            char* visible_buf = (char*)MemAllocFrame((size_t)visible_buf_size);
+            const int visible_buf_len = InputTextGapToUtf8(state, visible_buf, visible_buf_size, visible_begin, visible_end);
+            const ImVec2 visible_pos = draw_pos - draw_scroll + ImVec2(0.0f, line_min * g.FontSize);
+            draw_window->DrawList->AddText(g.Font, g.FontSize, visible_pos, GetColorU32(ImGuiCol_Text), visible_buf, visible_buf + visible_buf_len);
+            MemFreeFrame(visible_buf);
+        }
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
-        if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
+        else if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
             draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
@@ -14,6 +14,7 @@
 // - v0.61: (2019/01/15) added support for imgui allocators + added FreeType only override function SetAllocatorFunctions().
 // - v0.62: (2019/02/09) added RasterizerFlags::Monochrome flag to disable font anti-aliasing (combine with ::MonoHinting for best results!)
 // - v0.63: (2020/06/04) fix for rare case where FT_Get_Char_Index() succeed but FT_Load_Glyph() fails.
+// - v0.64: (2020/11/16) rasterize source fonts on worker threads when ImFontAtlas::ParallelForFn is set.
 
 // Gamma Correct Blending:
 //  FreeType assumes blending in linear space rather than gamma space.
@@ -296,7 +297,19 @@ struct ImFontBuildSrcGlyphFT
 {
     GlyphInfo           Info;
     uint32_t            Codepoint;
-    unsigned char*      BitmapData;         // Point within one of the dst_tmp_bitmap_buffers[] array
+    unsigned char*      BitmapData;         // Point within one of the BitmapChunks of the source font
+};
+
+// Temporary rasterized glyphs. We could not find a way to retrieve accurate glyph size without rendering them.
+// (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
+// We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't find the temporary allocations.
+// Chunks are chained in a list (rather than stored in an ImVector<>) because they are allocated by rasterization jobs, possibly on worker threads.
+struct ImFontBuildBitmapChunkFT
+{
+    enum { CHUNK_SIZE = 256 * 1024 };
+    ImFontBuildBitmapChunkFT*   Next;
+    int                         UsedBytes;
+    unsigned char               Data[CHUNK_SIZE];
 };
 
 struct ImFontBuildSrcDataFT
@@ -309,6 +322,7 @@ struct ImFontBuildSrcDataFT
     int                 GlyphsCount;        // Glyph count (excluding missing glyphs and glyphs already set by an earlier source font)
     ImBitVector         GlyphsSet;          // Glyph bit map (random access, 1-bit per codepoint. This will be a maximum of 8KB)
     ImVector<ImFontBuildSrcGlyphFT>   GlyphsList;
+    ImFontBuildBitmapChunkFT* BitmapChunks; // Rasterized glyphs (most recent chunk first)
 };
 
 // Temporary data for one destination ImFont* (multiple source fonts can be merged into one destination ImFont)
@@ -320,7 +334,64 @@ struct ImFontBuildDstDataFT
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
-bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags)
+struct ImFontBuildJobsDataFT
+{
+    ImFontAtlas*                Atlas;
+    ImFontBuildSrcDataFT*       SrcTmpArray;
+    ImFontAtlasBuildAllocator*  Allocator;
+};
+
+// Rasterize glyphs of a source font into temporary buffers and gather their sizes, one job per source font.
+// Jobs may run on worker threads (see ImFontAtlas::ParallelForFn): each source font uses its own FT_Face, which FreeType allows.
+static void ImFontAtlasBuildRasterizeJobFT(void* job_user_data, int src_i)
+{
+    ImFontBuildJobsDataFT* data = (ImFontBuildJobsDataFT*)job_user_data;
+    ImFontBuildSrcDataFT& src_tmp = data->SrcTmpArray[src_i];
+    const ImFontConfig& cfg = data->Atlas->ConfigData[src_i];
+    if (src_tmp.GlyphsCount == 0)
+        return;
+
+    // Compute multiply table if requested
+    const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
+    unsigned char multiply_table[256];
+    if (multiply_enabled)
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+
+    // Gather the sizes of all rectangles we will need to pack
+    const int padding = data->Atlas->TexGlyphPadding;
+    for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
+    {
+        ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
+
+        const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
+        if (metrics == NULL)
+            continue;
+
+        // Render glyph into a bitmap (currently held by FreeType)
+        const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
+        IM_ASSERT(ft_bitmap);
+
+        // Allocate new temporary chunk if needed
+        const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height;
+        if (src_tmp.BitmapChunks == NULL || src_tmp.BitmapChunks->UsedBytes + bitmap_size_in_bytes > ImFontBuildBitmapChunkFT::CHUNK_SIZE)
+        {
+            ImFontBuildBitmapChunkFT* chunk = (ImFontBuildBitmapChunkFT*)data->Allocator->Alloc(sizeof(ImFontBuildBitmapChunkFT));
+            chunk->Next = src_tmp.BitmapChunks;
+            chunk->UsedBytes = 0;
+            src_tmp.BitmapChunks = chunk;
+        }
+
+        // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
+        src_glyph.BitmapData = src_tmp.BitmapChunks->Data + src_tmp.BitmapChunks->UsedBytes;
+        src_tmp.BitmapChunks->UsedBytes += bitmap_size_in_bytes;
+        src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width * 1, multiply_enabled ? multiply_table : NULL);
+
+        src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
+        src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
+    }
+}
+
+bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, unsigned int extra_flags, ImFontAtlasBuildAllocator* allocator, bool parallel_build)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
 
@@ -432,67 +503,28 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     buf_rects.resize(total_glyphs_count);
     memset(buf_rects.Data, 0, (size_t)buf_rects.size_in_bytes());
 
-    // Allocate temporary rasterization data buffers.
-    // We could not find a way to retrieve accurate glyph size without rendering them.
-    // (e.g. slot->metrics->width not always matching bitmap->width, especially considering the Oblique transform)
-    // We allocate in chunks of 256 KB to not waste too much extra memory ahead. Hopefully users of FreeType won't find the temporary allocations.
-    const int BITMAP_BUFFERS_CHUNK_SIZE = 256 * 1024;
-    int buf_bitmap_current_used_bytes = 0;
-    ImVector<unsigned char*> buf_bitmap_buffers;
-    buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-
-    // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
-    // 8. Render/rasterize font characters into the texture
-    int total_surface = 0;
+    // 4. Rasterize glyphs into temporary buffers and gather their sizes so we can pack them in our virtual canvas.
     int buf_rects_out_n = 0;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcDataFT& src_tmp = src_tmp_array[src_i];
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         if (src_tmp.GlyphsCount == 0)
             continue;
-
         src_tmp.Rects = &buf_rects[buf_rects_out_n];
         buf_rects_out_n += src_tmp.GlyphsCount;
-
-        // Compute multiply table if requested
-        const bool multiply_enabled = (cfg.RasterizerMultiply != 1.0f);
-        unsigned char multiply_table[256];
-        if (multiply_enabled)
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-
-        // Gather the sizes of all rectangles we will need to pack
-        const int padding = atlas->TexGlyphPadding;
-        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsList.Size; glyph_i++)
-        {
-            ImFontBuildSrcGlyphFT& src_glyph = src_tmp.GlyphsList[glyph_i];
-
-            const FT_Glyph_Metrics* metrics = src_tmp.Font.LoadGlyph(src_glyph.Codepoint);
-            if (metrics == NULL)
-                continue;
-
-            // Render glyph into a bitmap (currently held by FreeType)
-            const FT_Bitmap* ft_bitmap = src_tmp.Font.RenderGlyphAndGetInfo(&src_glyph.Info);
-            IM_ASSERT(ft_bitmap);
-
-            // Allocate new temporary chunk if needed
-            const int bitmap_size_in_bytes = src_glyph.Info.Width * src_glyph.Info.Height;
-            if (buf_bitmap_current_used_bytes + bitmap_size_in_bytes > BITMAP_BUFFERS_CHUNK_SIZE)
-            {
-                buf_bitmap_current_used_bytes = 0;
-                buf_bitmap_buffers.push_back((unsigned char*)IM_ALLOC(BITMAP_BUFFERS_CHUNK_SIZE));
-            }
-
-            // Blit rasterized pixels to our temporary buffer and keep a pointer to it.
-            src_glyph.BitmapData = buf_bitmap_buffers.back() + buf_bitmap_current_used_bytes;
-            buf_bitmap_current_used_bytes += bitmap_size_in_bytes;
-            src_tmp.Font.BlitGlyph(ft_bitmap, src_glyph.BitmapData, src_glyph.Info.Width * 1, multiply_enabled ? multiply_table : NULL);
-
-            src_tmp.Rects[glyph_i].w = (stbrp_coord)(src_glyph.Info.Width + padding);
-            src_tmp.Rects[glyph_i].h = (stbrp_coord)(src_glyph.Info.Height + padding);
-            total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
-        }
     }
+    ImFontBuildJobsDataFT jobs_data;
+    jobs_data.Atlas = atlas;
+    jobs_data.SrcTmpArray = src_tmp_array.Data;
+    jobs_data.Allocator = allocator;
+    if (parallel_build)
+        ImFontAtlasBuildParallelFor(atlas, ImFontAtlasBuildRasterizeJobFT, &jobs_data, src_tmp_array.Size);
+    else
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++) // Functions passed to SetAllocatorFunctions() may not be thread-safe
+            ImFontAtlasBuildRasterizeJobFT(&jobs_data, src_i);
+    int total_surface = 0;
+    for (int rect_i = 0; rect_i < buf_rects.Size; rect_i++)
+        total_surface += buf_rects[rect_i].w * buf_rects[rect_i].h;
 
     // We need a width for the skyline algorithm, any width!
     // The exact width doesn't really matter much, but some API/GPU have texture size limitations and increasing width can decrease height.
@@ -595,8 +627,12 @@ bool ImFontAtlasBuildWithFreeType(FT_Library ft_library, ImFontAtlas* atlas, uns
     }
 
     // Cleanup
-    for (int buf_i = 0; buf_i < buf_bitmap_buffers.Size; buf_i++)
-        IM_FREE(buf_bitmap_buffers[buf_i]);
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        while (ImFontBuildBitmapChunkFT* chunk = src_tmp_array[src_i].BitmapChunks)
+        {
+            src_tmp_array[src_i].BitmapChunks = chunk->Next;
+            allocator->Free(chunk);
+        }
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
         src_tmp_array[src_i].~ImFontBuildSrcDataFT();
 
@@ -615,33 +651,50 @@ static void  (*GImFreeTypeFreeFunc)(void* ptr, void* user_data) = ImFreeTypeDefa
 static void* GImFreeTypeAllocatorUserData = NULL;
 
 // FreeType memory allocation callbacks
-static void* FreeType_Alloc(FT_Memory /*memory*/, long size)
+// Glyphs are only rasterized on worker threads with the default allocators: 'memory->user' then points to an ImFontAtlasBuildAllocator which bypasses
+// ImGui::MemAlloc() (as it updates the context's allocation counter, which is not thread-safe).
+static void* FreeType_AllocBlock(FT_Memory memory, size_t size)
+{
+    if (memory->user)
+        return ((ImFontAtlasBuildAllocator*)memory->user)->Alloc(size);
+    return GImFreeTypeAllocFunc(size, GImFreeTypeAllocatorUserData);
+}
+
+static void FreeType_FreeBlock(FT_Memory memory, void* block)
+{
+    if (memory->user)
+        ((ImFontAtlasBuildAllocator*)memory->user)->Free(block);
+    else
+        GImFreeTypeFreeFunc(block, GImFreeTypeAllocatorUserData);
+}
+
+static void* FreeType_Alloc(FT_Memory memory, long size)
 {
-    return GImFreeTypeAllocFunc((size_t)size, GImFreeTypeAllocatorUserData);
+    return FreeType_AllocBlock(memory, (size_t)size);
 }
 
-static void FreeType_Free(FT_Memory /*memory*/, void* block)
+static void FreeType_Free(FT_Memory memory, void* block)
 {
-    GImFreeTypeFreeFunc(block, GImFreeTypeAllocatorUserData);
+    FreeType_FreeBlock(memory, block);
 }
 
-static void* FreeType_Realloc(FT_Memory /*memory*/, long cur_size, long new_size, void* block)
+static void* FreeType_Realloc(FT_Memory memory, long cur_size, long new_size, void* block)
 {
     // Implement realloc() as we don't ask user to provide it.
     if (block == NULL)
-        return GImFreeTypeAllocFunc((size_t)new_size, GImFreeTypeAllocatorUserData);
+        return FreeType_AllocBlock(memory, (size_t)new_size);
 
     if (new_size == 0)
     {
-        GImFreeTypeFreeFunc(block, GImFreeTypeAllocatorUserData);
+        FreeType_FreeBlock(memory, block);
         return NULL;
     }
 
     if (new_size > cur_size)
     {
-        void* new_block = GImFreeTypeAllocFunc((size_t)new_size, GImFreeTypeAllocatorUserData);
+        void* new_block = FreeType_AllocBlock(memory, (size_t)new_size);
         memcpy(new_block, block, (size_t)cur_size);
-        GImFreeTypeFreeFunc(block, GImFreeTypeAllocatorUserData);
+        FreeType_FreeBlock(memory, block);
         return new_block;
     }
 
@@ -650,9 +703,12 @@ static void* FreeType_Realloc(FT_Memory /*memory*/, long cur_size, long new_size
 
 bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags)
 {
+    IM_MEM_TAG_SCOPE(ImGuiMemTag_Fonts);
     // FreeType memory management: https://www.freetype.org/freetype2/docs/design/design-4.html
+    ImFontAtlasBuildAllocator build_allocator;
+    const bool parallel_build = (atlas->ParallelForFn != NULL && GImFreeTypeAllocFunc == ImFreeTypeDefaultAllocFunc);
     FT_MemoryRec_ memory_rec = {};
-    memory_rec.user = NULL;
+    memory_rec.user = parallel_build ? &build_allocator : NULL;
     memory_rec.alloc = &FreeType_Alloc;
     memory_rec.free = &FreeType_Free;
     memory_rec.realloc = &FreeType_Realloc;
@@ -666,7 +722,7 @@ bool ImGuiFreeType::BuildFontAtlas(ImFontAtlas* atlas, unsigned int extra_flags)
     // If you don't call FT_Add_Default_Modules() the rest of code may work, but FreeType won't use our custom allocator.
     FT_Add_Default_Modules(ft_library);
 
-    bool ret = ImFontAtlasBuildWithFreeType(ft_library, atlas, extra_flags);
+    bool ret = ImFontAtlasBuildWithFreeType(ft_library, atlas, extra_flags, &build_allocator, parallel_build);
     FT_Done_Library(ft_library);
 
     return ret;